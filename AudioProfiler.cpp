@@ -0,0 +1,152 @@
+/*
+  ==============================================================================
+
+    AudioProfiler.cpp
+    Created: 17 Oct 2026 8:34:12pm
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#include "AudioProfiler.h"
+#include <algorithm>
+
+namespace {
+    // Percentiles of a series, which is sorted in place
+    AudioProfiler::Percentiles computePercentiles(std::vector<float>& values) {
+        AudioProfiler::Percentiles result;
+        if (values.empty())
+            return result;
+
+        std::sort(values.begin(), values.end());
+        const auto at = [&values](double fraction) {
+            return values[(size_t)juce::jmin((int)values.size() - 1, (int)(fraction * (double)values.size()))];
+        };
+
+        result.p50 = at(0.5);
+        result.p99 = at(0.99);
+        result.max = values.back();
+        return result;
+    }
+
+    juce::String formatPercentiles(const AudioProfiler::Percentiles& percentiles, const char* unit) {
+        return "p50 " + juce::String(percentiles.p50, 1) + unit
+            + "  p99 " + juce::String(percentiles.p99, 1) + unit
+            + "  max " + juce::String(percentiles.max, 1) + unit;
+    }
+}
+
+// Constructor for AudioProfiler
+AudioProfiler::AudioProfiler(int capacity, int windowSize)
+    : fifo(capacity), timings((size_t)capacity), window((size_t)juce::jmax(1, windowSize)) {
+
+}
+
+float AudioProfiler::microsBetween(juce::int64 startTicks, juce::int64 endTicks) noexcept {
+    return (float)(juce::Time::highResolutionTicksToSeconds(endTicks - startTicks) * 1.0e6);
+}
+
+// Counts the callback and copies its timing into the next free slot of the ring
+void AudioProfiler::recordCallback(const CallbackTiming& timing) noexcept {
+    totalCallbacks.fetch_add(1, std::memory_order_relaxed);
+
+    if (timing.budgetMicros > 0.0f && timing.callbackMicros > timing.budgetMicros)
+        missedDeadlines.fetch_add(1, std::memory_order_relaxed);
+
+    if (fifo.getFreeSpace() < 1) {
+        droppedTimings.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    fifo.write(1).forEach([this, &timing](int index) {
+        timings[(size_t)index] = timing;
+    });
+}
+
+// Drains the ring into the rolling window
+void AudioProfiler::collect() {
+    fifo.read(fifo.getNumReady()).forEach([this](int index) {
+        window[(size_t)windowNext] = timings[(size_t)index];
+        windowNext = (windowNext + 1) % (int)window.size();
+        windowCount = juce::jmin(windowCount + 1, (int)window.size());
+    });
+}
+
+// Sorts copies of each series in the window to find its percentiles
+AudioProfiler::Summary AudioProfiler::getSummary() const {
+    Summary summary;
+    summary.numCallbacks = windowCount;
+    summary.totalCallbacks = totalCallbacks.load(std::memory_order_relaxed);
+    summary.missedDeadlines = missedDeadlines.load(std::memory_order_relaxed);
+    summary.droppedTimings = droppedTimings.load(std::memory_order_relaxed);
+
+    if (windowCount == 0)
+        return summary;
+
+    // Oldest first, so the most recent callback is the last one
+    const int windowSize = (int)window.size();
+    const int first = (windowNext - windowCount + windowSize) % windowSize;
+    const auto& latest = window[(size_t)((windowNext - 1 + windowSize) % windowSize)];
+    summary.budgetMicros = latest.budgetMicros;
+    summary.numDecks = latest.numDecks;
+
+    std::vector<float> callbackMicros, budgetUsed, controllerLatency;
+    std::array<std::vector<float>, maxDecks> deckMicros;
+    std::array<double, maxDecks> deckLoadTotal{};
+    callbackMicros.reserve((size_t)windowCount);
+    budgetUsed.reserve((size_t)windowCount);
+
+    for (int i = 0; i < windowCount; ++i) {
+        const auto& timing = window[(size_t)((first + i) % windowSize)];
+        const float budget = juce::jmax(1.0f, timing.budgetMicros);
+
+        callbackMicros.push_back(timing.callbackMicros);
+        budgetUsed.push_back(100.0f * timing.callbackMicros / budget);
+
+        if (timing.controllerLatencyMicros >= 0.0f)
+            controllerLatency.push_back(timing.controllerLatencyMicros);
+
+        for (int deck = 0; deck < juce::jmin(timing.numDecks, maxDecks); ++deck) {
+            deckMicros[(size_t)deck].push_back(timing.deckMicros[(size_t)deck]);
+            deckLoadTotal[(size_t)deck] += 100.0 * timing.deckMicros[(size_t)deck] / budget;
+        }
+    }
+
+    summary.callbackMicros = computePercentiles(callbackMicros);
+    summary.budgetUsedPercent = computePercentiles(budgetUsed);
+    summary.numControllerCallbacks = (int)controllerLatency.size();
+    summary.controllerLatencyMicros = computePercentiles(controllerLatency);
+
+    for (int deck = 0; deck < summary.numDecks; ++deck) {
+        auto& series = deckMicros[(size_t)deck];
+        if (series.empty())
+            continue;
+
+        summary.deckLoadPercent[(size_t)deck] = (float)(deckLoadTotal[(size_t)deck] / (double)series.size());
+        summary.deckMicros[(size_t)deck] = computePercentiles(series);
+    }
+
+    return summary;
+}
+
+juce::String AudioProfiler::formatSummary(const Summary& summary, int deviceXRuns) {
+    juce::String text;
+    text << "Audio profile: last " << summary.numCallbacks << " callbacks, budget "
+         << juce::String(summary.budgetMicros, 0) << " us\n";
+    text << "  callback  " << formatPercentiles(summary.callbackMicros, " us") << "\n";
+    text << "  budget    " << formatPercentiles(summary.budgetUsedPercent, "%") << "\n";
+
+    for (int deck = 0; deck < summary.numDecks; ++deck)
+        text << "  deck " << (deck + 1) << "    load " << juce::String(summary.deckLoadPercent[(size_t)deck], 1)
+             << "%  " << formatPercentiles(summary.deckMicros[(size_t)deck], " us") << "\n";
+
+    if (summary.numControllerCallbacks > 0)
+        text << "  midi      " << formatPercentiles(summary.controllerLatencyMicros, " us")
+             << " to the deck block, over " << summary.numControllerCallbacks << " callbacks\n";
+
+    text << "  callbacks " << (juce::int64)summary.totalCallbacks
+         << ", missed deadlines " << (juce::int64)summary.missedDeadlines
+         << ", xruns " << (deviceXRuns >= 0 ? juce::String(deviceXRuns) : juce::String("n/a"))
+         << ", dropped timings " << (juce::int64)summary.droppedTimings << "\n";
+    return text;
+}
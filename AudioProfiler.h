@@ -0,0 +1,102 @@
+/*
+  ==============================================================================
+
+    AudioProfiler.h
+    Created: 17 Oct 2026 8:34:12pm
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "DeckMixer.h"
+#include <array>
+
+// AudioProfiler class
+// Wait-free instrumentation of the audio callback. The audio thread writes one timing record per block
+// into a lock-free ring; the message thread drains the ring into a rolling window and reports
+// percentiles, deadline budget usage and the CPU load of every deck.
+class AudioProfiler {
+public:
+    static constexpr int maxDecks = DeckMixer::maxDecks;
+
+    // How long one audio callback took, against how long it had before the device needed the block
+    struct CallbackTiming {
+        float callbackMicros = 0.0f;
+        float budgetMicros = 0.0f;
+        int numDecks = 0;
+        std::array<float, maxDecks> deckMicros{};
+
+        // Longest time from a MIDI message to the start of the deck block that applied it, negative if none
+        float controllerLatencyMicros = -1.0f;
+    };
+
+    // Median, 99th percentile and worst case of a series
+    struct Percentiles {
+        float p50 = 0.0f;
+        float p99 = 0.0f;
+        float max = 0.0f;
+    };
+
+    // Statistics over the rolling window, plus counters since the profiler was created
+    struct Summary {
+        int numCallbacks = 0;
+        float budgetMicros = 0.0f;  // Budget of the most recent callback
+        Percentiles callbackMicros;
+        Percentiles budgetUsedPercent;
+        int numDecks = 0;
+        std::array<Percentiles, maxDecks> deckMicros;
+        std::array<float, maxDecks> deckLoadPercent{};  // Average render time as a share of the budget
+        int numControllerCallbacks = 0;  // Callbacks that applied controller commands
+        Percentiles controllerLatencyMicros;
+        juce::uint64 totalCallbacks = 0;
+        juce::uint64 missedDeadlines = 0;
+        juce::uint64 droppedTimings = 0;
+    };
+
+    // Constructor: capacity is the number of timings the ring holds between drains,
+    // windowSize the number of recent callbacks the statistics are taken over
+    explicit AudioProfiler(int capacity = 4096, int windowSize = 4096);
+
+    // Returns a timestamp for measuring a section of the callback (any thread)
+    static juce::int64 now() noexcept { return juce::Time::getHighResolutionTicks(); }
+
+    // Converts the time between two timestamps to microseconds
+    static float microsBetween(juce::int64 startTicks, juce::int64 endTicks) noexcept;
+
+    // Records one callback (audio thread only). Never blocks or allocates; a full ring drops the timing
+    void recordCallback(const CallbackTiming& timing) noexcept;
+
+    // Moves the pending timings into the rolling window (message thread only)
+    void collect();
+
+    // Computes the statistics of the rolling window (message thread only)
+    Summary getSummary() const;
+
+    // Number of callbacks that took longer than their budget since the profiler was created (any thread)
+    juce::uint64 getMissedDeadlines() const noexcept { return missedDeadlines.load(std::memory_order_relaxed); }
+
+    // Formats a summary as a multi-line report for the log. Pass a negative xrun count if it is unknown
+    static juce::String formatSummary(const Summary& summary, int deviceXRuns = -1);
+
+private:
+    // Index bookkeeping for the ring (lock-free)
+    juce::AbstractFifo fifo;
+
+    // Storage for the ring, allocated once up front
+    std::vector<CallbackTiming> timings;
+
+    // Most recent timings, oldest overwritten first
+    std::vector<CallbackTiming> window;
+    int windowNext = 0;
+    int windowCount = 0;
+
+    // Counters written by the audio thread
+    std::atomic<juce::uint64> totalCallbacks{ 0 };
+    std::atomic<juce::uint64> missedDeadlines{ 0 };
+    std::atomic<juce::uint64> droppedTimings{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AudioProfiler)
+};
@@ -0,0 +1,303 @@
+/*
+  ==============================================================================
+
+    BeatAnalyser.cpp
+    Created: 17 Oct 2026 4:20:51pm
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#include "BeatAnalyser.h"
+#include "VectorOps.h"
+#include <numeric>
+
+namespace {
+    // Upper edge of the kick band
+    constexpr double lowBandHz = 150.0;
+
+    // Width of the tempo preference around 120 BPM, in octaves
+    constexpr double tempoPreferenceOctaves = 1.0;
+
+    // Reads the envelope between frames with linear interpolation (0 outside it)
+    float sampleEnvelope(const std::vector<float>& envelope, double frame) {
+        const int index = (int)frame;
+        if (frame < 0.0 || index + 1 >= (int)envelope.size())
+            return 0.0f;
+
+        const float fraction = (float)(frame - index);
+        return envelope[(size_t)index] + fraction * (envelope[(size_t)index + 1] - envelope[(size_t)index]);
+    }
+
+    // Returns the mean of the envelope at offset, offset + period, offset + 2 * period, ...
+    float combMean(const std::vector<float>& envelope, double period, double offset) {
+        float sum = 0.0f;
+        int count = 0;
+
+        for (double frame = offset; frame < (double)envelope.size() - 1.0; frame += period, ++count)
+            sum += sampleEnvelope(envelope, frame);
+
+        return count > 0 ? sum / (float)count : 0.0f;
+    }
+}
+
+// Frames are 10 ms long at any sample rate
+void BeatAnalyser::prepare(double rate) {
+    sampleRate = rate;
+    hopSize = juce::jmax(1, juce::roundToInt(rate / 100.0));
+    framesPerSecond = rate / hopSize;
+    lowCoefficient = rate > 0.0 ? (float)(1.0 - std::exp(-juce::MathConstants<double>::twoPi * lowBandHz / rate)) : 1.0f;
+
+    lowState = 0.0f;
+    fullEnergy = 0.0;
+    lowEnergy = 0.0;
+    samplesInFrame = 0;
+    hasPreviousFrame = false;
+    onsetEnvelope.clear();
+    restoredFromCache = false;
+}
+
+// Mixes the block to mono and accumulates the energy of both bands frame by frame
+void BeatAnalyser::process(const juce::AudioBuffer<float>& buffer, int startSample, int numSamples) {
+    const int numChannels = buffer.getNumChannels();
+    if (numChannels == 0 || numSamples <= 0)
+        return;
+
+    // The lowpass decays into denormals over silence, which would slow it down many times over
+    juce::ScopedNoDenormals noDenormals;
+
+    if ((int)mono.size() < numSamples)
+        mono.resize((size_t)numSamples);
+
+    juce::FloatVectorOperations::copy(mono.data(), buffer.getReadPointer(0, startSample), numSamples);
+    for (int channel = 1; channel < numChannels; ++channel)
+        juce::FloatVectorOperations::add(mono.data(), buffer.getReadPointer(channel, startSample), numSamples);
+    if (numChannels > 1)
+        juce::FloatVectorOperations::multiply(mono.data(), 1.0f / (float)numChannels, numSamples);
+
+    int i = 0;
+    while (i < numSamples) {
+        // Take the rest of the current frame, or as much of it as this block holds
+        const int count = juce::jmin(hopSize - samplesInFrame, numSamples - i);
+        const float* samples = mono.data() + i;
+
+        fullEnergy += VectorOps::sumOfSquares(samples, count);
+
+        for (int j = 0; j < count; ++j) {
+            lowState += lowCoefficient * (samples[j] - lowState);
+            lowEnergy += lowState * lowState;
+        }
+
+        i += count;
+        samplesInFrame += count;
+
+        if (samplesInFrame == hopSize)
+            finishFrame();
+    }
+}
+
+// Starts a fresh analysis at the track's rate
+void BeatAnalyser::decodeStarted(int numChannels, double rate, juce::int64 lengthInSamples) {
+    juce::ignoreUnused(numChannels, lengthInSamples);
+    prepare(rate);
+}
+
+// Adds a block of the decode pass
+void BeatAnalyser::decodeBlock(const juce::AudioBuffer<float>& buffer, juce::int64 startSample, int numSamples) {
+    juce::ignoreUnused(startSample);
+    process(buffer, 0, numSamples);
+}
+
+// Names the analyser's section in the track cache
+juce::String BeatAnalyser::getCacheSectionName() const {
+    return "beatgrid";
+}
+
+// Writes the grid estimated from the pass
+void BeatAnalyser::saveToCache(juce::OutputStream& output) {
+    const BeatGrid grid = getResult();
+    output.writeDouble(grid.bpm);
+    output.writeDouble(grid.firstBeatSeconds);
+    output.writeFloat(grid.confidence);
+}
+
+// Reads back a grid written by saveToCache()
+bool BeatAnalyser::loadFromCache(juce::InputStream& input) {
+    if (input.getTotalLength() < 2 * (juce::int64)sizeof(double) + (juce::int64)sizeof(float))
+        return false;
+
+    cachedGrid.bpm = input.readDouble();
+    cachedGrid.firstBeatSeconds = input.readDouble();
+    cachedGrid.confidence = input.readFloat();
+    restoredFromCache = true;
+    return true;
+}
+
+// Onset strength is the half-wave rectified rise in log energy of each band
+void BeatAnalyser::finishFrame() {
+    const float fullLog = (float)std::log(1.0e-9 + fullEnergy / hopSize);
+    const float lowLog = (float)std::log(1.0e-9 + lowEnergy / hopSize);
+
+    float onset = 0.0f;
+    if (hasPreviousFrame)
+        onset = juce::jmax(0.0f, fullLog - previousFullLog) + juce::jmax(0.0f, lowLog - previousLowLog);
+
+    onsetEnvelope.push_back(onset);
+
+    previousFullLog = fullLog;
+    previousLowLog = lowLog;
+    hasPreviousFrame = true;
+    fullEnergy = 0.0;
+    lowEnergy = 0.0;
+    samplesInFrame = 0;
+}
+
+// Estimates the beat grid from everything fed in so far
+BeatGrid BeatAnalyser::getResult() const {
+    if (restoredFromCache)
+        return cachedGrid;
+
+    const int numFrames = (int)onsetEnvelope.size();
+
+    // Need a few beats at the slowest tempo, plus room for the double-period check
+    const int minFrames = (int)(framesPerSecond * 60.0 / minBpm * 8.0);
+    if (numFrames < minFrames)
+        return {};
+
+    // Keep only what stands out from the local average over half a second, then smooth
+    // lightly so onsets that straddle two frames still line up with the grid
+    const int halfWindow = juce::jmax(1, juce::roundToInt(framesPerSecond * 0.25));
+    std::vector<double> prefix((size_t)numFrames + 1, 0.0);
+    for (int n = 0; n < numFrames; ++n)
+        prefix[(size_t)n + 1] = prefix[(size_t)n] + onsetEnvelope[(size_t)n];
+
+    std::vector<float> peaks((size_t)numFrames);
+    for (int n = 0; n < numFrames; ++n) {
+        const int from = juce::jmax(0, n - halfWindow);
+        const int to = juce::jmin(numFrames, n + halfWindow + 1);
+        const double localMean = (prefix[(size_t)to] - prefix[(size_t)from]) / (to - from);
+        peaks[(size_t)n] = juce::jmax(0.0f, onsetEnvelope[(size_t)n] - (float)localMean);
+    }
+
+    std::vector<float> envelope((size_t)numFrames);
+    for (int n = 0; n < numFrames; ++n) {
+        const float previous = n > 0 ? peaks[(size_t)n - 1] : 0.0f;
+        const float next = n + 1 < numFrames ? peaks[(size_t)n + 1] : 0.0f;
+        envelope[(size_t)n] = 0.25f * previous + 0.5f * peaks[(size_t)n] + 0.25f * next;
+    }
+
+    const double coarsePeriod = findBeatPeriod(envelope);
+    if (coarsePeriod <= 0.0)
+        return {};
+
+    double period = coarsePeriod;
+    double offset = 0.0;
+    const float onBeat = fitGrid(envelope, coarsePeriod, period, offset);
+
+    BeatGrid grid;
+    grid.bpm = 60.0 * framesPerSecond / period;
+
+    // Onsets are counted in the frame that contains them, so place each beat mid-frame
+    grid.firstBeatSeconds = (offset + 0.5) / framesPerSecond;
+    if (grid.firstBeatSeconds >= grid.getBeatLengthSeconds())
+        grid.firstBeatSeconds -= grid.getBeatLengthSeconds();
+
+    const double meanEnvelope = (double)std::accumulate(envelope.begin(), envelope.end(), 0.0f) / numFrames;
+    grid.confidence = onBeat > 0.0f ? juce::jlimit(0.0f, 1.0f, (float)(1.0 - meanEnvelope / onBeat)) : 0.0f;
+
+    return grid;
+}
+
+// Scores every lag in the tempo range by its autocorrelation plus half that of twice the lag,
+// weighted towards 120 BPM, and returns the best one refined by parabolic interpolation
+double BeatAnalyser::findBeatPeriod(const std::vector<float>& envelope) const {
+    const int numFrames = (int)envelope.size();
+    const int minLag = juce::jmax(1, (int)std::floor(framesPerSecond * 60.0 / maxBpm));
+    const int maxLag = (int)std::ceil(framesPerSecond * 60.0 / minBpm);
+    const int maxCorrelationLag = juce::jmin(2 * maxLag + 2, numFrames - 1);
+
+    std::vector<float> correlation((size_t)maxCorrelationLag + 1, 0.0f);
+    for (int lag = minLag; lag <= maxCorrelationLag; ++lag) {
+        const int count = numFrames - lag;
+        correlation[(size_t)lag] = VectorOps::dotProduct(envelope.data(), envelope.data() + lag, count) / (float)count;
+    }
+
+    std::vector<float> score((size_t)maxLag + 2, 0.0f);
+    int bestLag = -1;
+
+    for (int lag = minLag; lag <= maxLag; ++lag) {
+        const double octavesFrom120 = std::log2(60.0 * framesPerSecond / lag / 120.0) / tempoPreferenceOctaves;
+        const double weight = std::exp(-0.5 * octavesFrom120 * octavesFrom120);
+        const float doubled = 2 * lag <= maxCorrelationLag ? correlation[(size_t)(2 * lag)] : 0.0f;
+
+        score[(size_t)lag] = (float)weight * (correlation[(size_t)lag] + 0.5f * doubled);
+
+        if (bestLag < 0 || score[(size_t)lag] > score[(size_t)bestLag])
+            bestLag = lag;
+    }
+
+    if (bestLag < 0 || score[(size_t)bestLag] <= 0.0f)
+        return 0.0;
+
+    if (bestLag > minLag && bestLag < maxLag) {
+        const float left = score[(size_t)bestLag - 1];
+        const float centre = score[(size_t)bestLag];
+        const float right = score[(size_t)bestLag + 1];
+        const float curvature = left - 2.0f * centre + right;
+
+        if (curvature < 0.0f)
+            return bestLag + 0.5 * (left - right) / curvature;
+    }
+
+    return bestLag;
+}
+
+// A tiny period error drifts by a whole frame every few dozen beats, so the period is searched
+// in fine steps within a frame of the coarse estimate, trying every whole-frame offset for each
+float BeatAnalyser::fitGrid(const std::vector<float>& envelope, double coarsePeriod, double& period, double& offset) const {
+    constexpr int numPeriodSteps = 100;
+    float best = -1.0f;
+
+    for (int step = -numPeriodSteps; step <= numPeriodSteps; ++step) {
+        const double candidatePeriod = coarsePeriod + (double)step / numPeriodSteps;
+
+        for (int candidateOffset = 0; candidateOffset < (int)std::ceil(candidatePeriod); ++candidateOffset) {
+            const float mean = combMean(envelope, candidatePeriod, candidateOffset);
+
+            if (mean > best) {
+                best = mean;
+                period = candidatePeriod;
+                offset = candidateOffset;
+            }
+        }
+    }
+
+    // Settle the offset to a fraction of a frame at the chosen period
+    const double wholeOffset = offset;
+    for (int step = -4; step <= 4; ++step) {
+        const double candidateOffset = wholeOffset + step * 0.125;
+        const float mean = combMean(envelope, period, candidateOffset);
+
+        if (candidateOffset >= 0.0 && mean > best) {
+            best = mean;
+            offset = candidateOffset;
+        }
+    }
+
+    return juce::jmax(0.0f, best);
+}
+
+// Runs a decode pass over the reader feeding only this analysis
+BeatGrid BeatAnalyser::analyseReader(juce::AudioFormatReader& reader, const std::function<bool()>& shouldCancel) {
+    if (reader.sampleRate <= 0.0 || reader.numChannels == 0)
+        return {};
+
+    BeatAnalyser analyser;
+    TrackDecoder decoder;
+    decoder.addConsumer(&analyser);
+
+    if (!decoder.run(reader, shouldCancel))
+        return {};
+
+    return analyser.getResult();
+}
@@ -0,0 +1,96 @@
+/*
+  ==============================================================================
+
+    BeatAnalyser.h
+    Created: 17 Oct 2026 4:20:51pm
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "BeatGrid.h"
+#include "TrackDecoder.h"
+
+// Estimates the tempo and beat positions of a track from its decoded audio.
+//
+// Audio is fed in blocks to build an onset envelope at 100 frames per second: the rectified
+// rise in log energy of the whole signal plus that of the band below 150 Hz, where kicks sit.
+// getResult() then picks the tempo whose autocorrelation of the envelope is strongest
+// (weighted towards 120 BPM to settle octave errors) and the phase whose beats land on the
+// most onset energy. Nothing here touches the audio or message threads.
+class BeatAnalyser : public TrackDecodeConsumer {
+public:
+
+    // Constructor: call prepare() before feeding audio, or run it in a TrackDecoder pass
+    BeatAnalyser() = default;
+
+    // Sets the rate of the audio that will be fed in and clears any previous analysis
+    void prepare(double sampleRate);
+
+    // Adds a block of audio; all channels are mixed to mono
+    void process(const juce::AudioBuffer<float>& buffer, int startSample, int numSamples);
+
+    // TrackDecodeConsumer: a decode pass prepares the analyser and feeds it every block
+    void decodeStarted(int numChannels, double sampleRate, juce::int64 lengthInSamples) override;
+    void decodeBlock(const juce::AudioBuffer<float>& buffer, juce::int64 startSample, int numSamples) override;
+
+    // TrackDecodeConsumer: only the grid is cached, not the envelope
+    juce::String getCacheSectionName() const override;
+    void saveToCache(juce::OutputStream& output) override;
+    bool loadFromCache(juce::InputStream& input) override;
+
+    // Estimates the beat grid from everything fed in so far, or returns the one loaded from the cache
+    BeatGrid getResult() const;
+
+    // Runs a decode pass over a whole reader with only this analysis attached and returns its
+    // beat grid. shouldCancel is polled between blocks; an empty grid is returned if it ever
+    // returns true.
+    static BeatGrid analyseReader(juce::AudioFormatReader& reader, const std::function<bool()>& shouldCancel);
+
+    // Tempo range searched by getResult()
+    static constexpr double minBpm = 70.0;
+    static constexpr double maxBpm = 180.0;
+
+private:
+    // Closes the current frame and appends its onset strength to the envelope
+    void finishFrame();
+
+    // Returns the lag in frames of the strongest tempo candidate
+    double findBeatPeriod(const std::vector<float>& envelope) const;
+
+    // Refines the period around coarsePeriod and finds the offset of the first beat, both in
+    // frames, by maximising the onset energy under the grid. Returns that mean energy per beat.
+    float fitGrid(const std::vector<float>& envelope, double coarsePeriod, double& period, double& offset) const;
+
+    double sampleRate = 0.0;
+    int hopSize = 1;
+    double framesPerSecond = 0.0;
+
+    // One-pole lowpass isolating the kick band
+    float lowCoefficient = 0.0f;
+    float lowState = 0.0f;
+
+    // Energy accumulated over the current frame
+    double fullEnergy = 0.0;
+    double lowEnergy = 0.0;
+    int samplesInFrame = 0;
+
+    // Log energies of the previous frame
+    float previousFullLog = 0.0f;
+    float previousLowLog = 0.0f;
+    bool hasPreviousFrame = false;
+
+    // Mono mix of the block being processed
+    std::vector<float> mono;
+
+    // Onset strength per frame
+    std::vector<float> onsetEnvelope;
+
+    // Grid restored by loadFromCache(), returned instead of analysing the envelope
+    BeatGrid cachedGrid;
+    bool restoredFromCache = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BeatAnalyser)
+};
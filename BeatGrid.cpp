@@ -0,0 +1,45 @@
+/*
+  ==============================================================================
+
+    BeatGrid.cpp
+    Created: 17 Oct 2026 4:12:36pm
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#include "BeatGrid.h"
+
+// Returns true if the grid holds a tempo
+bool BeatGrid::isValid() const {
+    return bpm > 0.0;
+}
+
+// Returns the length of one beat in seconds
+double BeatGrid::getBeatLengthSeconds() const {
+    return isValid() ? 60.0 / bpm : 0.0;
+}
+
+// Returns the time of a beat, counting from the first beat
+double BeatGrid::getBeatTime(int beatIndex) const {
+    return firstBeatSeconds + beatIndex * getBeatLengthSeconds();
+}
+
+// Returns the number of beats since the first beat, negative before it
+double BeatGrid::getBeatPosition(double seconds) const {
+    return isValid() ? (seconds - firstBeatSeconds) / getBeatLengthSeconds() : 0.0;
+}
+
+// Returns the fractional part of the beat position, wrapped into 0 to 1 before the first beat too
+double BeatGrid::getBeatPhase(double seconds) const {
+    const double position = getBeatPosition(seconds);
+    return position - std::floor(position);
+}
+
+// Returns the number of beats that start before lengthSeconds
+int BeatGrid::getNumBeats(double lengthSeconds) const {
+    if (!isValid() || lengthSeconds <= firstBeatSeconds)
+        return 0;
+
+    return (int)std::ceil((lengthSeconds - firstBeatSeconds) / getBeatLengthSeconds());
+}
@@ -0,0 +1,43 @@
+/*
+  ==============================================================================
+
+    BeatGrid.h
+    Created: 17 Oct 2026 4:12:36pm
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// Constant-tempo beat grid of a track: every beat is firstBeatSeconds plus a whole number of
+// beat lengths, so the whole grid fits in a few bytes and can be copied freely between threads
+struct BeatGrid {
+    // Tempo in beats per minute (0 when the track hasn't been analysed)
+    double bpm = 0.0;
+
+    // Time of the first beat at or after the start of the track
+    double firstBeatSeconds = 0.0;
+
+    // How strongly the onsets agree with the grid (0 to 1)
+    float confidence = 0.0f;
+
+    // Returns true if the grid holds a tempo
+    bool isValid() const;
+
+    // Returns the length of one beat in seconds
+    double getBeatLengthSeconds() const;
+
+    // Returns the time of a beat, counting from the first beat
+    double getBeatTime(int beatIndex) const;
+
+    // Returns the number of beats since the first beat, with the fraction of the current beat
+    double getBeatPosition(double seconds) const;
+
+    // Returns how far through the current beat a time is (0 to 1)
+    double getBeatPhase(double seconds) const;
+
+    // Returns the number of beats that start before lengthSeconds
+    int getNumBeats(double lengthSeconds) const;
+};
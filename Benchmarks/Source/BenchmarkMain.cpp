@@ -0,0 +1,796 @@
+/*
+  ==============================================================================
+
+    BenchmarkMain.cpp
+    Created: 17 Oct 2026 3:02:44pm
+    Author:  LAPTOP WORLD
+
+    Console benchmarks for the OtoDesks audio engine, load path and waveform
+    drawing. Run the Release build; timings from a Debug build are meaningless.
+
+    OtoDesksBenchmarks [--only name,name...] [--json results.json] [--csv results.csv]
+
+    Benchmarks: timestretch, resampler, eq, player, mixer, load, thumbnail, paint, beats, library, loudness
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <algorithm>
+#include <iostream>
+#include "../../Source/TimeStretchAudioSource.h"
+#include "../../Source/FusedResamplerAudioSource.h"
+#include "../../Source/BeatAnalyser.h"
+#include "../../Source/DeckMixer.h"
+#include "../../Source/DeckEQ.h"
+#include "../../Source/LoudnessAnalyser.h"
+#include "../../Source/MusicLibrary.h"
+#include "../../Source/djAudioPlayer.h"
+#include "../../Source/WaveFormDisplay.h"
+#include "../../Source/WaveformPyramid.h"
+#include "../../Source/ZoomedWaveformDisplay.h"
+#include "BenchmarkReport.h"
+
+namespace {
+
+    constexpr double benchSampleRate = 48000.0;
+
+    // Deterministic broadband test signal, so every run stretches the same audio
+    class NoiseAudioSource : public juce::AudioSource {
+    public:
+        void prepareToPlay(int, double) override {}
+        void releaseResources() override {}
+
+        void getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill) override {
+            for (int channel = 0; channel < bufferToFill.buffer->getNumChannels(); ++channel) {
+                auto* data = bufferToFill.buffer->getWritePointer(channel, bufferToFill.startSample);
+                for (int i = 0; i < bufferToFill.numSamples; ++i)
+                    data[i] = random.nextFloat() * 0.5f - 0.25f;
+            }
+        }
+
+    private:
+        juce::Random random{ 1234 };
+    };
+
+    // Per-block render times in microseconds
+    struct BlockTimings {
+        double mean = 0.0;
+        double p99 = 0.0;
+        double worst = 0.0;
+    };
+
+    // Renders numBlocks blocks from source after a warm-up and returns the timing distribution
+    BlockTimings timeBlocks(juce::AudioSource& source, int blockSize, int numBlocks) {
+        juce::AudioBuffer<float> buffer(2, blockSize);
+        juce::AudioSourceChannelInfo info(&buffer, 0, blockSize);
+
+        for (int i = 0; i < 64; ++i)
+            source.getNextAudioBlock(info);
+
+        std::vector<double> micros((size_t)numBlocks);
+        for (auto& m : micros) {
+            const auto start = juce::Time::getHighResolutionTicks();
+            source.getNextAudioBlock(info);
+            const auto end = juce::Time::getHighResolutionTicks();
+            m = juce::Time::highResolutionTicksToSeconds(end - start) * 1.0e6;
+        }
+
+        std::sort(micros.begin(), micros.end());
+
+        BlockTimings timings;
+        for (auto m : micros)
+            timings.mean += m;
+        timings.mean /= (double)numBlocks;
+        timings.p99 = micros[(size_t)((double)(numBlocks - 1) * 0.99)];
+        timings.worst = micros.back();
+        return timings;
+    }
+
+    // Cost per block of the keylock time-stretcher at common buffer sizes and speeds
+    void benchmarkTimeStretch(BenchmarkReport& report) {
+        std::cout << "TimeStretchAudioSource, stereo, " << benchSampleRate << " Hz" << std::endl;
+        std::cout << "block  ratio   mean us    p99 us  worst us  budget %" << std::endl;
+
+        const int blockSizes[] = { 64, 128, 256, 512, 1024 };
+        const double ratios[] = { 0.8, 1.0, 1.25, 2.0 };
+
+        for (auto blockSize : blockSizes) {
+            for (auto ratio : ratios) {
+                NoiseAudioSource noise;
+                TimeStretchAudioSource stretch(&noise, false, 2);
+                stretch.prepareToPlay(blockSize, benchSampleRate);
+                stretch.setStretchRatio(ratio);
+
+                // About 20 seconds of audio per case
+                const int numBlocks = juce::jmax(200, (int)(benchSampleRate * 20.0) / blockSize);
+                const auto timings = timeBlocks(stretch, blockSize, numBlocks);
+
+                const double budgetMicros = blockSize / benchSampleRate * 1.0e6;
+
+                std::cout << juce::String(blockSize).paddedLeft(' ', 5)
+                    << juce::String(ratio, 2).paddedLeft(' ', 7)
+                    << juce::String(timings.mean, 2).paddedLeft(' ', 10)
+                    << juce::String(timings.p99, 2).paddedLeft(' ', 10)
+                    << juce::String(timings.worst, 2).paddedLeft(' ', 10)
+                    << juce::String(100.0 * timings.mean / budgetMicros, 2).paddedLeft(' ', 10)
+                    << std::endl;
+
+                report.add({ "timestretch", { { "block", blockSize }, { "ratio", ratio } },
+                    { { "mean_us", timings.mean }, { "p99_us", timings.p99 }, { "worst_us", timings.worst },
+                      { "budget_pct", 100.0 * timings.mean / budgetMicros } } });
+
+                stretch.releaseResources();
+            }
+        }
+    }
+
+    // Cost per block of the fused resampler for each quality at typical ratios
+    void benchmarkResampler(BenchmarkReport& report) {
+        std::cout << "FusedResamplerAudioSource, stereo, " << benchSampleRate << " Hz" << std::endl;
+        std::cout << "quality   block  ratio   mean us    p99 us  worst us  budget %" << std::endl;
+
+        const std::pair<FusedResamplerAudioSource::Quality, const char*> qualities[] = {
+            { FusedResamplerAudioSource::Quality::draft, "draft" },
+            { FusedResamplerAudioSource::Quality::standard, "standard" },
+            { FusedResamplerAudioSource::Quality::high, "high" }
+        };
+        const int blockSizes[] = { 128, 512 };
+
+        // 44.1 kHz file on a 48 kHz device at normal speed, +8% pitch and double speed
+        const double ratios[] = { 44100.0 / 48000.0, 1.08 * 44100.0 / 48000.0, 2.0 * 44100.0 / 48000.0 };
+
+        for (auto& quality : qualities) {
+            for (auto blockSize : blockSizes) {
+                for (auto ratio : ratios) {
+                    NoiseAudioSource noise;
+                    FusedResamplerAudioSource resampler(&noise, false, 2);
+                    resampler.prepareToPlay(blockSize, benchSampleRate);
+                    resampler.setQuality(quality.first);
+                    resampler.setResamplingRatio(ratio);
+
+                    const int numBlocks = juce::jmax(200, (int)(benchSampleRate * 20.0) / blockSize);
+                    const auto timings = timeBlocks(resampler, blockSize, numBlocks);
+
+                    const double budgetMicros = blockSize / benchSampleRate * 1.0e6;
+
+                    std::cout << juce::String(quality.second).paddedRight(' ', 8)
+                        << juce::String(blockSize).paddedLeft(' ', 6)
+                        << juce::String(ratio, 3).paddedLeft(' ', 7)
+                        << juce::String(timings.mean, 2).paddedLeft(' ', 10)
+                        << juce::String(timings.p99, 2).paddedLeft(' ', 10)
+                        << juce::String(timings.worst, 2).paddedLeft(' ', 10)
+                        << juce::String(100.0 * timings.mean / budgetMicros, 2).paddedLeft(' ', 10)
+                        << std::endl;
+
+                    report.add({ "resampler", { { "quality", quality.second }, { "block", blockSize }, { "ratio", ratio } },
+                        { { "mean_us", timings.mean }, { "p99_us", timings.p99 }, { "worst_us", timings.worst },
+                          { "budget_pct", 100.0 * timings.mean / budgetMicros } } });
+
+                    resampler.releaseResources();
+                }
+            }
+        }
+    }
+
+    // Encodes track into a temporary file of the given format, deleted when the returned object goes
+    std::unique_ptr<juce::TemporaryFile> writeTrackFile(juce::AudioFormat& format, const juce::AudioBuffer<float>& track, double sampleRate) {
+        auto file = std::make_unique<juce::TemporaryFile>(format.getFileExtensions()[0]);
+        const int qualityIndex = format.getQualityOptions().size() / 2;
+
+        std::unique_ptr<juce::AudioFormatWriter> writer(format.createWriterFor(
+            file->getFile().createOutputStream().release(), sampleRate, (unsigned int)track.getNumChannels(), 16, {}, qualityIndex));
+
+        if (writer != nullptr)
+            writer->writeFromAudioSampleBuffer(track, 0, track.getNumSamples());
+
+        return file;
+    }
+
+    // Times one statement in milliseconds
+    template <typename Function>
+    double timeMs(Function&& function) {
+        const auto start = juce::Time::getHighResolutionTicks();
+        function();
+        return juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start) * 1000.0;
+    }
+
+    // Cost per block of a whole deck (transport, read-ahead, stretcher and resampler) playing a 44.1 kHz
+    // file on a 48 kHz device, at several buffer sizes and speeds, with and without keylock
+    void benchmarkPlayer(BenchmarkReport& report, const juce::File& trackFile) {
+        std::cout << "DJAudioPlayer::getNextAudioBlock, 44.1 kHz WAV on a " << benchSampleRate << " Hz device" << std::endl;
+        std::cout << "block  speed  keylock   mean us    p99 us  worst us  budget %" << std::endl;
+
+        const int blockSizes[] = { 64, 256, 1024 };
+        const double speeds[] = { 0.8, 1.0, 1.25 };
+
+        for (auto blockSize : blockSizes) {
+            for (auto speed : speeds) {
+                for (auto keylock : { false, true }) {
+                    DJAudioPlayer player;
+                    player.prepareToPlay(blockSize, benchSampleRate);
+                    player.loadURLNow(juce::URL(trackFile));
+                    player.setspeed(speed);
+                    player.setKeylock(keylock);
+                    player.start();
+
+                    // About 20 seconds of audio per case; the warm-up blocks apply the commands
+                    const int numBlocks = juce::jmax(200, (int)(benchSampleRate * 20.0) / blockSize);
+                    const auto timings = timeBlocks(player, blockSize, numBlocks);
+                    const double budgetMicros = blockSize / benchSampleRate * 1.0e6;
+
+                    std::cout << juce::String(blockSize).paddedLeft(' ', 5)
+                        << juce::String(speed, 2).paddedLeft(' ', 7)
+                        << juce::String(keylock ? "on" : "off").paddedLeft(' ', 9)
+                        << juce::String(timings.mean, 2).paddedLeft(' ', 10)
+                        << juce::String(timings.p99, 2).paddedLeft(' ', 10)
+                        << juce::String(timings.worst, 2).paddedLeft(' ', 10)
+                        << juce::String(100.0 * timings.mean / budgetMicros, 2).paddedLeft(' ', 10)
+                        << std::endl;
+
+                    report.add({ "player", { { "block", blockSize }, { "speed", speed }, { "keylock", keylock } },
+                        { { "mean_us", timings.mean }, { "p99_us", timings.p99 }, { "worst_us", timings.worst },
+                          { "budget_pct", 100.0 * timings.mean / budgetMicros } } });
+
+                    player.releaseResources();
+                }
+            }
+        }
+    }
+
+    // Callback cost of N keylocked decks mixed serially through juce::MixerAudioSource and in parallel
+    // through DeckMixer. With enough cores the DeckMixer column should stay close to a single deck's cost
+    void benchmarkMixer(BenchmarkReport& report, const juce::File& trackFile) {
+        const int blockSize = 256;
+        std::cout << "DeckMixer vs MixerAudioSource, keylocked decks at 1.1x, block " << blockSize
+            << ", " << juce::SystemStats::getNumCpus() << " cpus" << std::endl;
+        std::cout << "decks   serial us  parallel us  speed-up  budget %" << std::endl;
+
+        for (int numDecks = DeckMixer::minDecks; numDecks <= DeckMixer::maxDecks; numDecks *= 2) {
+            juce::OwnedArray<DJAudioPlayer> players;
+
+            for (int i = 0; i < numDecks; ++i)
+                players.add(new DJAudioPlayer());
+
+            // Each mixer prepares the decks again, so load and start them after that
+            auto loadDecks = [&players, &trackFile] {
+                for (auto* player : players) {
+                    player->loadURLNow(juce::URL(trackFile));
+                    player->setspeed(1.1);
+                    player->setKeylock(true);
+                    player->start();
+                }
+            };
+
+            const int numBlocks = (int)(benchSampleRate * 10.0) / blockSize;
+
+            juce::MixerAudioSource serialMixer;
+            for (auto* player : players)
+                serialMixer.addInputSource(player, false);
+            serialMixer.prepareToPlay(blockSize, benchSampleRate);
+            loadDecks();
+            const auto serial = timeBlocks(serialMixer, blockSize, numBlocks);
+            serialMixer.releaseResources();
+            serialMixer.removeAllInputs();
+
+            DeckMixer parallelMixer;
+            for (auto* player : players)
+                parallelMixer.addDeck(player, DeckMixer::CrossfaderSide::thru);
+            parallelMixer.prepareToPlay(blockSize, benchSampleRate);
+            loadDecks();
+            const auto parallel = timeBlocks(parallelMixer, blockSize, numBlocks);
+            parallelMixer.releaseResources();
+
+            const double budgetMicros = blockSize / benchSampleRate * 1.0e6;
+
+            std::cout << juce::String(numDecks).paddedLeft(' ', 5)
+                << juce::String(serial.mean, 2).paddedLeft(' ', 12)
+                << juce::String(parallel.mean, 2).paddedLeft(' ', 13)
+                << juce::String(serial.mean / parallel.mean, 2).paddedLeft(' ', 10)
+                << juce::String(100.0 * parallel.mean / budgetMicros, 2).paddedLeft(' ', 10)
+                << std::endl;
+
+            report.add({ "mixer", { { "decks", numDecks }, { "block", blockSize } },
+                { { "serial_mean_us", serial.mean }, { "serial_p99_us", serial.p99 },
+                  { "parallel_mean_us", parallel.mean }, { "parallel_p99_us", parallel.p99 },
+                  { "budget_pct", 100.0 * parallel.mean / budgetMicros } } });
+        }
+    }
+
+    // Time from LoadURL until the deck reports the track loaded, for each format the app reads
+    void benchmarkLoad(BenchmarkReport& report, const juce::AudioBuffer<float>& track, double sampleRate) {
+        std::cout << "DJAudioPlayer::LoadURL until onLoadComplete, " << juce::String(track.getNumSamples() / sampleRate, 0)
+            << " s stereo track" << std::endl;
+        std::cout << "format   mean ms   worst ms" << std::endl;
+
+        juce::AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+        const int numRuns = 10;
+
+        for (int i = 0; i < formatManager.getNumKnownFormats(); ++i) {
+            auto* format = formatManager.getKnownFormat(i);
+            if (!format->canDoStereo() || format->getPossibleBitDepths().isEmpty())
+                continue;  // Read-only formats such as MP3 can't be generated here
+
+            auto trackFile = writeTrackFile(*format, track, sampleRate);
+
+            DJAudioPlayer player;
+            player.prepareToPlay(512, benchSampleRate);
+
+            double totalMs = 0.0, worstMs = 0.0;
+            for (int run = 0; run < numRuns; ++run) {
+                const double ms = timeMs([&] {
+                    player.LoadURL(juce::URL(trackFile->getFile()));
+                    while (player.isLoading())
+                        juce::MessageManager::getInstance()->runDispatchLoopUntil(1);
+                });
+
+                // The analysis pass started by the load isn't part of the latency
+                player.stopDecodePass();
+
+                totalMs += ms;
+                worstMs = juce::jmax(worstMs, ms);
+            }
+
+            const auto formatName = format->getFormatName().upToFirstOccurrenceOf(" ", false, false);
+
+            std::cout << formatName.paddedRight(' ', 7)
+                << juce::String(totalMs / numRuns, 2).paddedLeft(' ', 9)
+                << juce::String(worstMs, 2).paddedLeft(' ', 11)
+                << std::endl;
+
+            report.add({ "load", { { "format", formatName } }, { { "mean_ms", totalMs / numRuns }, { "worst_ms", worstMs } } });
+            player.releaseResources();
+        }
+    }
+
+    // Seconds of audio per second for the decode pass alone and with each waveform or analysis being built
+    void benchmarkThumbnail(BenchmarkReport& report, const juce::File& trackFile, double trackSeconds) {
+        std::cout << "Waveform generation in the decode pass, " << juce::String(trackSeconds, 0) << " s WAV" << std::endl;
+        std::cout << "consumer     mean ms  audio s/s" << std::endl;
+
+        juce::AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+        juce::AudioThumbnailCache thumbnailCache{ 1 };
+        WaveFormDisplay display(formatManager, thumbnailCache);
+        WaveformPyramid pyramid;
+
+        const std::pair<const char*, TrackDecodeConsumer*> consumers[] = {
+            { "decode", nullptr },
+            { "thumbnail", display.getDecodeConsumer() },
+            { "spectrum", display.getSpectrumConsumer() },
+            { "pyramid", &pyramid }
+        };
+        const int numRuns = 5;
+
+        for (auto& consumer : consumers) {
+            double totalMs = 0.0;
+
+            for (int run = 0; run < numRuns; ++run) {
+                std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(trackFile));
+                TrackDecoder decoder;
+                if (consumer.second != nullptr)
+                    decoder.addConsumer(consumer.second);
+
+                totalMs += timeMs([&] { decoder.run(*reader, nullptr); });
+            }
+
+            const double meanMs = totalMs / numRuns;
+
+            std::cout << juce::String(consumer.first).paddedRight(' ', 10)
+                << juce::String(meanMs, 1).paddedLeft(' ', 10)
+                << juce::String(trackSeconds * 1000.0 / meanMs, 0).paddedLeft(' ', 11)
+                << std::endl;
+
+            report.add({ "thumbnail", { { "consumer", consumer.first } },
+                { { "mean_ms", meanMs }, { "audio_s_per_s", trackSeconds * 1000.0 / meanMs } } });
+        }
+    }
+
+    // Paint time of the overview waveform (with its cached layer rebuilt and reused) and of the
+    // zoomed view, drawn into an offscreen image at several widths
+    void benchmarkPaint(BenchmarkReport& report, const juce::File& trackFile) {
+        std::cout << "Waveform paint into an offscreen image" << std::endl;
+        std::cout << "view         width   mean us    p99 us" << std::endl;
+
+        juce::AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+        juce::AudioThumbnailCache thumbnailCache{ 1 };
+        WaveFormDisplay display(formatManager, thumbnailCache);
+        WaveformPyramid pyramid;
+        ZoomedWaveformDisplay zoomedDisplay(pyramid);
+
+        std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(trackFile));
+        TrackDecoder decoder;
+        decoder.addConsumer(display.getDecodeConsumer());
+        decoder.addConsumer(display.getSpectrumConsumer());
+        decoder.addConsumer(&pyramid);
+        decoder.run(*reader, nullptr);
+
+        const BeatGrid grid{ 128.0, 0.1, 1.0f };
+        display.setBeatGrid(grid);
+        zoomedDisplay.setBeatGrid(grid);
+
+        const int widths[] = { 400, 800, 1600 };
+        const int numFrames = 300;
+
+        for (auto width : widths) {
+            display.setSize(width, 60);
+            zoomedDisplay.setSize(width, 90);
+
+            // Each case paints numFrames frames with the playhead moving, as the deck timer does
+            auto paintFrames = [&](juce::Component& component, std::function<void(int)> beforeFrame) {
+                juce::Image image(juce::Image::RGB, component.getWidth(), component.getHeight(), true);
+                juce::Graphics g(image);
+                std::vector<double> micros;
+
+                for (int frame = 0; frame < numFrames; ++frame) {
+                    DeckSnapshot snapshot;
+                    snapshot.sampleRate = reader->sampleRate;
+                    snapshot.lengthSamples = reader->lengthInSamples;
+                    snapshot.positionSamples = (juce::int64)(frame * reader->sampleRate / 30.0);
+                    display.setPlayhead(snapshot);
+                    zoomedDisplay.setPlayhead(snapshot);
+                    beforeFrame(frame);
+
+                    micros.push_back(timeMs([&] { component.paint(g); }) * 1000.0);
+                }
+
+                std::sort(micros.begin(), micros.end());
+                BlockTimings timings;
+                for (auto m : micros)
+                    timings.mean += m;
+                timings.mean /= (double)micros.size();
+                timings.p99 = micros[(size_t)((double)(micros.size() - 1) * 0.99)];
+                timings.worst = micros.back();
+                return timings;
+            };
+
+            const std::pair<const char*, BlockTimings> cases[] = {
+                { "overview", paintFrames(display, [&](int) { display.clearCuePoints(); }) },  // Rebuilds the layer
+                { "overview-cached", paintFrames(display, [](int) {}) },
+                { "zoomed", paintFrames(zoomedDisplay, [](int) {}) }
+            };
+
+            for (auto& paintCase : cases) {
+                std::cout << juce::String(paintCase.first).paddedRight(' ', 15)
+                    << juce::String(width).paddedLeft(' ', 5)
+                    << juce::String(paintCase.second.mean, 1).paddedLeft(' ', 10)
+                    << juce::String(paintCase.second.p99, 1).paddedLeft(' ', 10)
+                    << std::endl;
+
+                report.add({ "paint", { { "view", paintCase.first }, { "width", width } },
+                    { { "mean_us", paintCase.second.mean }, { "p99_us", paintCase.second.p99 }, { "worst_us", paintCase.second.worst } } });
+            }
+        }
+    }
+
+    // Synthetic 4/4 track: a decaying 60 Hz kick on every beat over low-level noise
+    juce::AudioBuffer<float> makeKickTrack(double sampleRate, double bpm, double seconds) {
+        const int numSamples = (int)(sampleRate * seconds);
+        const double beatLength = 60.0 / bpm;
+        juce::AudioBuffer<float> track(2, numSamples);
+        juce::Random random{ 1234 };
+
+        for (int i = 0; i < numSamples; ++i) {
+            const double sinceBeat = std::fmod(i / sampleRate, beatLength);
+            float sample = random.nextFloat() * 0.02f - 0.01f;
+
+            if (sinceBeat < 0.15)
+                sample += 0.8f * (float)(std::exp(-30.0 * sinceBeat) * std::sin(juce::MathConstants<double>::twoPi * 60.0 * sinceBeat));
+
+            track.setSample(0, i, sample);
+            track.setSample(1, i, sample);
+        }
+
+        return track;
+    }
+
+    // Seconds of audio the beat analyser gets through per second, decoding included
+    void benchmarkBeatAnalysis(BenchmarkReport& report) {
+        const double sampleRate = 44100.0;
+        std::cout << "BeatAnalyser, 16-bit stereo WAV decoded from memory, " << sampleRate << " Hz" << std::endl;
+        std::cout << "track s  bpm in  bpm out   mean ms  audio s/s" << std::endl;
+
+        const double lengths[] = { 60.0, 240.0 };
+        const double tempos[] = { 94.0, 128.0, 140.0 };
+        const int numRuns = 5;
+
+        juce::WavAudioFormat wavFormat;
+
+        for (auto seconds : lengths) {
+            for (auto bpm : tempos) {
+                // Encode once, then decode and analyse from memory so the disk stays out of the timings
+                const auto track = makeKickTrack(sampleRate, bpm, seconds);
+                juce::MemoryBlock wavData;
+                {
+                    std::unique_ptr<juce::AudioFormatWriter> writer(wavFormat.createWriterFor(
+                        new juce::MemoryOutputStream(wavData, false), sampleRate, 2, 16, {}, 0));
+                    writer->writeFromAudioSampleBuffer(track, 0, track.getNumSamples());
+                }
+
+                BeatGrid grid;
+                double totalSeconds = 0.0;
+
+                for (int run = 0; run < numRuns; ++run) {
+                    std::unique_ptr<juce::AudioFormatReader> reader(wavFormat.createReaderFor(
+                        new juce::MemoryInputStream(wavData, false), true));
+
+                    const auto start = juce::Time::getHighResolutionTicks();
+                    grid = BeatAnalyser::analyseReader(*reader, nullptr);
+                    const auto end = juce::Time::getHighResolutionTicks();
+                    totalSeconds += juce::Time::highResolutionTicksToSeconds(end - start);
+                }
+
+                const double meanSeconds = totalSeconds / numRuns;
+
+                std::cout << juce::String(seconds, 0).paddedLeft(' ', 7)
+                    << juce::String(bpm, 1).paddedLeft(' ', 8)
+                    << juce::String(grid.bpm, 2).paddedLeft(' ', 9)
+                    << juce::String(meanSeconds * 1000.0, 1).paddedLeft(' ', 10)
+                    << juce::String(seconds / meanSeconds, 0).paddedLeft(' ', 11)
+                    << std::endl;
+
+                report.add({ "beats", { { "track_s", seconds }, { "bpm_in", bpm } },
+                    { { "bpm_out", grid.bpm }, { "mean_ms", meanSeconds * 1000.0 }, { "audio_s_per_s", seconds / meanSeconds } } });
+            }
+        }
+    }
+
+    // Cost of the kill EQ, filter and trim on every deck the mixer allows, as a share of one core.
+    // "neutral" is a deck at its default settings, "sweep" keeps the filter knob moving throughout
+    void benchmarkEQ(BenchmarkReport& report) {
+        std::cout << "DeckEQ x " << DeckMixer::maxDecks << " decks, stereo, " << benchSampleRate << " Hz" << std::endl;
+        std::cout << "block  settings   deck us  all decks us  core %" << std::endl;
+
+        const int blockSizes[] = { 64, 128, 256, 512 };
+        const char* settings[] = { "neutral", "eq", "sweep" };
+
+        for (auto blockSize : blockSizes) {
+            for (auto* setting : settings) {
+                juce::AudioBuffer<float> buffer(2, blockSize);
+                NoiseAudioSource noise;
+                juce::AudioSourceChannelInfo info(&buffer, 0, blockSize);
+
+                std::vector<std::unique_ptr<DeckEQ>> decks;
+                for (int i = 0; i < DeckMixer::maxDecks; ++i) {
+                    decks.push_back(std::make_unique<DeckEQ>());
+                    decks.back()->prepare(benchSampleRate);
+
+                    if (juce::String(setting) != "neutral") {
+                        decks.back()->setBandGain(DeckEQ::Band::low, 0.0f);
+                        decks.back()->setBandGain(DeckEQ::Band::mid, 1.4f);
+                        decks.back()->setBandGain(DeckEQ::Band::high, 0.5f);
+                        decks.back()->setTrim(0.8f);
+                        decks.back()->setFilter(-0.4f);
+                    }
+                }
+
+                // About 20 seconds of audio per case
+                const int numBlocks = juce::jmax(200, (int)(benchSampleRate * 20.0) / blockSize);
+                double totalSeconds = 0.0;
+
+                for (int block = 0; block < numBlocks; ++block) {
+                    noise.getNextAudioBlock(info);
+
+                    if (juce::String(setting) == "sweep")
+                        for (auto& deck : decks)
+                            deck->setFilter((float)std::sin(block * 0.01));
+
+                    const auto start = juce::Time::getHighResolutionTicks();
+                    for (auto& deck : decks)
+                        deck->process(buffer.getWritePointer(0), buffer.getWritePointer(1), blockSize);
+                    totalSeconds += juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+                }
+
+                const double allDecksMicros = totalSeconds / numBlocks * 1.0e6;
+                const double deckMicros = allDecksMicros / DeckMixer::maxDecks;
+                const double corePercent = 100.0 * allDecksMicros / (blockSize / benchSampleRate * 1.0e6);
+
+                std::cout << juce::String(blockSize).paddedLeft(' ', 5)
+                    << "  " << juce::String(setting).paddedRight(' ', 8)
+                    << juce::String(deckMicros, 2).paddedLeft(' ', 10)
+                    << juce::String(allDecksMicros, 2).paddedLeft(' ', 14)
+                    << juce::String(corePercent, 2).paddedLeft(' ', 8)
+                    << std::endl;
+
+                report.add({ "eq", { { "block", blockSize }, { "settings", setting }, { "decks", DeckMixer::maxDecks } },
+                    { { "deck_us", deckMicros }, { "all_decks_us", allDecksMicros }, { "core_pct", corePercent } } });
+            }
+        }
+    }
+
+    // Made-up words from random syllables, so the library benchmark has names with realistic trigram spread
+    juce::String makeWord(juce::Random& random) {
+        const char* syllables[] = { "ka", "lo", "mi", "ra", "ven", "tor", "su", "el", "da", "ne", "bri", "xo",
+                                    "qua", "ze", "fin", "gal", "ho", "jun", "pe", "wy", "sta", "mor", "ti", "u" };
+        juce::String word;
+        const int numSyllables = 1 + random.nextInt(3);
+
+        for (int i = 0; i < numSyllables; ++i)
+            word << syllables[random.nextInt((int)std::size(syllables))];
+
+        return word;
+    }
+
+    // Time to build the search index over a 50k-track library, and per-query times of the searches the
+    // library panel runs on every keystroke, which should stay well under a millisecond
+    void benchmarkLibrary(BenchmarkReport& report) {
+        const int numTracks = 50000;
+        const int numArtists = 4000;
+        const int numRuns = 2000;
+        const int maxResults = 500;  // As many as the library panel lists
+
+        std::cout << "MusicLibrary search, " << numTracks << " tracks, " << maxResults << " results at most" << std::endl;
+
+        juce::Random random(99);
+        std::vector<juce::String> artists;
+        for (int i = 0; i < numArtists; ++i)
+            artists.push_back(makeWord(random) + (random.nextBool() ? " " + makeWord(random) : juce::String()));
+
+        std::vector<MusicLibrary::Track> tracks((size_t)numTracks);
+        for (int i = 0; i < numTracks; ++i) {
+            auto& track = tracks[(size_t)i];
+            track.artist = artists[(size_t)random.nextInt(numArtists)];
+            track.title = makeWord(random) + " " + makeWord(random) + (random.nextInt(8) == 0 ? " (Remix)" : "");
+            track.album = makeWord(random);
+            track.path = "/Music/" + track.artist + "/" + track.album + "/" + juce::String(i % 20 + 1).paddedLeft('0', 2)
+                + " " + track.title + ".flac";
+            track.lengthSeconds = 120.0f + (float)random.nextInt(300);
+        }
+
+        const auto buildStart = juce::Time::getHighResolutionTicks();
+        const MusicLibrary::Index index(std::move(tracks));
+        const double buildMs = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - buildStart) * 1000.0;
+
+        std::cout << "index built in " << juce::String(buildMs, 1) << " ms" << std::endl;
+        std::cout << "query            results   mean us    p99 us" << std::endl;
+        report.add({ "library", { { "tracks", numTracks }, { "query", "(build)" } }, { { "build_ms", buildMs } } });
+
+        const char* queries[] = { "", "k", "ka", "kal", "remix", "tor su", "mi ven remix", "zzzz", "b", "quaxo" };
+
+        for (auto* query : queries) {
+            std::vector<double> micros((size_t)numRuns);
+            size_t numResults = 0;
+
+            for (int run = 0; run < numRuns; ++run) {
+                const auto start = juce::Time::getHighResolutionTicks();
+                numResults = index.search(query, maxResults).size();
+                micros[(size_t)run] = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start) * 1.0e6;
+            }
+
+            std::sort(micros.begin(), micros.end());
+            double mean = 0.0;
+            for (auto value : micros)
+                mean += value;
+            mean /= numRuns;
+            const double p99 = micros[(size_t)(numRuns * 99 / 100)];
+
+            std::cout << ("\"" + juce::String(query) + "\"").paddedRight(' ', 16)
+                << juce::String((int)numResults).paddedLeft(' ', 8)
+                << juce::String(mean, 1).paddedLeft(' ', 10)
+                << juce::String(p99, 1).paddedLeft(' ', 10)
+                << std::endl;
+
+            report.add({ "library", { { "tracks", numTracks }, { "query", query } },
+                { { "results", (int)numResults }, { "mean_us", mean }, { "p99_us", p99 } } });
+        }
+    }
+
+    // Loudness and true-peak measurement fed the decode pass's blocks straight from memory, at the
+    // track's own level and 12 dB down, which should read 12 LU quieter
+    void benchmarkLoudness(BenchmarkReport& report, const juce::AudioBuffer<float>& track, double sampleRate) {
+        std::cout << "LoudnessAnalyser, stereo, " << sampleRate << " Hz, " << TrackDecoder::blockSize << "-sample blocks" << std::endl;
+        std::cout << "gain dB     LUFS  peak dBTP   mean ms  audio s/s" << std::endl;
+
+        const double trackSeconds = track.getNumSamples() / sampleRate;
+        const int numRuns = 5;
+
+        for (auto gainDb : { 0.0f, -12.0f }) {
+            juce::AudioBuffer<float> scaled(track);
+            scaled.applyGain(juce::Decibels::decibelsToGain(gainDb));
+
+            juce::AudioBuffer<float> block(scaled.getNumChannels(), TrackDecoder::blockSize);
+            TrackLoudness loudness;
+            double totalSeconds = 0.0;
+
+            for (int run = 0; run < numRuns; ++run) {
+                LoudnessAnalyser analyser;
+
+                const auto start = juce::Time::getHighResolutionTicks();
+                analyser.decodeStarted(scaled.getNumChannels(), sampleRate, scaled.getNumSamples());
+
+                for (int position = 0; position < scaled.getNumSamples(); position += TrackDecoder::blockSize) {
+                    const int numSamples = juce::jmin(TrackDecoder::blockSize, scaled.getNumSamples() - position);
+                    for (int channel = 0; channel < scaled.getNumChannels(); ++channel)
+                        block.copyFrom(channel, 0, scaled, channel, position, numSamples);
+
+                    analyser.decodeBlock(block, position, numSamples);
+                }
+
+                loudness = analyser.getResult();
+                const auto end = juce::Time::getHighResolutionTicks();
+                totalSeconds += juce::Time::highResolutionTicksToSeconds(end - start);
+            }
+
+            const double meanSeconds = totalSeconds / numRuns;
+
+            std::cout << juce::String(gainDb, 1).paddedLeft(' ', 7)
+                << juce::String(loudness.integratedLufs, 2).paddedLeft(' ', 9)
+                << juce::String(loudness.truePeakDb, 2).paddedLeft(' ', 11)
+                << juce::String(meanSeconds * 1000.0, 1).paddedLeft(' ', 10)
+                << juce::String(trackSeconds / meanSeconds, 0).paddedLeft(' ', 11)
+                << std::endl;
+
+            report.add({ "loudness", { { "gain_db", gainDb } },
+                { { "lufs", loudness.integratedLufs }, { "true_peak_db", loudness.truePeakDb },
+                  { "mean_ms", meanSeconds * 1000.0 }, { "audio_s_per_s", trackSeconds / meanSeconds } } });
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    // The load and paint benchmarks need the message loop and the graphics classes
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::StringArray arguments;
+    for (int i = 1; i < argc; ++i)
+        arguments.add(argv[i]);
+
+    auto option = [&arguments](const char* name) {
+        const int index = arguments.indexOf(name);
+        return index >= 0 ? arguments[index + 1] : juce::String();
+    };
+
+    const auto only = juce::StringArray::fromTokens(option("--only"), ",", {});
+    auto shouldRun = [&only](const char* name) { return only.isEmpty() || only.contains(name); };
+
+    BenchmarkReport report;
+
+    // One minute of 44.1 kHz music-like audio, shared by the deck, load and waveform benchmarks
+    const double trackSampleRate = 44100.0;
+    const double trackSeconds = 60.0;
+    const auto track = makeKickTrack(trackSampleRate, 128.0, trackSeconds);
+    juce::WavAudioFormat wavFormat;
+    const auto wavTrack = writeTrackFile(wavFormat, track, trackSampleRate);
+
+    const std::pair<const char*, std::function<void()>> benchmarks[] = {
+        { "timestretch", [&] { benchmarkTimeStretch(report); } },
+        { "resampler",   [&] { benchmarkResampler(report); } },
+        { "eq",          [&] { benchmarkEQ(report); } },
+        { "player",      [&] { benchmarkPlayer(report, wavTrack->getFile()); } },
+        { "mixer",       [&] { benchmarkMixer(report, wavTrack->getFile()); } },
+        { "load",        [&] { benchmarkLoad(report, track, trackSampleRate); } },
+        { "thumbnail",   [&] { benchmarkThumbnail(report, wavTrack->getFile(), trackSeconds); } },
+        { "paint",       [&] { benchmarkPaint(report, wavTrack->getFile()); } },
+        { "beats",       [&] { benchmarkBeatAnalysis(report); } },
+        { "library",     [&] { benchmarkLibrary(report); } },
+        { "loudness",    [&] { benchmarkLoudness(report, track, trackSampleRate); } }
+    };
+
+    for (auto& benchmark : benchmarks) {
+        if (shouldRun(benchmark.first)) {
+            benchmark.second();
+            std::cout << std::endl;
+        }
+    }
+
+    const std::pair<const char*, BenchmarkReport::Format> outputs[] = {
+        { "--json", BenchmarkReport::Format::json },
+        { "--csv", BenchmarkReport::Format::csv },
+    };
+
+    for (auto& output : outputs) {
+        const auto path = option(output.first);
+        if (path.isEmpty())
+            continue;
+
+        const auto written = report.writeTo(juce::File::getCurrentWorkingDirectory().getChildFile(path), output.second);
+        if (written.failed()) {
+            std::cerr << written.getErrorMessage() << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,89 @@
+/*
+  ==============================================================================
+
+    BenchmarkReport.cpp
+    Created: 17 Oct 2026 8:15:37pm
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#include "BenchmarkReport.h"
+
+// Constructor for BenchmarkReport
+BenchmarkReport::BenchmarkReport() {
+    machine.set("date", juce::Time::getCurrentTime().toISO8601(true));
+    machine.set("version", ProjectInfo::versionString);
+    machine.set("juce", juce::SystemStats::getJUCEVersion());
+    machine.set("os", juce::SystemStats::getOperatingSystemName());
+    machine.set("cpu", juce::SystemStats::getCpuModel());
+    machine.set("cpus", juce::SystemStats::getNumCpus());
+   #if JUCE_DEBUG
+    machine.set("build", "debug");
+   #else
+    machine.set("build", "release");
+   #endif
+}
+
+void BenchmarkReport::add(BenchmarkResult result) {
+    results.push_back(std::move(result));
+}
+
+juce::String BenchmarkReport::toJSON() const {
+    auto toObject = [](const juce::NamedValueSet& values) {
+        auto* object = new juce::DynamicObject();
+        for (auto& value : values)
+            object->setProperty(value.name, value.value);
+        return juce::var(object);
+    };
+
+    juce::Array<juce::var> resultArray;
+    for (auto& result : results) {
+        auto* object = new juce::DynamicObject();
+        object->setProperty("benchmark", result.benchmark);
+        object->setProperty("params", toObject(result.params));
+        object->setProperty("metrics", toObject(result.metrics));
+        resultArray.add(juce::var(object));
+    }
+
+    auto report = toObject(machine);
+    report.getDynamicObject()->setProperty("results", resultArray);
+    return juce::JSON::toString(report);
+}
+
+juce::String BenchmarkReport::toCSV() const {
+    juce::String csv = "benchmark,params,metric,value\n";
+
+    for (auto& result : results) {
+        const auto params = formatParams(result.params);
+        for (auto& metric : result.metrics)
+            csv << escapeCSV(result.benchmark) << "," << escapeCSV(params) << "," << escapeCSV(metric.name.toString()) << ","
+                << juce::String((double)metric.value, 4) << "\n";
+    }
+
+    return csv;
+}
+
+juce::Result BenchmarkReport::writeTo(const juce::File& file, Format format) const {
+    const auto text = format == Format::csv ? toCSV() : toJSON();
+
+    if (!file.replaceWithText(text))
+        return juce::Result::fail("cannot write " + file.getFullPathName());
+
+    return juce::Result::ok();
+}
+
+juce::String BenchmarkReport::formatParams(const juce::NamedValueSet& params) {
+    juce::StringArray pairs;
+    for (auto& param : params)
+        pairs.add(param.name.toString() + "=" + param.value.toString());
+
+    return pairs.joinIntoString(";");
+}
+
+juce::String BenchmarkReport::escapeCSV(const juce::String& field) {
+    if (!field.containsAnyOf(",\"\r\n"))
+        return field;
+
+    return "\"" + field.replace("\"", "\"\"") + "\"";
+}
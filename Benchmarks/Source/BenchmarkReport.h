@@ -0,0 +1,55 @@
+/*
+  ==============================================================================
+
+    BenchmarkReport.h
+    Created: 17 Oct 2026 8:15:37pm
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// One measured case: the benchmark it belongs to, the parameters that identify it
+// (e.g. block=256, ratio=1.25) and the numbers it produced (e.g. mean_us=12.5)
+struct BenchmarkResult {
+    juce::String benchmark;
+    juce::NamedValueSet params;
+    juce::NamedValueSet metrics;
+};
+
+// BenchmarkReport class
+// Collects the results of a run and writes them as JSON or CSV, so runs of different
+// releases can be compared by a script rather than by eye
+class BenchmarkReport {
+public:
+    // Output formats for writeTo
+    enum class Format { json, csv };
+
+    // Records the machine and build the results come from
+    BenchmarkReport();
+
+    // Adds a measured case
+    void add(BenchmarkResult result);
+
+    // Whole report as one JSON object: machine details plus a "results" array
+    juce::String toJSON() const;
+
+    // Long-format CSV, one row per metric: benchmark,params,metric,value
+    juce::String toCSV() const;
+
+    // Writes the report in the given format, whatever the file is called
+    juce::Result writeTo(const juce::File& file, Format format) const;
+
+private:
+    // "key=value;key=value" in insertion order, used as the CSV case identifier
+    static juce::String formatParams(const juce::NamedValueSet& params);
+
+    // Quotes a CSV field holding a comma, quote or line break, doubling any quotes inside it
+    static juce::String escapeCSV(const juce::String& field);
+
+    juce::NamedValueSet machine;
+    std::vector<BenchmarkResult> results;
+};
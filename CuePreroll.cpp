@@ -0,0 +1,271 @@
+/*
+  ==============================================================================
+
+    CuePreroll.cpp
+    Created: 17 Oct 2026 10:41:05pm
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#include "CuePreroll.h"
+
+// Constructor for CuePrerollCache
+CuePrerollCache::CuePrerollCache(ReaderFactory readerFactory)
+    : juce::Thread("Cue pre-roll"), createReader(std::move(readerFactory)) {
+    startThread(juce::Thread::Priority::low);
+}
+
+// Destructor for CuePrerollCache
+CuePrerollCache::~CuePrerollCache() {
+    stopThread(4000);
+}
+
+void CuePrerollCache::setTrack(const juce::URL& audioURL, int generation) {
+    {
+        const juce::ScopedLock lock(requestLock);
+        requestedURL = audioURL;
+        requestedGeneration = generation;
+    }
+
+    notify();
+}
+
+void CuePrerollCache::setCuePoints(const std::vector<double>& positionsInSeconds) {
+    {
+        const juce::ScopedLock lock(requestLock);
+        requestedCues = positionsInSeconds;
+    }
+
+    notify();
+}
+
+// Claims a ready slot before looking at it, so the fill thread can't be rewriting it meanwhile
+const CuePrerollCache::Slot* CuePrerollCache::borrow(int trackGeneration, juce::int64 cueSample) noexcept {
+    for (int i = 0; i < numSlots; ++i) {
+        int expected = ready;
+        if (!slotStates[(size_t)i].compare_exchange_strong(expected, borrowed, std::memory_order_acquire))
+            continue;
+
+        const auto& slot = slots[(size_t)i];
+        if (slot.trackGeneration == trackGeneration && slot.cueSample == cueSample)
+            return &slot;
+
+        slotStates[(size_t)i].store(ready, std::memory_order_release);
+    }
+
+    return nullptr;
+}
+
+void CuePrerollCache::giveBack(const Slot* slot) noexcept {
+    const auto index = (size_t)(slot - slots.data());
+    jassert(index < slots.size());
+    slotStates[index].store(ready, std::memory_order_release);
+}
+
+// Sleeps until the track or the cue points change, then brings the slots up to date
+void CuePrerollCache::run() {
+    while (!threadShouldExit()) {
+        fillMissingSlots();
+        wait(-1);
+    }
+}
+
+void CuePrerollCache::fillMissingSlots() {
+    juce::URL audioURL;
+    int generation = 0;
+    std::vector<double> cues;
+
+    {
+        const juce::ScopedLock lock(requestLock);
+        audioURL = requestedURL;
+        generation = requestedGeneration;
+        cues = requestedCues;
+    }
+
+    if (audioURL.isEmpty())
+        return;
+
+    if (readerGeneration != generation) {
+        reader = createReader(audioURL);
+        readerGeneration = generation;
+
+        if (reader == nullptr)
+            juce::Logger::outputDebugString("CuePrerollCache could not open " + audioURL.toString(false) + "\n");
+    }
+
+    if (reader == nullptr)
+        return;
+
+    // The cue points set most recently are the ones kept in RAM
+    std::vector<juce::int64> wantedCues;
+    for (size_t i = cues.size() > (size_t)numSlots ? cues.size() - (size_t)numSlots : 0; i < cues.size(); ++i) {
+        const auto cueSample = (juce::int64)(cues[i] * reader->sampleRate);
+        if (cueSample >= 0 && cueSample < reader->lengthInSamples)
+            wantedCues.push_back(cueSample);
+    }
+
+    if (pool.getNumSamples() == 0 && !wantedCues.empty()) {
+        pool.setSize(2, numSlots * slotFrames);
+
+        for (int i = 0; i < numSlots; ++i) {
+            slots[(size_t)i].channels[0] = pool.getReadPointer(0, i * slotFrames);
+            slots[(size_t)i].channels[1] = pool.getReadPointer(1, i * slotFrames);
+        }
+    }
+
+    for (auto cueSample : wantedCues) {
+        if (threadShouldExit())
+            return;
+
+        // Only this thread writes a slot's fields, so it can read them in any state
+        const bool alreadyFilled = std::any_of(slots.begin(), slots.end(), [&](const Slot& slot)
+            {
+                const int state = slotStates[(size_t)(&slot - slots.data())].load();
+                return (state == ready || state == borrowed) && slot.trackGeneration == generation && slot.cueSample == cueSample;
+            });
+
+        if (alreadyFilled)
+            continue;
+
+        const int index = claimSlot(generation, wantedCues);
+        if (index < 0)
+            return;
+
+        auto& slot = slots[(size_t)index];
+        slot.trackGeneration = generation;
+        slot.cueSample = cueSample;
+        slot.numFrames = (int)juce::jmin((juce::int64)slotFrames, reader->lengthInSamples - cueSample);
+
+        // A mono reader is copied to both channels
+        reader->read(&pool, index * slotFrames, slot.numFrames, cueSample, true, true);
+
+        slotStates[(size_t)index].store(ready, std::memory_order_release);
+    }
+}
+
+// Takes an empty slot, or one holding audio that is no longer wanted
+int CuePrerollCache::claimSlot(int generation, const std::vector<juce::int64>& wantedCues) {
+    for (int i = 0; i < numSlots; ++i) {
+        auto& state = slotStates[(size_t)i];
+        const auto& slot = slots[(size_t)i];
+        int expected = state.load();
+
+        const bool stale = expected == ready && (slot.trackGeneration != generation
+            || std::find(wantedCues.begin(), wantedCues.end(), slot.cueSample) == wantedCues.end());
+
+        if ((expected == empty || stale) && state.compare_exchange_strong(expected, filling))
+            return i;
+    }
+
+    return -1;
+}
+
+// Constructor for CuePrerollSource
+CuePrerollSource::CuePrerollSource(juce::AudioTransportSource& transportToRead, CuePrerollCache& prerollCache)
+    : transport(transportToRead), cache(prerollCache) {
+
+}
+
+// Destructor for CuePrerollSource
+CuePrerollSource::~CuePrerollSource() {
+    cancelJump();
+}
+
+// The transport is seeked to where the slot's crossfade starts, giving its read-ahead the whole
+// length of the slot to catch up
+bool CuePrerollSource::jumpToCue(int trackGeneration, juce::int64 cueSample) {
+    cancelJump();
+
+    slot = cache.borrow(trackGeneration, cueSample);
+    if (slot == nullptr)
+        return false;
+
+    slotPosition = 0;
+    transport.setNextReadPosition(cueSample + juce::jmax(0, slot->numFrames - crossfadeFrames));
+    return true;
+}
+
+void CuePrerollSource::cancelJump() {
+    if (slot != nullptr) {
+        cache.giveBack(slot);
+        slot = nullptr;
+    }
+}
+
+void CuePrerollSource::prepareToPlay(int samplesPerBlockExpected, double sampleRate) {
+    transport.prepareToPlay(samplesPerBlockExpected, sampleRate);
+}
+
+void CuePrerollSource::releaseResources() {
+    transport.releaseResources();
+}
+
+void CuePrerollSource::getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill) {
+    if (slot == nullptr) {
+        transport.getNextAudioBlock(bufferToFill);
+        return;
+    }
+
+    // A stopped deck stays where it is in the slot, silent, as the transport would
+    if (!transport.isPlaying()) {
+        bufferToFill.clearActiveBufferRegion();
+        return;
+    }
+
+    auto* buffer = bufferToFill.buffer;
+    const int numChannels = buffer->getNumChannels();
+    const int handover = juce::jmax(0, slot->numFrames - crossfadeFrames);
+
+    // Up to the handover the block comes from the slot alone
+    const int numFromSlot = juce::jlimit(0, bufferToFill.numSamples, handover - slotPosition);
+    for (int channel = 0; channel < numChannels; ++channel)
+        buffer->copyFrom(channel, bufferToFill.startSample, slot->channels[juce::jmin(channel, 1)] + slotPosition, numFromSlot);
+
+    slotPosition += numFromSlot;
+    if (numFromSlot == bufferToFill.numSamples)
+        return;
+
+    // The rest comes from the transport, which starts reading exactly at the handover
+    const juce::AudioSourceChannelInfo rest(buffer, bufferToFill.startSample + numFromSlot, bufferToFill.numSamples - numFromSlot);
+    transport.getNextAudioBlock(rest);
+
+    // Both carry the same audio, so a linear crossfade keeps the level steady across the seam
+    const int fadeLength = slot->numFrames - handover;
+    const int numFading = juce::jmin(rest.numSamples, slot->numFrames - slotPosition);
+
+    for (int channel = 0; channel < numChannels; ++channel) {
+        auto* out = buffer->getWritePointer(channel, rest.startSample);
+        const float* fromSlot = slot->channels[juce::jmin(channel, 1)] + slotPosition;
+
+        for (int i = 0; i < numFading; ++i) {
+            const float transportWeight = (float)(slotPosition - handover + i + 1) / (float)(fadeLength + 1);
+            out[i] = fromSlot[i] + transportWeight * (out[i] - fromSlot[i]);
+        }
+    }
+
+    slotPosition += numFading;
+    if (slotPosition >= slot->numFrames)
+        cancelJump();
+}
+
+void CuePrerollSource::setNextReadPosition(juce::int64 newPosition) {
+    cancelJump();
+    transport.setNextReadPosition(newPosition);
+}
+
+// Before the handover the transport is parked at the end of the slot, so the position is counted from the cue
+juce::int64 CuePrerollSource::getNextReadPosition() const {
+    if (slot != nullptr && slotPosition < slot->numFrames - crossfadeFrames)
+        return slot->cueSample + slotPosition;
+
+    return transport.getNextReadPosition();
+}
+
+juce::int64 CuePrerollSource::getTotalLength() const {
+    return transport.getTotalLength();
+}
+
+bool CuePrerollSource::isLooping() const {
+    return false;
+}
@@ -0,0 +1,136 @@
+/*
+  ==============================================================================
+
+    CuePreroll.h
+    Created: 17 Oct 2026 10:41:05pm
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// Keeps the first few seconds of audio after each of a deck's cue points decoded in RAM, so a cue
+// jump can start playing straight away instead of waiting for the streaming reader to seek.
+//
+// The audio lives in one pooled buffer of fixed-size slots, allocated once. A background thread
+// fills the slots with a reader of its own; the audio thread borrows a ready slot for the length
+// of a jump. Each slot's state is an atomic that hands ownership between the two threads, so the
+// audio thread never waits or allocates.
+class CuePrerollCache : private juce::Thread {
+public:
+    // Slots in the pool; cue points beyond this many (the oldest first) are jumped to by seeking
+    static constexpr int numSlots = 8;
+
+    // Frames per slot, about three seconds at 44.1 kHz
+    static constexpr int slotFrames = 1 << 17;
+
+    // The decoded audio at one cue point. Its fields only change while the fill thread owns it.
+    struct Slot {
+        int trackGeneration = 0;
+        juce::int64 cueSample = 0;  // At the file's sample rate
+        int numFrames = 0;  // Fewer than slotFrames near the end of the track
+        const float* channels[2]{};
+    };
+
+    // Opens a reader over a track, or returns nullptr
+    using ReaderFactory = std::function<std::unique_ptr<juce::AudioFormatReader>(const juce::URL&)>;
+
+    // Constructor: the fill thread opens its readers with createReader
+    explicit CuePrerollCache(ReaderFactory createReader);
+
+    // Destructor: stops the fill thread
+    ~CuePrerollCache() override;
+
+    // Sets the track the cue points refer to; generation identifies it to borrow() (any thread but the audio thread)
+    void setTrack(const juce::URL& audioURL, int generation);
+
+    // Sets the cue points to keep decoded, in seconds (any thread but the audio thread)
+    void setCuePoints(const std::vector<double>& positionsInSeconds);
+
+    // Borrows the ready slot for a cue point, or returns nullptr if there isn't one (audio thread only)
+    const Slot* borrow(int trackGeneration, juce::int64 cueSample) noexcept;
+
+    // Hands a borrowed slot back (audio thread only)
+    void giveBack(const Slot* slot) noexcept;
+
+private:
+    enum SlotState { empty, filling, ready, borrowed };
+
+    // Decodes the audio of every wanted cue point that has no ready slot (fill thread)
+    void run() override;
+    void fillMissingSlots();
+
+    // Claims a slot the wanted cue points don't need, or returns -1 if all are in use (fill thread)
+    int claimSlot(int generation, const std::vector<juce::int64>& wantedCues);
+
+    const ReaderFactory createReader;
+
+    // Requested track and cue points, shared between the message and loader threads and the fill thread
+    juce::CriticalSection requestLock;
+    juce::URL requestedURL;
+    int requestedGeneration = 0;
+    std::vector<double> requestedCues;
+
+    // Reader for the fill thread, reopened when the track changes
+    std::unique_ptr<juce::AudioFormatReader> reader;
+    int readerGeneration = -1;
+
+    // One region of the pool per slot, allocated by the fill thread the first time it is needed
+    juce::AudioBuffer<float> pool;
+    std::array<Slot, numSlots> slots;
+    std::array<std::atomic<int>, numSlots> slotStates{};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CuePrerollCache)
+};
+
+// Sits between a deck's transport and its resampler. A cue jump plays from the borrowed slot while
+// the transport, already seeked to the end of the slot, refills its read-ahead in the background;
+// the seam between the two is crossfaded. Every other read passes straight through to the transport.
+class CuePrerollSource : public juce::PositionableAudioSource {
+public:
+    // Constructor: both must outlive the source
+    CuePrerollSource(juce::AudioTransportSource& transport, CuePrerollCache& cache);
+
+    // Destructor: hands back any borrowed slot
+    ~CuePrerollSource() override;
+
+    // Jumps to a cue point, starting from its slot. Returns false, leaving the position to the caller,
+    // if the cue point's audio isn't ready (audio thread only)
+    bool jumpToCue(int trackGeneration, juce::int64 cueSample);
+
+    // Abandons a jump in progress, e.g. when a new track has been swapped in (audio thread only)
+    void cancelJump();
+
+    // Prepares the transport
+    void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
+
+    // Releases the transport's resources
+    void releaseResources() override;
+
+    // Plays from the slot, the crossfade or the transport, whichever the position is in
+    void getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill) override;
+
+    // Seeks the transport, abandoning any jump in progress
+    void setNextReadPosition(juce::int64 newPosition) override;
+
+    // Position at the file's sample rate, counting the samples played from a slot
+    juce::int64 getNextReadPosition() const override;
+
+    juce::int64 getTotalLength() const override;
+    bool isLooping() const override;
+
+    // Frames over which a slot hands over to the transport
+    static constexpr int crossfadeFrames = 512;
+
+private:
+    juce::AudioTransportSource& transport;
+    CuePrerollCache& cache;
+
+    // The slot being played and how far into it, or nullptr once the transport has taken over
+    const CuePrerollCache::Slot* slot = nullptr;
+    int slotPosition = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CuePrerollSource)
+};
@@ -0,0 +1,41 @@
+/*
+  ==============================================================================
+
+    DeckCommandQueue.cpp
+    Created: 17 Oct 2026 10:12:40am
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#include "DeckCommandQueue.h"
+
+// Constructor for DeckCommandQueue
+DeckCommandQueue::DeckCommandQueue(int capacity)
+    : fifo(capacity), commands((size_t)capacity) {
+
+}
+
+// Copies the command into the next free slot of the ring
+bool DeckCommandQueue::push(const DeckCommand& command) {
+    if (fifo.getFreeSpace() < 1)
+        return false;
+
+    fifo.write(1).forEach([this, &command](int index) {
+        commands[(size_t)index] = command;
+    });
+    return true;
+}
+
+// Builds and queues a command of the given type and value
+bool DeckCommandQueue::push(DeckCommand::Type type, double value) {
+    DeckCommand command;
+    command.type = type;
+    command.value = value;
+    return push(command);
+}
+
+// Returns the number of commands waiting to be drained
+int DeckCommandQueue::getNumPending() const {
+    return fifo.getNumReady();
+}
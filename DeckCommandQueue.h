@@ -0,0 +1,86 @@
+/*
+  ==============================================================================
+
+    DeckCommandQueue.h
+    Created: 17 Oct 2026 10:12:40am
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// A single parameter change or transport action sent to a deck's audio thread
+struct DeckCommand {
+    enum class Type {
+        setGain,
+        setSpeed,
+        setKeylock,
+        setResamplerQuality,
+        setPosition,
+        setPositionRelative,
+        jumpToCue,
+        setLoopIn,
+        setLoopOut,
+        startLoop,
+        halveLoop,
+        doubleLoop,
+        exitLoop,
+        setEqLow,
+        setEqMid,
+        setEqHigh,
+        setFilter,
+        setTrim,
+        start,
+        stop,
+        togglePlayback,
+        playNext,
+        setAutoTrim,
+        setAutoTrimEnabled
+    };
+
+    Type type = Type::stop;
+    double value = 0.0;
+
+    // High-resolution time a MIDI controller sent the command, 0 for commands from the UI
+    juce::int64 sentTicks = 0;
+
+    // Load generation of the track the command is for, where it matters (setAutoTrim)
+    int track = 0;
+};
+
+// Wait-free single-producer/single-consumer ring of DeckCommands.
+// One thread pushes (e.g. the message thread), the audio thread drains it at the top of each block.
+class DeckCommandQueue {
+public:
+
+    // Constructor: capacity is the number of commands that can be pending at once
+    explicit DeckCommandQueue(int capacity = 1024);
+
+    // Queues a command, returns false if the ring is full (producer thread only)
+    bool push(const DeckCommand& command);
+
+    // Queues a command of the given type and value (producer thread only)
+    bool push(DeckCommand::Type type, double value = 0.0);
+
+    // Calls apply for every pending command in the order they were pushed (consumer thread only)
+    template <typename ApplyFunction>
+    void drain(ApplyFunction&& apply) {
+        fifo.read(fifo.getNumReady()).forEach([this, &apply](int index) {
+            apply(commands[(size_t)index]);
+        });
+    }
+
+    // Returns the number of commands waiting to be drained
+    int getNumPending() const;
+
+private:
+    // Index bookkeeping for the ring (lock-free)
+    juce::AbstractFifo fifo;
+
+    // Storage for the ring, allocated once up front
+    std::vector<DeckCommand> commands;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DeckCommandQueue)
+};
@@ -0,0 +1,274 @@
+/*
+  ==============================================================================
+
+    DeckEQ.cpp
+    Created: 17 Oct 2026 10:02:18pm
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#include "DeckEQ.h"
+#include "VectorOps.h"
+
+namespace {
+    // Butterworth stages; two in series make a Linkwitz-Riley crossover
+    constexpr double crossoverQ = 0.7071067811865476;
+
+    // Slightly resonant, as DJ mixer filters usually are
+    constexpr double filterQ = 0.9;
+
+    // Cutoff travel of the filter from the centre of the knob to either end
+    constexpr double lowPassOpenHz = 20000.0, lowPassClosedHz = 60.0;
+    constexpr double highPassOpenHz = 20.0, highPassClosedHz = 8000.0;
+
+    // The filter is off within the dead zone and fades in over the next stretch of travel
+    constexpr float filterDeadZone = 0.02f;
+    constexpr float filterFadeRange = 0.1f;
+
+    constexpr double gainSmoothingSeconds = 0.01;
+    constexpr double filterSmoothingSeconds = 0.03;
+
+    // The filter's coefficients are recomputed this often while its knob moves
+    constexpr int subBlockSize = 16;
+
+    // Four-lane helpers over whichever instruction set VectorOps found
+    using namespace VectorOps::lanes;
+}
+
+// Constructor for DeckEQ
+DeckEQ::DeckEQ() {
+    prepare(sampleRate);
+}
+
+// Designs the crossovers for the sample rate and resets all state
+void DeckEQ::prepare(double newSampleRate) {
+    sampleRate = newSampleRate > 0.0 ? newSampleRate : 44100.0;
+
+    for (int stage = 0; stage < 2; ++stage) {
+        for (int channel = 0; channel < 2; ++channel) {
+            lowCrossover[stage].setLowPass(channel, lowCrossoverHz, crossoverQ, sampleRate);
+            lowCrossover[stage].setHighPass(channel + 2, lowCrossoverHz, crossoverQ, sampleRate);
+            highCrossover[stage].setLowPass(channel, highCrossoverHz, crossoverQ, sampleRate);
+            highCrossover[stage].setHighPass(channel + 2, highCrossoverHz, crossoverQ, sampleRate);
+        }
+    }
+
+    // A Linkwitz-Riley pair sums to a second-order all-pass at its crossover frequency
+    for (int lane = 0; lane < 4; ++lane)
+        lowAllPass.setAllPass(lane, highCrossoverHz, crossoverQ, sampleRate);
+
+    gainTimeConstantSamples = (float)(gainSmoothingSeconds * sampleRate);
+    filterSmoothing = (float)(1.0 - std::exp(-subBlockSize / (filterSmoothingSeconds * sampleRate)));
+
+    updateFilterCoefficients(currentFilter);
+    reset();
+}
+
+void DeckEQ::reset() noexcept {
+    for (int stage = 0; stage < 2; ++stage) {
+        lowCrossover[stage].clearState();
+        highCrossover[stage].clearState();
+    }
+
+    lowAllPass.clearState();
+    filter.clearState();
+}
+
+void DeckEQ::setBandGain(Band band, float gain) noexcept {
+    targetGains[(int)band] = juce::jlimit(0.0f, maxGain, gain);
+}
+
+void DeckEQ::setFilter(float position) noexcept {
+    targetFilter = juce::jlimit(-1.0f, 1.0f, position);
+}
+
+void DeckEQ::setTrim(float gain) noexcept {
+    targetTrim = juce::jlimit(0.0f, maxGain, gain);
+}
+
+// Runs the crossovers, band gains, filter and trim over the block, one stereo sample per pass
+void DeckEQ::process(float* left, float* right, int numSamples) noexcept {
+    if (numSamples <= 0)
+        return;
+
+    // At neutral settings the chain would only shift the phase, so it blends out and is then skipped
+    const bool neutral = targetTrim == 1.0f && currentTrim == 1.0f && targetFilter == 0.0f && currentFilter == 0.0f
+        && std::all_of(std::begin(targetGains), std::end(targetGains), [](float gain) { return gain == 1.0f; })
+        && std::all_of(std::begin(currentGains), std::end(currentGains), [](float gain) { return gain == 1.0f; });
+
+    const float endMix = neutral ? 0.0f : 1.0f;
+    if (endMix == 0.0f && currentMix == 0.0f)
+        return;
+
+    juce::ScopedNoDenormals noDenormals;
+
+    // Gains move a block's worth towards their targets, ramping linearly within the block
+    const float blockSmoothing = 1.0f - std::exp(-(float)numSamples / gainTimeConstantSamples);
+    float endGains[3];
+    for (int band = 0; band < 3; ++band)
+        endGains[band] = currentGains[band] + (targetGains[band] - currentGains[band]) * blockSmoothing;
+    float endTrim = currentTrim + (targetTrim - currentTrim) * blockSmoothing;
+
+    // Snap once close enough, so a deck returned to neutral can go back to being skipped
+    for (int band = 0; band < 3; ++band)
+        if (std::abs(endGains[band] - targetGains[band]) < 1.0e-4f)
+            endGains[band] = targetGains[band];
+    if (std::abs(endTrim - targetTrim) < 1.0e-4f)
+        endTrim = targetTrim;
+
+    const float inverseNum = 1.0f / (float)numSamples;
+    Lanes lowGain = splat(currentGains[0]);
+    const Lanes lowGainStep = splat((endGains[0] - currentGains[0]) * inverseNum);
+    Lanes midHighGain = set(currentGains[1], currentGains[1], currentGains[2], currentGains[2]);
+    const float midStep = (endGains[1] - currentGains[1]) * inverseNum;
+    const float highStep = (endGains[2] - currentGains[2]) * inverseNum;
+    const Lanes midHighGainStep = set(midStep, midStep, highStep, highStep);
+    Lanes trim = splat(currentTrim);
+    const Lanes trimStep = splat((endTrim - currentTrim) * inverseNum);
+    Lanes mix = splat(currentMix);
+    const Lanes mixStep = splat((endMix - currentMix) * inverseNum);
+
+    for (int start = 0; start < numSamples; start += subBlockSize) {
+        const int num = juce::jmin(subBlockSize, numSamples - start);
+
+        // The filter knob is smoothed per sub-block, with fresh coefficients whenever it moves
+        const float startWet = getFilterWet(currentFilter);
+        if (currentFilter != targetFilter) {
+            currentFilter += (targetFilter - currentFilter) * filterSmoothing;
+            if (std::abs(currentFilter - targetFilter) < 1.0e-4f)
+                currentFilter = targetFilter;
+
+            updateFilterCoefficients(currentFilter);
+        }
+
+        const float endWet = getFilterWet(currentFilter);
+        const bool filtering = startWet > 0.0f || endWet > 0.0f;
+        if (!filtering)
+            filter.clearState();  // Passing through the dead zone, e.g. between low-pass and high-pass
+
+        Lanes wet = splat(startWet);
+        const Lanes wetStep = splat((endWet - startWet) / (float)num);
+
+        BiquadRegisters low0(lowCrossover[0]), low1(lowCrossover[1]);
+        BiquadRegisters high0(highCrossover[0]), high1(highCrossover[1]);
+        BiquadRegisters allPass(lowAllPass), filterStage(filter);
+
+        for (int i = start; i < start + num; ++i) {
+            const float l = left[i];
+            const float r = right != nullptr ? right[i] : l;
+            const Lanes x = set(l, r, l, r);
+
+            // Lanes: low band left and right, then everything above it
+            const Lanes lowSplit = low1.process(low0.process(x));
+
+            // Lanes: mid band left and right, high band left and right
+            const Lanes highSplit = high1.process(high0.process(upperHalves(lowSplit)));
+
+            // Lanes 0 and 1 hold the sum of the three bands, each at its own gain
+            const Lanes lowBand = allPass.process(lowSplit);
+            Lanes wetSignal = add(mul(lowGain, lowBand), foldHalves(mul(midHighGain, highSplit)));
+
+            if (filtering) {
+                const Lanes filtered = filterStage.process(wetSignal);
+                wetSignal = add(wetSignal, mul(wet, sub(filtered, wetSignal)));
+                wet = add(wet, wetStep);
+            }
+
+            wetSignal = mul(wetSignal, trim);
+            const Lanes out = add(x, mul(mix, sub(wetSignal, x)));
+
+            left[i] = lane0(out);
+            if (right != nullptr)
+                right[i] = lane1(out);
+
+            lowGain = add(lowGain, lowGainStep);
+            midHighGain = add(midHighGain, midHighGainStep);
+            trim = add(trim, trimStep);
+            mix = add(mix, mixStep);
+        }
+
+        low0.saveState(lowCrossover[0]);
+        low1.saveState(lowCrossover[1]);
+        high0.saveState(highCrossover[0]);
+        high1.saveState(highCrossover[1]);
+        allPass.saveState(lowAllPass);
+        if (filtering)
+            filterStage.saveState(filter);
+    }
+
+    std::copy(std::begin(endGains), std::end(endGains), std::begin(currentGains));
+    currentTrim = endTrim;
+    currentMix = endMix;
+
+    // Fully blended out: start from silence next time the chain switches in
+    if (currentMix == 0.0f)
+        reset();
+}
+
+void DeckEQ::updateFilterCoefficients(float position) noexcept {
+    const double amount = std::abs((double)position);
+
+    // Exponential sweeps, so equal knob travel moves the cutoff by equal musical intervals
+    if (position < 0.0f) {
+        const double frequency = lowPassOpenHz * std::pow(lowPassClosedHz / lowPassOpenHz, amount);
+        filter.setLowPass(0, frequency, filterQ, sampleRate);
+        filter.setLowPass(1, frequency, filterQ, sampleRate);
+    } else {
+        const double frequency = highPassOpenHz * std::pow(highPassClosedHz / highPassOpenHz, amount);
+        filter.setHighPass(0, frequency, filterQ, sampleRate);
+        filter.setHighPass(1, frequency, filterQ, sampleRate);
+    }
+}
+
+float DeckEQ::getFilterWet(float position) noexcept {
+    return juce::jlimit(0.0f, 1.0f, (std::abs(position) - filterDeadZone) / filterFadeRange);
+}
+
+//==============================================================================
+// RBJ cookbook low-pass, normalised so a0 is 1
+void DeckEQ::BiquadLanes::setLowPass(int lane, double frequency, double q, double rate) noexcept {
+    const double w0 = juce::MathConstants<double>::twoPi * juce::jmin(frequency, rate * 0.45) / rate;
+    const double cosW0 = std::cos(w0);
+    const double alpha = std::sin(w0) / (2.0 * q);
+    const double a0 = 1.0 + alpha;
+
+    b0[lane] = (float)((1.0 - cosW0) * 0.5 / a0);
+    b1[lane] = (float)((1.0 - cosW0) / a0);
+    b2[lane] = b0[lane];
+    a1[lane] = (float)(-2.0 * cosW0 / a0);
+    a2[lane] = (float)((1.0 - alpha) / a0);
+}
+
+// RBJ cookbook high-pass, normalised so a0 is 1
+void DeckEQ::BiquadLanes::setHighPass(int lane, double frequency, double q, double rate) noexcept {
+    const double w0 = juce::MathConstants<double>::twoPi * juce::jmin(frequency, rate * 0.45) / rate;
+    const double cosW0 = std::cos(w0);
+    const double alpha = std::sin(w0) / (2.0 * q);
+    const double a0 = 1.0 + alpha;
+
+    b0[lane] = (float)((1.0 + cosW0) * 0.5 / a0);
+    b1[lane] = (float)(-(1.0 + cosW0) / a0);
+    b2[lane] = b0[lane];
+    a1[lane] = (float)(-2.0 * cosW0 / a0);
+    a2[lane] = (float)((1.0 - alpha) / a0);
+}
+
+// RBJ cookbook all-pass, normalised so a0 is 1
+void DeckEQ::BiquadLanes::setAllPass(int lane, double frequency, double q, double rate) noexcept {
+    const double w0 = juce::MathConstants<double>::twoPi * juce::jmin(frequency, rate * 0.45) / rate;
+    const double cosW0 = std::cos(w0);
+    const double alpha = std::sin(w0) / (2.0 * q);
+    const double a0 = 1.0 + alpha;
+
+    b0[lane] = (float)((1.0 - alpha) / a0);
+    b1[lane] = (float)(-2.0 * cosW0 / a0);
+    b2[lane] = 1.0f;
+    a1[lane] = b1[lane];
+    a2[lane] = b0[lane];
+}
+
+void DeckEQ::BiquadLanes::clearState() noexcept {
+    std::fill(std::begin(s1), std::end(s1), 0.0f);
+    std::fill(std::begin(s2), std::end(s2), 0.0f);
+}
@@ -0,0 +1,99 @@
+/*
+  ==============================================================================
+
+    DeckEQ.h
+    Created: 17 Oct 2026 10:02:18pm
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// DeckEQ class
+// A deck's processing chain after the resampler: a 3-band kill EQ, a sweepable low-pass/high-pass filter
+// and a trim gain. The EQ splits the signal into bands with Linkwitz-Riley crossovers, so any band can be
+// killed outright and the bands sum back flat. The low-pass and high-pass halves of each crossover run
+// for both channels side by side as one four-lane SIMD biquad. Parameter changes are smoothed, and nothing
+// allocates or locks once prepared. A deck left at its neutral settings costs nothing.
+class DeckEQ {
+public:
+    enum class Band { low, mid, high };
+
+    // Crossover frequencies between the bands
+    static constexpr double lowCrossoverHz = 250.0;
+    static constexpr double highCrossoverHz = 2500.0;
+
+    // Band and trim gains go from 0 (a band is killed) to this
+    static constexpr float maxGain = 2.0f;
+
+    // Constructor
+    DeckEQ();
+
+    // Sets the sample rate and clears the filters
+    void prepare(double sampleRate);
+
+    // Clears the filter state, e.g. after a seek
+    void reset() noexcept;
+
+    // Sets a band's gain: 0 kills it, 1 leaves it unchanged (audio thread only)
+    void setBandGain(Band band, float gain) noexcept;
+
+    // Sets the filter from -1 (low-pass fully closed) through 0 (off) to 1 (high-pass fully closed) (audio thread only)
+    void setFilter(float position) noexcept;
+
+    // Sets the gain applied after the EQ and filter (audio thread only)
+    void setTrim(float gain) noexcept;
+
+    // Processes one block in place; right may be null for a mono deck (audio thread only)
+    void process(float* left, float* right, int numSamples) noexcept;
+
+private:
+    // Coefficients and state of four biquads run side by side, one per SIMD lane
+    struct BiquadLanes {
+        alignas(16) float b0[4]{}, b1[4]{}, b2[4]{}, a1[4]{}, a2[4]{};
+        alignas(16) float s1[4]{}, s2[4]{};
+
+        void setLowPass(int lane, double frequency, double q, double sampleRate) noexcept;
+        void setHighPass(int lane, double frequency, double q, double sampleRate) noexcept;
+        void setAllPass(int lane, double frequency, double q, double sampleRate) noexcept;
+        void clearState() noexcept;
+    };
+
+    // Sets the filter coefficients for a knob position
+    void updateFilterCoefficients(float position) noexcept;
+
+    // How far the filter is mixed in at a knob position; 0 in the dead zone around the centre
+    static float getFilterWet(float position) noexcept;
+
+    double sampleRate = 44100.0;
+
+    // Each crossover is two cascaded Butterworth stages whose lanes hold low-pass left, low-pass right,
+    // high-pass left and high-pass right. The low crossover splits off the low band, the high crossover
+    // splits the rest into mid and high
+    BiquadLanes lowCrossover[2], highCrossover[2];
+
+    // Gives the low band the high crossover's phase response, so the three bands sum flat (lanes 0 and 1)
+    BiquadLanes lowAllPass;
+
+    // Sweepable filter on lanes 0 (left) and 1 (right)
+    BiquadLanes filter;
+
+    // Targets set by the deck's commands, and the smoothed values the last block ended on
+    float targetGains[3] = { 1.0f, 1.0f, 1.0f };
+    float currentGains[3] = { 1.0f, 1.0f, 1.0f };
+    float targetTrim = 1.0f, currentTrim = 1.0f;
+    float targetFilter = 0.0f, currentFilter = 0.0f;
+
+    // Gain smoothing time in samples, and the filter's smoothing factor per sub-block
+    float gainTimeConstantSamples = 441.0f;
+    float filterSmoothing = 1.0f;
+
+    // Blend from the dry input to the chain's output; it moves over one block when the chain switches
+    // in or out, so the crossovers' phase shift never clicks
+    float currentMix = 0.0f;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DeckEQ)
+};
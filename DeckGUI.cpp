@@ -1,290 +1,628 @@
-/*
-  ==============================================================================
-
-    DeckGUI.cpp
-    Created: 14 Feb 2025 3:50:28pm
-    Author: LAPTOP WORLD
-
-  ==============================================================================
-*/
-
-#include <JuceHeader.h>
-#include "DeckGUI.h"
-
-//==============================================================================
-DeckGUI::DeckGUI(DJAudioPlayer* _Player,
-    juce::AudioFormatManager& formatManagerToUse,
-    juce::AudioThumbnailCache& cacheToUse)
-    : player(_Player), waveDisplay(formatManagerToUse, cacheToUse)
-{
-    // Add and make visible all components
-    addAndMakeVisible(playButton);
-    addAndMakeVisible(stopButton);
-    addAndMakeVisible(loadButton);
-    addAndMakeVisible(volSlider);
-    addAndMakeVisible(speedSlider);
-    addAndMakeVisible(positionSlider);
-    addAndMakeVisible(waveDisplay);
-    addAndMakeVisible(setCueButton);
-    addAndMakeVisible(jumpCueButton);
-
-    // Button listeners
-    playButton.addListener(this);
-    stopButton.addListener(this);
-    loadButton.addListener(this);
-    setCueButton.addListener(this);
-    jumpCueButton.addListener(this);
-
-    // Slider listeners
-    volSlider.addListener(this);
-    speedSlider.addListener(this);
-    positionSlider.addListener(this);
-
-    // Slider ranges
-    volSlider.setRange(0, 1);
-    speedSlider.setRange(0, 2);
-    positionSlider.setRange(0, 1);
-
-    // Slider styles - Knob type
-    volSlider.setSliderStyle(juce::Slider::Rotary);
-    speedSlider.setSliderStyle(juce::Slider::Rotary);
-    positionSlider.setSliderStyle(juce::Slider::Rotary);
-
-    volSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, 60, 20);
-    speedSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, 60, 20);
-    positionSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, 60, 20);
-
-    // Updated Neon Slider Colors
-    volSlider.setColour(juce::Slider::thumbColourId, juce::Colour::fromRGB(0, 153, 255));
-    speedSlider.setColour(juce::Slider::thumbColourId, juce::Colour::fromRGB(255, 32, 78));
-    positionSlider.setColour(juce::Slider::thumbColourId, juce::Colour::fromRGB(255, 215, 0));
-
-
-
-
-    // Add and make visible labels for sliders
-    addAndMakeVisible(volLabel);
-    addAndMakeVisible(speedLabel);
-    addAndMakeVisible(positionLabel);
-
-    // Set labels for sliders with soft white and subtle glow
-    volLabel.setText("Volume", juce::dontSendNotification);
-    volLabel.setColour(juce::Label::textColourId, juce::Colour::fromRGB(230, 230, 250));  // Soft White
-
-    speedLabel.setText("Speed", juce::dontSendNotification);
-    speedLabel.setColour(juce::Label::textColourId, juce::Colour::fromRGB(230, 230, 250));  // Soft White
-
-    positionLabel.setText("Position", juce::dontSendNotification);
-    positionLabel.setColour(juce::Label::textColourId, juce::Colour::fromRGB(230, 230, 250));  // Soft White
-
-
-    // Button styling example
-    playButton.setColour(juce::TextButton::buttonColourId, juce::Colour(0xff0099ff)); // Blue
-    stopButton.setColour(juce::TextButton::buttonColourId, juce::Colour::fromRGB(255, 32, 78)); // Red
-    loadButton.setColour(juce::TextButton::buttonColourId, juce::Colour::fromRGB(32, 199, 255)); // Cyan
-    setCueButton.setColour(juce::TextButton::buttonColourId, juce::Colour::fromRGB(255, 215, 0)); // Yellow
-    jumpCueButton.setColour(juce::TextButton::buttonColourId, juce::Colour::fromRGB(211, 68, 255)); // Purple
-
-    // Start timer for GUI animations at 30 frames per second
-    startTimerHz(30);
-
-
-}
-
-DeckGUI::~DeckGUI() {}
-
-void DeckGUI::paint(juce::Graphics& g)
-{
-    // Background gradient
-    juce::ColourGradient backgroundGradient(
-        juce::Colour(20, 20, 40), 0.0f, 0.0f,
-        juce::Colour(2, 2, 10), 0.0f, static_cast<float>(getHeight()), false);
-    g.setGradientFill(backgroundGradient);
-    g.fillAll();
-
-    // Border
-    g.setColour(juce::Colours::darkgrey);
-    g.drawRoundedRectangle(getLocalBounds().toFloat().reduced(3.0f), 8.0f, 2.0f);
-
-    // Animated Logo explicitly positioned safely
-    float alphaLogo = 0.6f + 0.4f * std::sin(juce::Time::getMillisecondCounterHiRes() * 0.003f);
-    g.setColour(juce::Colours::white.withAlpha(alphaLogo));
-    g.setFont(juce::Font("Arial Black", 18.0f, juce::Font::bold));
-    g.drawText("Otodecks DJ PRO",
-        0.0f,
-        5.0f,
-        static_cast<float>(getWidth()),
-        30.0f,
-        juce::Justification::centred);
-
-    // Defensive and safe calculation for relativePosition
-    float relativePosition = waveDisplay.getPositionRelative();
-
-    // Debugging: Print relative position to console to ensure it's updating
-    DBG("Relative Position: " << relativePosition);
-
-    // Safety Check to ensure range [0,1]
-    if (relativePosition < 0.0f || relativePosition > 1.0f || std::isnan(relativePosition))
-        relativePosition = 0.0f;
-
-    drawProgressBar(g, relativePosition);
-
-    // Defensive check for beat indicator (prevent negative positions)
-    double pos = player->getPosition();
-
-    // Debugging: Print player position to console to ensure it's updating
-    DBG("Player Position: " << pos);
-
-    if (pos < 0.0)
-        pos = 0.0;  // Ensure no negative positions
-
-    bool isBeat = (pos > 0.0) && (static_cast<int>(pos * 4) % 2 == 0);
-    drawBeatIndicator(g, isBeat);
-}
-
-
-void DeckGUI::resized()
-{
-    auto padding = 8;
-    auto buttonHeight = 30;
-    int sliderSize = (getWidth() - 4 * padding) / 3;
-
-    // Play and Stop buttons slightly lower to show logo clearly
-    playButton.setBounds(padding, 40, getWidth() / 2 - 1.5 * padding, buttonHeight);
-    stopButton.setBounds(getWidth() / 2 + padding / 2, 40, getWidth() / 2 - 1.5 * padding, buttonHeight);
-
-    // Waveform Display (adjusted)
-    waveDisplay.setBounds(padding, playButton.getBottom() + padding, getWidth() - 2 * padding, getHeight() / 3);
-
-    // Sliders positioned just below waveform
-    int sliderY = waveDisplay.getBottom() + padding;
-    volSlider.setBounds(padding, sliderY, sliderSize, sliderSize);
-    speedSlider.setBounds(volSlider.getRight() + padding, sliderY, sliderSize, sliderSize);
-    positionSlider.setBounds(speedSlider.getRight() + padding, sliderY, sliderSize, sliderSize);
-
-    // Slider labels below each slider
-    volLabel.setBounds(volSlider.getX(), volSlider.getBottom(), sliderSize, 20);
-    speedLabel.setBounds(speedSlider.getX(), speedSlider.getBottom(), sliderSize, 20);
-    positionLabel.setBounds(positionSlider.getX(), positionSlider.getBottom(), sliderSize, 20);
-
-    // Cue buttons positioned closer to sliders to reduce gap
-    setCueButton.setBounds(padding, volLabel.getBottom() + padding, getWidth() / 2 - 1.5 * padding, buttonHeight);
-    jumpCueButton.setBounds(setCueButton.getRight() + padding, volLabel.getBottom() + padding, getWidth() / 2 - 1.5 * padding, buttonHeight);
-
-    // Load button positioned closer to cue buttons to remove large gap
-    loadButton.setBounds(padding, setCueButton.getBottom() + padding, getWidth() - 2 * padding, buttonHeight);
-}
-
-
-void DeckGUI::buttonClicked(juce::Button* button)
-{
-    if (button == &playButton)
-    {
-        juce::Logger::outputDebugString("Play Button Was Clicked!");
-        player->start();
-    }
-    if (button == &stopButton)
-    {
-        juce::Logger::outputDebugString("Stop Button Was Clicked!");
-        player->stop();
-    }
-
-    if (button == &loadButton) {
-        juce::Logger::outputDebugString("Load Button was Clicked");
-
-        auto filechooserFlags = juce::FileBrowserComponent::canSelectFiles;
-        fChooser.launchAsync(filechooserFlags, [this](const juce::FileChooser& chooser)
-            {
-                juce::File chosenFile = chooser.getResult();
-                player->LoadURL(juce::URL{ chosenFile });
-                waveDisplay.loadURL(juce::URL{ chosenFile });
-            });
-    }
-
-    if (button == &setCueButton) {
-        double currentPosition = player->getPosition();
-        if (currentPosition > 0) {
-            auto& cuePoints = waveDisplay.getCuePoints();
-            if (std::find(cuePoints.begin(), cuePoints.end(), currentPosition) == cuePoints.end()) {
-                waveDisplay.addCuePoint(currentPosition);
-            }
-        }
-    }
-
-    if (button == &jumpCueButton && !waveDisplay.getCuePoints().empty()) {
-        auto& cuePoints = waveDisplay.getCuePoints();
-        int cueIndex = waveDisplay.getCurrentCueIndex();
-        cueIndex = (cueIndex + 1) % cuePoints.size();
-        waveDisplay.setCurrentCueIndex(cueIndex);
-        waveDisplay.repaint();
-        player->setPosition(cuePoints[cueIndex]);
-    }
-}
-
-void DeckGUI::sliderValueChanged(juce::Slider* slider)
-{
-    if (slider == &volSlider) player->setGain(slider->getValue());
-    if (slider == &speedSlider) player->setspeed(slider->getValue());
-    if (slider == &positionSlider) player->setPositionRelative(slider->getValue());
-}
-
-bool DeckGUI::isInterestedInFileDrag(const juce::StringArray& files) { return true; }
-
-void DeckGUI::filesDropped(const juce::StringArray& files, int x, int y)
-{
-    if (files.size() == 1) player->LoadURL(juce::URL{ juce::File{files[0]} });
-}
-
-void DeckGUI::timerCallback()
-{
-    // Get the current position in seconds from the player
-    double currentPos = player->getPosition();
-    double trackLength = player->getLengthInSeconds();
-
-    // Update WaveFormDisplay's position relative to track length
-    if (trackLength > 0)
-        waveDisplay.setPositionRelative(currentPos / trackLength);
-
-    repaint();  // Redraw the GUI
-}
-
-
-// Draw Beat Indicator (Small Pulsing circle synced to beats)
-void DeckGUI::drawBeatIndicator(juce::Graphics& g, bool isBeat)
-{
-    float radius = 8.f;
-    auto indicatorPos = juce::Point<float>(getWidth() - 20.f, 20.f);
-    g.setColour(isBeat ? juce::Colours::lime : juce::Colours::grey);
-    g.fillEllipse(indicatorPos.x - radius, indicatorPos.y - radius, radius * 2.f, radius * 2.f);
-}
-
-void DeckGUI::drawProgressBar(juce::Graphics& g, float progress)
-{
-    // Get the updated position relative to the track length
-    progress = waveDisplay.getPositionRelative();  // Ensure it uses the latest value
-
-    // Clamp progress explicitly between 0 and 1
-    progress = juce::jlimit(0.0f, 1.0f, progress);
-
-    int barWidth = getWidth() - 20;
-    int yPos = waveDisplay.getBottom() + 8;
-
-    // Debug: Check progress value
-    DBG("Progress Bar Position: " << progress);
-
-    // Background
-    g.setColour(juce::Colours::darkgrey);
-    g.fillRoundedRectangle(10.0f, static_cast<float>(yPos), static_cast<float>(barWidth), 5.0f, 2.0f);
-
-    // Progress Indicator
-    g.setColour(juce::Colours::cyan);
-    g.fillRoundedRectangle(10.0f, static_cast<float>(yPos), barWidth * progress, 5.0f, 2.5f);
-}
-
-
-void DeckGUI::drawAnimatedLogo(juce::Graphics& g, float alphaValue)
-{
-    g.setColour(juce::Colours::white.withAlpha(alphaValue));
-    g.setFont(juce::Font("Arial Black", 20.f, juce::Font::bold));
-    g.drawText("Otodecks DJ PRO", getLocalBounds().removeFromTop(30), juce::Justification::centred);
-}
+/*
+  ==============================================================================
+
+    DeckGUI.cpp
+    Created: 14 Feb 2025 3:50:28pm
+    Author: LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "DeckGUI.h"
+
+//==============================================================================
+DeckGUI::DeckGUI(DJAudioPlayer* _Player,
+    juce::AudioFormatManager& formatManagerToUse,
+    juce::AudioThumbnailCache& cacheToUse)
+    : player(_Player), waveDisplay(formatManagerToUse, cacheToUse),
+      queuedThumbnail(WaveFormDisplay::thumbnailResolution, formatManagerToUse, cacheToUse)
+{
+    // Add and make visible all components
+    addAndMakeVisible(playButton);
+    addAndMakeVisible(stopButton);
+    addAndMakeVisible(loadButton);
+    addAndMakeVisible(queueButton);
+    addAndMakeVisible(nextButton);
+    addAndMakeVisible(volSlider);
+    addAndMakeVisible(speedSlider);
+    addAndMakeVisible(positionSlider);
+    addAndMakeVisible(waveDisplay);
+    addAndMakeVisible(zoomedDisplay);
+    addAndMakeVisible(setCueButton);
+    addAndMakeVisible(jumpCueButton);
+    addAndMakeVisible(keylockButton);
+
+    for (auto* button : { &loopInButton, &loopOutButton, &beatLoopButton, &halveLoopButton, &doubleLoopButton })
+    {
+        button->setColour(juce::TextButton::buttonColourId, juce::Colour::fromRGB(40, 40, 60));  // Dark Slate
+        button->setColour(juce::TextButton::buttonOnColourId, juce::Colour::fromRGB(57, 255, 20));  // Neon Green
+        button->setColour(juce::TextButton::textColourOnId, juce::Colours::black);
+        button->addListener(this);
+        addAndMakeVisible(button);
+    }
+
+    // Button listeners
+    playButton.addListener(this);
+    stopButton.addListener(this);
+    loadButton.addListener(this);
+    queueButton.addListener(this);
+    nextButton.addListener(this);
+    setCueButton.addListener(this);
+    jumpCueButton.addListener(this);
+    keylockButton.addListener(this);
+    autoGainButton.addListener(this);
+
+    // Slider listeners
+    volSlider.addListener(this);
+    speedSlider.addListener(this);
+    positionSlider.addListener(this);
+
+    // Component IDs let automation such as the soak test find the controls
+    playButton.setComponentID("play");
+    stopButton.setComponentID("stop");
+    loadButton.setComponentID("load");
+    queueButton.setComponentID("queue");
+    nextButton.setComponentID("next");
+    setCueButton.setComponentID("setCue");
+    jumpCueButton.setComponentID("jumpCue");
+    keylockButton.setComponentID("keylock");
+    autoGainButton.setComponentID("autoGain");
+    loopInButton.setComponentID("loopIn");
+    loopOutButton.setComponentID("loopOut");
+    beatLoopButton.setComponentID("beatLoop");
+    halveLoopButton.setComponentID("halveLoop");
+    doubleLoopButton.setComponentID("doubleLoop");
+    volSlider.setComponentID("volume");
+    speedSlider.setComponentID("speed");
+    positionSlider.setComponentID("position");
+
+    // Slider ranges
+    volSlider.setRange(0, 1);
+    speedSlider.setRange(0, 2);
+    positionSlider.setRange(0, 1);
+
+    // Slider styles - Knob type
+    volSlider.setSliderStyle(juce::Slider::Rotary);
+    speedSlider.setSliderStyle(juce::Slider::Rotary);
+    positionSlider.setSliderStyle(juce::Slider::Rotary);
+
+    volSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, 60, 20);
+    speedSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, 60, 20);
+    positionSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, 60, 20);
+
+    // Updated Neon Slider Colors
+    volSlider.setColour(juce::Slider::thumbColourId, juce::Colour::fromRGB(0, 153, 255));
+    speedSlider.setColour(juce::Slider::thumbColourId, juce::Colour::fromRGB(255, 32, 78));
+    positionSlider.setColour(juce::Slider::thumbColourId, juce::Colour::fromRGB(255, 215, 0));
+
+
+
+
+    // Add and make visible labels for sliders
+    addAndMakeVisible(volLabel);
+    addAndMakeVisible(speedLabel);
+    addAndMakeVisible(positionLabel);
+
+    // Set labels for sliders with soft white and subtle glow
+    volLabel.setText("Volume", juce::dontSendNotification);
+    volLabel.setColour(juce::Label::textColourId, juce::Colour::fromRGB(230, 230, 250));  // Soft White
+
+    speedLabel.setText("Speed", juce::dontSendNotification);
+    speedLabel.setColour(juce::Label::textColourId, juce::Colour::fromRGB(230, 230, 250));  // Soft White
+
+    positionLabel.setText("Position", juce::dontSendNotification);
+    positionLabel.setColour(juce::Label::textColourId, juce::Colour::fromRGB(230, 230, 250));  // Soft White
+
+
+    // EQ and trim knobs: the centre leaves the sound unchanged and fully left kills the band.
+    // The filter is off in the centre, low-pass to the left and high-pass to the right.
+    // Double-clicking a knob returns it to the centre.
+    for (auto* knob : { &lowKnob, &midKnob, &highKnob, &trimKnob })
+    {
+        knob->setRange(0.0, DeckEQ::maxGain);
+        knob->setSkewFactorFromMidPoint(1.0);
+        knob->setValue(1.0, juce::dontSendNotification);
+        knob->setDoubleClickReturnValue(true, 1.0);
+    }
+
+    filterKnob.setRange(-1.0, 1.0);
+    filterKnob.setValue(0.0, juce::dontSendNotification);
+    filterKnob.setDoubleClickReturnValue(true, 0.0);
+
+    lowKnob.setComponentID("eqLow");
+    midKnob.setComponentID("eqMid");
+    highKnob.setComponentID("eqHigh");
+    filterKnob.setComponentID("filter");
+    trimKnob.setComponentID("trim");
+
+    for (auto* knob : { &lowKnob, &midKnob, &highKnob, &filterKnob, &trimKnob })
+    {
+        knob->setColour(juce::Slider::thumbColourId, juce::Colour::fromRGB(32, 199, 255));
+        knob->addListener(this);
+        addAndMakeVisible(knob);
+    }
+
+    for (auto* label : { &lowLabel, &midLabel, &highLabel, &filterLabel, &trimLabel, &autoGainLabel })
+    {
+        label->setJustificationType(juce::Justification::centred);
+        label->setFont(juce::Font(12.0f));
+        label->setColour(juce::Label::textColourId, juce::Colour::fromRGB(230, 230, 250));  // Soft White
+        addAndMakeVisible(label);
+    }
+
+    // Button styling example
+    playButton.setColour(juce::TextButton::buttonColourId, juce::Colour(0xff0099ff)); // Blue
+    stopButton.setColour(juce::TextButton::buttonColourId, juce::Colour::fromRGB(255, 32, 78)); // Red
+    loadButton.setColour(juce::TextButton::buttonColourId, juce::Colour::fromRGB(32, 199, 255)); // Cyan
+    queueButton.setColour(juce::TextButton::buttonColourId, juce::Colour::fromRGB(40, 40, 60)); // Dark Slate
+    nextButton.setColour(juce::TextButton::buttonColourId, juce::Colour::fromRGB(40, 40, 60)); // Dark Slate
+    setCueButton.setColour(juce::TextButton::buttonColourId, juce::Colour::fromRGB(255, 215, 0)); // Yellow
+    jumpCueButton.setColour(juce::TextButton::buttonColourId, juce::Colour::fromRGB(211, 68, 255)); // Purple
+    keylockButton.setColour(juce::ToggleButton::textColourId, juce::Colour::fromRGB(230, 230, 250)); // Soft White
+    keylockButton.setColour(juce::ToggleButton::tickColourId, juce::Colour::fromRGB(0, 153, 255)); // Blue
+
+    // The player normalises loudness from the start, so the toggle starts on to match
+    autoGainButton.setToggleState(true, juce::dontSendNotification);
+    autoGainButton.setColour(juce::ToggleButton::textColourId, juce::Colour::fromRGB(230, 230, 250)); // Soft White
+    autoGainButton.setColour(juce::ToggleButton::tickColourId, juce::Colour::fromRGB(0, 153, 255)); // Blue
+    addAndMakeVisible(autoGainButton);
+
+    // Get notified on the message thread when a background load completes
+    player->onLoadComplete = [this](bool loaded) { trackLoaded(loaded); };
+
+    // Queued tracks are analysed into the off-screen waveforms, and the deck's own follow when one takes over
+    player->setQueueConsumers({ &queuedThumbnailFiller, &queuedSpectrum, &queuedWaveformPyramid });
+    player->onQueueAdvance = [this](const juce::URL&) { queuedTrackStarted(); };
+
+    // Start timer for GUI animations at 30 frames per second
+    startTimerHz(30);
+
+
+}
+
+DeckGUI::~DeckGUI()
+{
+    player->onLoadComplete = nullptr;
+    player->onQueueAdvance = nullptr;
+
+    // The decode passes may still be filling the waveforms, which go away with this deck
+    player->stopDecodePass();
+    player->setQueueConsumers({});
+}
+
+void DeckGUI::paint(juce::Graphics& g)
+{
+    paintStartMs = juce::Time::getMillisecondCounterHiRes();
+
+    // Background gradient and border, drawn once per resize
+    g.drawImageAt(backgroundLayer, 0, 0);
+
+    // Animated Logo: only its transparency changes, so blend the cached text in
+    float alphaLogo = 0.6f + 0.4f * std::sin(juce::Time::getMillisecondCounterHiRes() * 0.003f);
+    g.setOpacity(alphaLogo);
+    g.drawImageAt(logoLayer, 0, getLogoBounds().getY());
+    g.setOpacity(1.0f);
+
+    // Defensive and safe calculation for relativePosition
+    float relativePosition = static_cast<float>(snapshot.getPositionRelative());
+
+    // Safety Check to ensure range [0,1]
+    if (relativePosition < 0.0f || relativePosition > 1.0f || std::isnan(relativePosition))
+        relativePosition = 0.0f;
+
+    drawProgressBar(g, relativePosition);
+
+    drawBeatIndicator(g, isBeat);
+    drawTempo(g);
+    drawFrameTime(g);
+}
+
+void DeckGUI::paintOverChildren(juce::Graphics& g)
+{
+    juce::ignoreUnused(g);
+
+    // The children (waveforms, sliders, labels) have been drawn by now, so this is the whole frame
+    paintTimeTotalMs += juce::Time::getMillisecondCounterHiRes() - paintStartMs;
+    ++paintCount;
+}
+
+void DeckGUI::renderStaticLayers()
+{
+    int width = juce::jmax(1, getWidth());
+    int height = juce::jmax(1, getHeight());
+
+    backgroundLayer = juce::Image(juce::Image::ARGB, width, height, true);
+    {
+        juce::Graphics g(backgroundLayer);
+
+        // Background gradient
+        juce::ColourGradient backgroundGradient(
+            juce::Colour(20, 20, 40), 0.0f, 0.0f,
+            juce::Colour(2, 2, 10), 0.0f, static_cast<float>(height), false);
+        g.setGradientFill(backgroundGradient);
+        g.fillAll();
+
+        // Border
+        g.setColour(juce::Colours::darkgrey);
+        g.drawRoundedRectangle(getLocalBounds().toFloat().reduced(3.0f), 8.0f, 2.0f);
+    }
+
+    auto logoBounds = getLogoBounds();
+    logoLayer = juce::Image(juce::Image::ARGB, width, logoBounds.getHeight(), true);
+    {
+        juce::Graphics g(logoLayer);
+        g.setColour(juce::Colours::white);
+        g.setFont(juce::Font("Arial Black", 18.0f, juce::Font::bold));
+        g.drawText("Otodecks DJ PRO", 0, 0, width, logoBounds.getHeight(), juce::Justification::centred);
+    }
+}
+
+juce::Rectangle<int> DeckGUI::getLogoBounds() const
+{
+    return { 0, 5, getWidth(), 30 };
+}
+
+juce::Rectangle<int> DeckGUI::getProgressBarBounds() const
+{
+    return { 10, waveDisplay.getBottom() + 8, getWidth() - 20, 5 };
+}
+
+juce::Rectangle<int> DeckGUI::getBeatIndicatorBounds() const
+{
+    return { getWidth() - 110, 10, 110, 20 };
+}
+
+juce::Rectangle<int> DeckGUI::getFrameTimeBounds() const
+{
+    return { 12, 10, 100, 20 };
+}
+
+
+void DeckGUI::resized()
+{
+    auto padding = 8;
+    auto buttonHeight = 30;
+    int sliderSize = (getWidth() - 4 * padding) / 3;
+
+    // Play and Stop buttons slightly lower to show logo clearly
+    playButton.setBounds(padding, 40, getWidth() / 2 - 1.5 * padding, buttonHeight);
+    stopButton.setBounds(getWidth() / 2 + padding / 2, 40, getWidth() / 2 - 1.5 * padding, buttonHeight);
+
+    // Waveform area: scrolling close-up on top, whole-track overview below it
+    int waveformHeight = getHeight() / 3;
+    int zoomedHeight = waveformHeight * 3 / 5;
+    zoomedDisplay.setBounds(padding, playButton.getBottom() + padding, getWidth() - 2 * padding, zoomedHeight);
+    waveDisplay.setBounds(padding, zoomedDisplay.getBottom() + 2, getWidth() - 2 * padding, waveformHeight - zoomedHeight - 2);
+
+    // Sliders positioned just below waveform
+    int sliderY = waveDisplay.getBottom() + padding;
+    volSlider.setBounds(padding, sliderY, sliderSize, sliderSize);
+    speedSlider.setBounds(volSlider.getRight() + padding, sliderY, sliderSize, sliderSize);
+    positionSlider.setBounds(speedSlider.getRight() + padding, sliderY, sliderSize, sliderSize);
+
+    // Slider labels below each slider
+    volLabel.setBounds(volSlider.getX(), volSlider.getBottom(), sliderSize, 20);
+    speedLabel.setBounds(speedSlider.getX(), speedSlider.getBottom(), sliderSize, 20);
+    positionLabel.setBounds(positionSlider.getX(), positionSlider.getBottom(), sliderSize, 20);
+
+    // Cue buttons positioned closer to sliders to reduce gap, loop in and out beside them
+    int cueRowWidth = (getWidth() - 5 * padding) / 4;
+    setCueButton.setBounds(padding, volLabel.getBottom() + padding, cueRowWidth, buttonHeight);
+    jumpCueButton.setBounds(setCueButton.getRight() + padding, setCueButton.getY(), cueRowWidth, buttonHeight);
+    loopInButton.setBounds(jumpCueButton.getRight() + padding, setCueButton.getY(), cueRowWidth, buttonHeight);
+    loopOutButton.setBounds(loopInButton.getRight() + padding, setCueButton.getY(), cueRowWidth, buttonHeight);
+
+    // Load button positioned closer to cue buttons to remove large gap, beat loop controls and keylock toggle beside it
+    int keylockWidth = 100;
+    int beatLoopWidth = 60;
+    int loopSizeWidth = 36;
+    // Load takes half of what is left, queue and next a quarter each
+    int trackButtonsWidth = getWidth() - 8 * padding - keylockWidth - beatLoopWidth - 2 * loopSizeWidth;
+    loadButton.setBounds(padding, setCueButton.getBottom() + padding, trackButtonsWidth / 2, buttonHeight);
+    queueButton.setBounds(loadButton.getRight() + padding, loadButton.getY(), trackButtonsWidth / 4, buttonHeight);
+    nextButton.setBounds(queueButton.getRight() + padding, loadButton.getY(), trackButtonsWidth / 4, buttonHeight);
+    beatLoopButton.setBounds(nextButton.getRight() + padding, loadButton.getY(), beatLoopWidth, buttonHeight);
+    halveLoopButton.setBounds(beatLoopButton.getRight() + padding, loadButton.getY(), loopSizeWidth, buttonHeight);
+    doubleLoopButton.setBounds(halveLoopButton.getRight() + padding, loadButton.getY(), loopSizeWidth, buttonHeight);
+    keylockButton.setBounds(doubleLoopButton.getRight() + padding, loadButton.getY(), keylockWidth, buttonHeight);
+
+    // EQ, filter and trim knobs in equal columns under the load button, labels beneath,
+    // and the auto-trim toggle in a sixth column
+    juce::Slider* knobs[] = { &lowKnob, &midKnob, &highKnob, &filterKnob, &trimKnob };
+    juce::Label* knobLabels[] = { &lowLabel, &midLabel, &highLabel, &filterLabel, &trimLabel };
+    int knobColumnWidth = (getWidth() - 2 * padding) / 6;
+    int knobSize = juce::jmin(56, knobColumnWidth - padding);
+    int knobY = loadButton.getBottom() + padding;
+
+    for (int i = 0; i < 5; ++i)
+    {
+        int columnX = padding + i * knobColumnWidth;
+        knobs[i]->setBounds(columnX + (knobColumnWidth - knobSize) / 2, knobY, knobSize, knobSize);
+        knobLabels[i]->setBounds(columnX, knobs[i]->getBottom(), knobColumnWidth, 14);
+    }
+
+    int autoColumnX = padding + 5 * knobColumnWidth;
+    autoGainButton.setBounds(autoColumnX, knobY + (knobSize - buttonHeight) / 2, knobColumnWidth, buttonHeight);
+    autoGainLabel.setBounds(autoColumnX, knobY + knobSize, knobColumnWidth, 14);
+
+    renderStaticLayers();
+}
+
+
+void DeckGUI::buttonClicked(juce::Button* button)
+{
+    if (button == &playButton)
+    {
+        juce::Logger::outputDebugString("Play Button Was Clicked!");
+        player->start();
+    }
+    if (button == &stopButton)
+    {
+        juce::Logger::outputDebugString("Stop Button Was Clicked!");
+        player->stop();
+    }
+
+    if (button == &loadButton) {
+        juce::Logger::outputDebugString("Load Button was Clicked");
+
+        auto filechooserFlags = juce::FileBrowserComponent::canSelectFiles;
+        fChooser.launchAsync(filechooserFlags, [this](const juce::FileChooser& chooser)
+            {
+                juce::File chosenFile = chooser.getResult();
+                if (chosenFile != juce::File{})
+                    loadTrack(juce::URL{ chosenFile });
+            });
+    }
+
+    // Shift-click empties the queue; otherwise the chosen tracks join its end
+    if (button == &queueButton) {
+        if (juce::ModifierKeys::currentModifiers.isShiftDown()) {
+            player->clearQueue();
+        }
+        else {
+            auto filechooserFlags = juce::FileBrowserComponent::canSelectFiles | juce::FileBrowserComponent::canSelectMultipleItems;
+            queueChooser.launchAsync(filechooserFlags, [this](const juce::FileChooser& chooser)
+                {
+                    queueTracks(chooser.getResults());
+                });
+        }
+    }
+
+    if (button == &nextButton) player->playNext();
+
+    if (button == &setCueButton) {
+        double currentPosition = player->getSnapshot().getPositionInSeconds();
+        if (currentPosition > 0) {
+            auto& cuePoints = waveDisplay.getCuePoints();
+            if (std::find(cuePoints.begin(), cuePoints.end(), currentPosition) == cuePoints.end()) {
+                waveDisplay.addCuePoint(currentPosition);
+                player->setCuePoints(waveDisplay.getCuePoints());
+            }
+        }
+    }
+
+    if (button == &keylockButton) {
+        player->setKeylock(keylockButton.getToggleState());
+    }
+
+    if (button == &autoGainButton) {
+        player->setAutoTrim(autoGainButton.getToggleState());
+    }
+
+    if (button == &loopInButton) player->setLoopIn();
+    if (button == &loopOutButton) player->setLoopOut();
+    if (button == &halveLoopButton) player->halveLoop();
+    if (button == &doubleLoopButton) player->doubleLoop();
+
+    // The beat loop button leaves a loop that is playing, or starts a new one
+    if (button == &beatLoopButton) {
+        if (snapshot.looping)
+            player->exitLoop();
+        else
+            player->startBeatLoop(beatLoopLength);
+    }
+
+    if (button == &jumpCueButton && !waveDisplay.getCuePoints().empty()) {
+        auto& cuePoints = waveDisplay.getCuePoints();
+        int cueIndex = waveDisplay.getCurrentCueIndex();
+        cueIndex = (cueIndex + 1) % cuePoints.size();
+        waveDisplay.setCurrentCueIndex(cueIndex);
+        waveDisplay.repaint();
+        player->jumpToCue(cuePoints[cueIndex]);
+    }
+}
+
+void DeckGUI::sliderValueChanged(juce::Slider* slider)
+{
+    if (slider == &volSlider) player->setGain(slider->getValue());
+    if (slider == &speedSlider) player->setspeed(slider->getValue());
+    if (slider == &positionSlider) player->setPositionRelative(slider->getValue());
+    if (slider == &lowKnob) player->setEqGain(DeckEQ::Band::low, slider->getValue());
+    if (slider == &midKnob) player->setEqGain(DeckEQ::Band::mid, slider->getValue());
+    if (slider == &highKnob) player->setEqGain(DeckEQ::Band::high, slider->getValue());
+    if (slider == &filterKnob) player->setFilter(slider->getValue());
+    if (slider == &trimKnob) player->setTrim(slider->getValue());
+}
+
+bool DeckGUI::isInterestedInFileDrag(const juce::StringArray& files) { return true; }
+
+// One file replaces the deck's track; several join the queue
+void DeckGUI::filesDropped(const juce::StringArray& files, int x, int y)
+{
+    if (files.size() == 1) loadTrack(juce::URL{ juce::File{files[0]} });
+
+    if (files.size() > 1) {
+        juce::Array<juce::File> tracks;
+        for (auto& file : files)
+            tracks.add(juce::File{ file });
+        queueTracks(tracks);
+    }
+}
+
+void DeckGUI::queueTracks(const juce::Array<juce::File>& files)
+{
+    for (auto& file : files) {
+        if (snapshot.lengthSamples <= 0 && !player->isLoading())
+            loadTrack(juce::URL{ file });
+        else
+            player->appendToQueue(juce::URL{ file });
+    }
+}
+
+void DeckGUI::queuedTrackStarted()
+{
+    waveDisplay.startNewTrack();
+    waveformPyramid.clear();
+}
+
+void DeckGUI::loadTrack(juce::URL audioURL)
+{
+    // The player opens the file on its loader thread, so the UI stays responsive meanwhile.
+    // Its single decode pass of the track also builds both waveforms.
+    waveDisplay.startNewTrack();
+    waveformPyramid.clear();
+    player->LoadURL(audioURL, { waveDisplay.getDecodeConsumer(), waveDisplay.getSpectrumConsumer(), &waveformPyramid });
+
+    loadButton.setButtonText("LOADING...");
+    loadButton.setEnabled(false);
+    playButton.setEnabled(false);
+}
+
+void DeckGUI::trackLoaded(bool loaded)
+{
+    loadButton.setButtonText("LOAD");
+    loadButton.setEnabled(true);
+    playButton.setEnabled(true);
+
+    if (!loaded)
+        juce::Logger::outputDebugString("DeckGUI::trackLoaded: Track could not be loaded");
+}
+
+void DeckGUI::timerCallback()
+{
+    // Read the state the audio thread published for its last block
+    const DeckSnapshot previous = snapshot;
+    snapshot = player->getSnapshot();
+
+    // A controller changes the deck without touching its widgets, so they follow the published state.
+    // Only a value that has changed since the last tick moves a control, and never one being dragged.
+    const auto mirror = [](juce::Slider& slider, double previousValue, double newValue) {
+        if (newValue != previousValue && !slider.isMouseButtonDown())
+            slider.setValue(newValue, juce::dontSendNotification);
+    };
+
+    mirror(volSlider, previous.gain, snapshot.gain);
+    mirror(speedSlider, previous.speed, snapshot.speed);
+    mirror(lowKnob, previous.eqLow, snapshot.eqLow);
+    mirror(midKnob, previous.eqMid, snapshot.eqMid);
+    mirror(highKnob, previous.eqHigh, snapshot.eqHigh);
+    mirror(filterKnob, previous.filter, snapshot.filter);
+    mirror(trimKnob, previous.trim, snapshot.trim);
+
+    // The auto-trim in dB, or just the name while it is off or the track is still being measured
+    if (snapshot.autoTrim != previous.autoTrim)
+        autoGainLabel.setText(snapshot.autoTrim != 1.0f ? juce::String(juce::Decibels::gainToDecibels(snapshot.autoTrim), 1) + " dB" : juce::String("Auto"),
+            juce::dontSendNotification);
+
+    // Hand the same snapshot to the waveform so both views agree on the playhead
+    waveDisplay.setPlayhead(snapshot);
+
+    // Pick up the grid once the background analysis has delivered it
+    BeatGrid latestGrid = player->getBeatGrid();
+    bool gridChanged = latestGrid.bpm != beatGrid.bpm || latestGrid.firstBeatSeconds != beatGrid.firstBeatSeconds;
+    beatGrid = latestGrid;
+    waveDisplay.setBeatGrid(beatGrid);
+
+    zoomedDisplay.setPlayhead(snapshot);
+    zoomedDisplay.setBeatGrid(beatGrid);
+
+    beatLoopButton.setToggleState(snapshot.looping, juce::dontSendNotification);
+
+    // The queue shrinks on its own as tracks take over
+    const int queued = player->getQueue().size();
+    if (queued != queueLength) {
+        queueLength = queued;
+        queueButton.setButtonText(queued > 0 ? "QUEUE (" + juce::String(queued) + ")" : juce::String("QUEUE"));
+    }
+
+    // Only the animated parts are redrawn; the waveforms repaint their own changes
+    repaint(getLogoBounds());
+
+    auto progressBounds = getProgressBarBounds();
+    int fill = juce::roundToInt(progressBounds.getWidth() * juce::jlimit(0.0, 1.0, snapshot.getPositionRelative()));
+    if (fill != progressBarFill) {
+        progressBarFill = fill;
+        repaint(progressBounds);
+    }
+
+    // Light up for the first quarter of every beat on the analysed grid
+    double pos = juce::jmax(0.0, snapshot.getPositionInSeconds());
+    bool beatNow = beatGrid.isValid() && pos >= beatGrid.firstBeatSeconds && beatGrid.getBeatPhase(pos) < 0.25;
+    if (beatNow != isBeat || gridChanged) {
+        isBeat = beatNow;
+        repaint(getBeatIndicatorBounds());
+    }
+
+    // Refresh the frame-time counter twice a second
+    if (++ticksSinceFrameTime >= 15) {
+        ticksSinceFrameTime = 0;
+        frameTimeText = paintCount > 0 ? "paint " + juce::String(paintTimeTotalMs / paintCount, 2) + " ms"
+                                       : juce::String("paint --");
+        paintTimeTotalMs = 0.0;
+        paintCount = 0;
+        repaint(getFrameTimeBounds());
+    }
+}
+
+
+// Draw Beat Indicator (Small Pulsing circle synced to beats)
+void DeckGUI::drawBeatIndicator(juce::Graphics& g, bool isBeat)
+{
+    float radius = 8.f;
+    auto indicatorPos = juce::Point<float>(getWidth() - 20.f, 20.f);
+    g.setColour(isBeat ? juce::Colours::lime : juce::Colours::grey);
+    g.fillEllipse(indicatorPos.x - radius, indicatorPos.y - radius, radius * 2.f, radius * 2.f);
+}
+
+// Draw the tempo to the left of the beat indicator, or dashes while the track is being analysed
+void DeckGUI::drawTempo(juce::Graphics& g)
+{
+    juce::String tempoText = beatGrid.isValid() ? juce::String(beatGrid.bpm, 1) + " BPM" : juce::String("--- BPM");
+    g.setColour(juce::Colour::fromRGB(230, 230, 250));  // Soft White
+    g.setFont(juce::Font(14.0f, juce::Font::bold));
+    g.drawText(tempoText, getWidth() - 110, 10, 80, 20, juce::Justification::centredRight);
+}
+
+// Draw the frame-time counter in the top-left corner, opposite the tempo
+void DeckGUI::drawFrameTime(juce::Graphics& g)
+{
+    g.setColour(juce::Colours::grey);
+    g.setFont(juce::Font(12.0f));
+    g.drawText(frameTimeText, getFrameTimeBounds(), juce::Justification::centredLeft);
+}
+
+void DeckGUI::drawProgressBar(juce::Graphics& g, float progress)
+{
+    // Clamp progress explicitly between 0 and 1
+    progress = juce::jlimit(0.0f, 1.0f, progress);
+
+    int barWidth = getWidth() - 20;
+    int yPos = waveDisplay.getBottom() + 8;
+
+    // Background
+    g.setColour(juce::Colours::darkgrey);
+    g.fillRoundedRectangle(10.0f, static_cast<float>(yPos), static_cast<float>(barWidth), 5.0f, 2.0f);
+
+    // Progress Indicator
+    g.setColour(juce::Colours::cyan);
+    g.fillRoundedRectangle(10.0f, static_cast<float>(yPos), barWidth * progress, 5.0f, 2.5f);
+}
+
+
+void DeckGUI::drawAnimatedLogo(juce::Graphics& g, float alphaValue)
+{
+    g.setColour(juce::Colours::white.withAlpha(alphaValue));
+    g.setFont(juce::Font("Arial Black", 20.f, juce::Font::bold));
+    g.drawText("Otodecks DJ PRO", getLocalBounds().removeFromTop(30), juce::Justification::centred);
+}
@@ -1,86 +1,185 @@
-#pragma once
-
-#include <JuceHeader.h>
-#include "djAudioPlayer.h"
-#include "WaveFormDisplay.h"
-
-// DeckGUI class
-// Manages the user interface for each deck, including buttons, sliders, and waveform display
-// Also handles special effects and file drag-and-drop
-class DeckGUI : public juce::Component,
-    public juce::Button::Listener,
-    public juce::Slider::Listener,
-    public juce::FileDragAndDropTarget,
-    private juce::Timer  // Used for timing-based effects
-{
-public:
-    // Constructor: Initializes the DeckGUI with a DJAudioPlayer instance
-    DeckGUI(DJAudioPlayer* player,
-        juce::AudioFormatManager& formatManagerToUse,
-        juce::AudioThumbnailCache& cacheToUse);
-
-    // Destructor: Cleans up resources
-    ~DeckGUI() override;
-
-    // paint: Draws UI components and custom graphics
-    void paint(juce::Graphics&) override;
-
-    // resized: Arranges UI components when the window size changes
-    void resized() override;
-
-    // Handles button click events
-    void buttonClicked(juce::Button*) override;
-
-    // Handles slider value change events
-    void sliderValueChanged(juce::Slider*) override;
-
-    // File drag-and-drop support
-    bool isInterestedInFileDrag(const juce::StringArray& files) override;
-    void filesDropped(const juce::StringArray& files, int x, int y) override;
-
-private:
-    //==============================================================================
-    // Special Effects Methods
-
-    // timerCallback: Called periodically to update UI animations
-    void timerCallback() override;
-
-    // drawBeatIndicator: Draws a visual indicator for beats
-    void drawBeatIndicator(juce::Graphics& g, bool isBeat);
-
-    // drawProgressBar: Draws a progress bar based on playback position
-    void drawProgressBar(juce::Graphics& g, float progress);
-
-    // drawAnimatedLogo: Draws an animated logo with varying transparency
-    void drawAnimatedLogo(juce::Graphics& g, float alpha);
-
-    //==============================================================================
-    // UI Components
-
-    // Buttons for playback control and cue points
-    juce::TextButton playButton{ "Play" },
-        stopButton{ "Stop" },
-        loadButton{ "LOAD" },
-        setCueButton{ "SET CUE" },
-        jumpCueButton{ "JUMP CUE" };
-
-    // Sliders for volume, speed, and position control with rotary style
-    juce::Slider volSlider{ juce::Slider::RotaryHorizontalVerticalDrag, juce::Slider::TextBoxBelow },
-        speedSlider{ juce::Slider::RotaryHorizontalVerticalDrag, juce::Slider::TextBoxBelow },
-        positionSlider{ juce::Slider::RotaryHorizontalVerticalDrag, juce::Slider::TextBoxBelow };
-
-    // File chooser for loading audio files
-    juce::FileChooser fChooser{ "Select a File.." };
-
-    // Pointers to manage audio playback and waveform display
-    DJAudioPlayer* player;
-    WaveFormDisplay waveDisplay;
-
-    // Labels for sliders to indicate function (Volume, Speed, Position)
-    juce::Label volLabel{ {}, "Volume" },
-        speedLabel{ {}, "Speed" },
-        positionLabel{ {}, "Position" };
-
-    // Prevents copying and assignment of DeckGUI
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DeckGUI)
-};
+#pragma once
+
+#include <JuceHeader.h>
+#include "djAudioPlayer.h"
+#include "WaveFormDisplay.h"
+#include "WaveformPyramid.h"
+#include "ZoomedWaveformDisplay.h"
+
+// DeckGUI class
+// Manages the user interface for each deck, including buttons, sliders, and waveform display
+// Also handles special effects and file drag-and-drop
+class DeckGUI : public juce::Component,
+    public juce::Button::Listener,
+    public juce::Slider::Listener,
+    public juce::FileDragAndDropTarget,
+    private juce::Timer  // Used for timing-based effects
+{
+public:
+    // Constructor: Initializes the DeckGUI with a DJAudioPlayer instance
+    DeckGUI(DJAudioPlayer* player,
+        juce::AudioFormatManager& formatManagerToUse,
+        juce::AudioThumbnailCache& cacheToUse);
+
+    // Destructor: Cleans up resources
+    ~DeckGUI() override;
+
+    // paint: Draws UI components and custom graphics
+    void paint(juce::Graphics&) override;
+
+    // paintOverChildren: Finishes timing the frame once the child components are drawn
+    void paintOverChildren(juce::Graphics&) override;
+
+    // resized: Arranges UI components when the window size changes
+    void resized() override;
+
+    // Handles button click events
+    void buttonClicked(juce::Button*) override;
+
+    // Handles slider value change events
+    void sliderValueChanged(juce::Slider*) override;
+
+    // File drag-and-drop support
+    bool isInterestedInFileDrag(const juce::StringArray& files) override;
+    void filesDropped(const juce::StringArray& files, int x, int y) override;
+
+    // Starts loading a track into the player and the waveform display
+    void loadTrack(juce::URL audioURL);
+
+    // Adds tracks to the player's queue, loading the first instead if the deck is empty
+    void queueTracks(const juce::Array<juce::File>& files);
+
+private:
+    // Called once the player has finished loading a track in the background
+    void trackLoaded(bool loaded);
+
+    // Called when a track from the queue has taken over, to clear the waveforms for its analysis
+    void queuedTrackStarted();
+
+    //==============================================================================
+    // Special Effects Methods
+
+    // timerCallback: Called periodically to update UI animations
+    void timerCallback() override;
+
+    // drawBeatIndicator: Draws a visual indicator for beats
+    void drawBeatIndicator(juce::Graphics& g, bool isBeat);
+
+    // drawTempo: Draws the analysed tempo beside the beat indicator
+    void drawTempo(juce::Graphics& g);
+
+    // drawProgressBar: Draws a progress bar based on playback position
+    void drawProgressBar(juce::Graphics& g, float progress);
+
+    // drawAnimatedLogo: Draws an animated logo with varying transparency
+    void drawAnimatedLogo(juce::Graphics& g, float alpha);
+
+    // drawFrameTime: Draws the average time spent painting the deck
+    void drawFrameTime(juce::Graphics& g);
+
+    // renderStaticLayers: Draws the background and logo into images, once per resize
+    void renderStaticLayers();
+
+    // Areas the timer repaints instead of the whole deck
+    juce::Rectangle<int> getLogoBounds() const;
+    juce::Rectangle<int> getProgressBarBounds() const;
+    juce::Rectangle<int> getBeatIndicatorBounds() const;  // Beat indicator and tempo
+    juce::Rectangle<int> getFrameTimeBounds() const;
+
+    //==============================================================================
+    // UI Components
+
+    // Beats in the loop the beat loop button starts
+    static constexpr int beatLoopLength = 4;
+
+    // Buttons for playback control and cue points
+    juce::TextButton playButton{ "Play" },
+        stopButton{ "Stop" },
+        loadButton{ "LOAD" },
+        queueButton{ "QUEUE" },
+        nextButton{ "NEXT" },
+        setCueButton{ "SET CUE" },
+        jumpCueButton{ "JUMP CUE" };
+
+    // Loop controls: manual in and out points, a beat loop that lights up while looping, halve and double
+    juce::TextButton loopInButton{ "LOOP IN" },
+        loopOutButton{ "LOOP OUT" },
+        beatLoopButton{ "LOOP " + juce::String(beatLoopLength) },
+        halveLoopButton{ "1/2" },
+        doubleLoopButton{ "x2" };
+
+    // Keeps the pitch constant while the speed knob changes the tempo
+    juce::ToggleButton keylockButton{ "KEYLOCK" };
+
+    // Sliders for volume, speed, and position control with rotary style
+    juce::Slider volSlider{ juce::Slider::RotaryHorizontalVerticalDrag, juce::Slider::TextBoxBelow },
+        speedSlider{ juce::Slider::RotaryHorizontalVerticalDrag, juce::Slider::TextBoxBelow },
+        positionSlider{ juce::Slider::RotaryHorizontalVerticalDrag, juce::Slider::TextBoxBelow };
+
+    // Kill EQ, filter and trim knobs, in a smaller row under the load button
+    juce::Slider lowKnob{ juce::Slider::RotaryHorizontalVerticalDrag, juce::Slider::NoTextBox },
+        midKnob{ juce::Slider::RotaryHorizontalVerticalDrag, juce::Slider::NoTextBox },
+        highKnob{ juce::Slider::RotaryHorizontalVerticalDrag, juce::Slider::NoTextBox },
+        filterKnob{ juce::Slider::RotaryHorizontalVerticalDrag, juce::Slider::NoTextBox },
+        trimKnob{ juce::Slider::RotaryHorizontalVerticalDrag, juce::Slider::NoTextBox };
+
+    juce::Label lowLabel{ {}, "Low" },
+        midLabel{ {}, "Mid" },
+        highLabel{ {}, "High" },
+        filterLabel{ {}, "Filter" },
+        trimLabel{ {}, "Trim" };
+
+    // Loudness auto-trim toggle at the end of the knob row, and the trim it is applying
+    juce::ToggleButton autoGainButton{ "AUTO" };
+    juce::Label autoGainLabel{ {}, "Auto" };
+
+    // File chooser for loading audio files
+    juce::FileChooser fChooser{ "Select a File.." };
+
+    // File chooser for adding tracks to the queue, and the queue length shown on its button
+    juce::FileChooser queueChooser{ "Add to Queue.." };
+    int queueLength = 0;
+
+    // Pointers to manage audio playback and waveform display
+    DJAudioPlayer* player;
+    WaveFormDisplay waveDisplay;
+
+    // Level-of-detail waveform built by the decode pass, drawn by the scrolling close-up view
+    WaveformPyramid waveformPyramid;
+    ZoomedWaveformDisplay zoomedDisplay{ waveformPyramid };
+
+    // Cache-only consumers of the queued track's analysis, none of them drawn: they write every section
+    // the waveforms above restore from when it takes over
+    juce::AudioThumbnail queuedThumbnail;
+    WaveFormDisplay::ThumbnailFiller queuedThumbnailFiller{ queuedThumbnail };
+    SpectralWaveform queuedSpectrum;
+    WaveformPyramid queuedWaveformPyramid;
+
+    // Deck state read once per timer tick and shared by everything drawn in that frame
+    DeckSnapshot snapshot;
+
+    // Beat grid of the loaded track, empty until its analysis finishes
+    BeatGrid beatGrid;
+
+    // State drawn by the last frame, so the timer only repaints what changed
+    bool isBeat = false;
+    int progressBarFill = -1;
+
+    // Background gradient, border and logo, which never change between resizes
+    juce::Image backgroundLayer, logoLayer;
+
+    // Frame-time counter: paint time of the deck and its children, averaged over half a second
+    double paintStartMs = 0.0;
+    double paintTimeTotalMs = 0.0;
+    int paintCount = 0;
+    int ticksSinceFrameTime = 0;
+    juce::String frameTimeText{ "paint --" };
+
+    // Labels for sliders to indicate function (Volume, Speed, Position)
+    juce::Label volLabel{ {}, "Volume" },
+        speedLabel{ {}, "Speed" },
+        positionLabel{ {}, "Position" };
+
+    // Prevents copying and assignment of DeckGUI
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DeckGUI)
+};
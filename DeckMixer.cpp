@@ -0,0 +1,217 @@
+/*
+  ==============================================================================
+
+    DeckMixer.cpp
+    Created: 17 Oct 2026 7:21:05pm
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#include "DeckMixer.h"
+#include "VectorOps.h"
+#include <thread>
+
+namespace {
+    // Yields a worker makes between blocks before going to sleep
+    constexpr int workerSpinCount = 256;
+}
+
+// Constructor for DeckMixer
+DeckMixer::DeckMixer() {
+}
+
+// Destructor for DeckMixer
+DeckMixer::~DeckMixer() {
+    stopWorkers();
+}
+
+// Adds a deck on one side of the crossfader
+void DeckMixer::addDeck(juce::AudioSource* deck, CrossfaderSide side) {
+    jassert(deck != nullptr && decks.size() < maxDecks);
+    jassert(workers.isEmpty());  // Decks can't change while audio is running
+
+    auto* newDeck = decks.add(new Deck());
+    newDeck->source = deck;
+    newDeck->side = side;
+}
+
+// Moves a deck to the other side of the crossfader, or out of its reach
+void DeckMixer::setCrossfaderSide(int deckIndex, CrossfaderSide side) {
+    if (auto* deck = decks[deckIndex])
+        deck->side = side;
+}
+
+// Sets the crossfader position, clamped to 0 (left) .. 1 (right)
+void DeckMixer::setCrossfader(float position) {
+    crossfader = juce::jlimit(0.0f, 1.0f, position);
+}
+
+// Prepares the decks and their render buffers, then the workers that share the rendering
+void DeckMixer::prepareToPlay(int samplesPerBlockExpected, double sampleRate) {
+    stopWorkers();
+
+    for (auto* deck : decks) {
+        deck->source->prepareToPlay(samplesPerBlockExpected, sampleRate);
+        deck->buffer.setSize(2, samplesPerBlockExpected);
+
+        // The first block ramps from where the crossfader already is, not from full level
+        deck->lastGain = getCrossfaderGain(deck->side, crossfader);
+    }
+
+    startWorkers(samplesPerBlockExpected, sampleRate);
+}
+
+// Renders every deck, then sums them through the crossfader
+void DeckMixer::getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill) {
+    const int numChannels = bufferToFill.buffer->getNumChannels();
+    const int numSamples = bufferToFill.numSamples;
+    const int numDecks = decks.size();
+
+    // Sized in prepareToPlay, so this only reallocates if the device sends a larger block than promised
+    for (auto* deck : decks)
+        deck->buffer.setSize(numChannels, numSamples, false, false, true);
+
+    // Open the barrier for this block and wake any worker that has gone to sleep
+    blockNumSamples = numSamples;
+    decksDone.store(0);
+    nextDeck.store(0, std::memory_order_release);
+    ++blockGeneration;
+
+    for (auto* worker : workers)
+        worker->wakeIfSleeping();
+
+    // The callback thread renders too, so a late worker can only ever cost the deck it has claimed
+    renderClaimedDecks();
+
+    while (decksDone.load(std::memory_order_acquire) < numDecks)
+        std::this_thread::yield();
+
+    bufferToFill.clearActiveBufferRegion();
+
+    const float position = crossfader.load();
+
+    for (auto* deck : decks) {
+        const float gain = getCrossfaderGain(deck->side.load(), position);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            VectorOps::addWithRamp(bufferToFill.buffer->getWritePointer(channel, bufferToFill.startSample),
+                deck->buffer.getReadPointer(channel), deck->lastGain, gain, numSamples);
+
+        deck->lastGain = gain;
+    }
+}
+
+// Releases resources used by the mixer and its decks
+void DeckMixer::releaseResources() {
+    stopWorkers();
+
+    for (auto* deck : decks) {
+        deck->source->releaseResources();
+        deck->buffer.setSize(0, 0);
+    }
+}
+
+// Full level up to the centre, fading to silence towards the other side
+float DeckMixer::getCrossfaderGain(CrossfaderSide side, float position) noexcept {
+    if (side == CrossfaderSide::thru)
+        return 1.0f;
+
+    const float towardsSide = side == CrossfaderSide::left ? 1.0f - position : position;
+    return juce::jmin(1.0f, 2.0f * towardsSide);
+}
+
+// Returns how long a deck took to render the last block, or 0 for a deck that doesn't exist
+float DeckMixer::getDeckRenderMicros(int deckIndex) const noexcept {
+    if (auto* deck = decks[deckIndex])
+        return deck->renderMicros;
+
+    return 0.0f;
+}
+
+// The audio thread renders a deck itself, so one core is left for it
+void DeckMixer::startWorkers(int samplesPerBlockExpected, double sampleRate) {
+    const int numWorkers = juce::jmin(decks.size() - 1, juce::SystemStats::getNumCpus() - 1);
+
+    for (int i = 0; i < numWorkers; ++i) {
+        auto* worker = workers.add(new Worker(*this));
+
+        // Fall back to an ordinary high-priority thread where real-time scheduling isn't allowed
+        if (!worker->startRealtimeThread(juce::Thread::RealtimeOptions{}
+                .withApproximateAudioProcessingTime(samplesPerBlockExpected, sampleRate)))
+            worker->startThread(juce::Thread::Priority::highest);
+    }
+}
+
+// Wakes every worker so it sees the exit flag, then waits for them
+void DeckMixer::stopWorkers() {
+    for (auto* worker : workers)
+        worker->signalThreadShouldExit();
+
+    for (auto* worker : workers) {
+        worker->wakeIfSleeping();
+        worker->stopThread(2000);
+    }
+
+    workers.clear();
+}
+
+// Each deck is claimed by exactly one thread, which times its render
+void DeckMixer::renderClaimedDecks() {
+    juce::ScopedNoDenormals noDenormals;
+    const int numDecks = decks.size();
+
+    for (;;) {
+        const int index = nextDeck.fetch_add(1, std::memory_order_acq_rel);
+        if (index >= numDecks)
+            break;
+
+        auto* deck = decks.getUnchecked(index);
+        juce::AudioSourceChannelInfo info(&deck->buffer, 0, blockNumSamples);
+
+        const auto startTicks = juce::Time::getHighResolutionTicks();
+        deck->source->getNextAudioBlock(info);
+        deck->renderMicros = (float)(juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks) * 1.0e6);
+
+        decksDone.fetch_add(1, std::memory_order_release);
+    }
+}
+
+//==============================================================================
+// Renders decks of each new block until told to exit
+void DeckMixer::Worker::run() {
+    juce::uint32 lastGeneration = mixer.blockGeneration.load();
+
+    while (!threadShouldExit()) {
+        if (waitForBlock(lastGeneration)) {
+            lastGeneration = mixer.blockGeneration.load();
+            mixer.renderClaimedDecks();
+        }
+    }
+}
+
+// Only signals a worker that has gone to sleep, so a spinning one costs the audio thread nothing
+void DeckMixer::Worker::wakeIfSleeping() {
+    if (sleeping.load())
+        wakeEvent.signal();
+}
+
+// Spins briefly, then sleeps until the audio thread starts a block
+bool DeckMixer::Worker::waitForBlock(juce::uint32 lastGeneration) {
+    // Spinning catches blocks that follow closely without paying for a wake-up
+    for (int spin = 0; spin < workerSpinCount; ++spin) {
+        if (mixer.blockGeneration.load() != lastGeneration)
+            return true;
+
+        std::this_thread::yield();
+    }
+
+    // Announce the sleep before the last check, so a block that starts now is sure to signal us
+    sleeping = true;
+
+    if (mixer.blockGeneration.load() == lastGeneration && !threadShouldExit())
+        wakeEvent.wait(100);
+
+    sleeping = false;
+    return mixer.blockGeneration.load() != lastGeneration;
+}
@@ -0,0 +1,107 @@
+/*
+  ==============================================================================
+
+    DeckMixer.h
+    Created: 17 Oct 2026 7:21:05pm
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// DeckMixer class
+// Mixes 2 to 8 decks through a crossfader. Every block, the decks are rendered in parallel by a small
+// pool of real-time worker threads together with the audio callback thread, which meet at a lock-free
+// barrier before the deck outputs are summed. A block then takes about as long as its slowest deck
+// rather than the sum of all of them.
+class DeckMixer : public juce::AudioSource {
+public:
+    static constexpr int minDecks = 2;
+    static constexpr int maxDecks = 8;
+
+    // Which crossfader side a deck is on; thru decks ignore the crossfader
+    enum class CrossfaderSide { left, right, thru };
+
+    // Constructor
+    DeckMixer();
+
+    // Destructor: stops the workers; the decks themselves are not owned
+    ~DeckMixer() override;
+
+    // Adds a deck, which must outlive the mixer. Decks are added before audio starts
+    void addDeck(juce::AudioSource* deck, CrossfaderSide side);
+
+    // Returns the number of decks
+    int getNumDecks() const { return decks.size(); }
+
+    // Moves a deck to another crossfader side (any thread)
+    void setCrossfaderSide(int deckIndex, CrossfaderSide side);
+
+    // Sets the crossfader from 0 (fully left) to 1 (fully right) (any thread)
+    void setCrossfader(float position);
+
+    // Returns the crossfader position, wherever it was last set from (any thread)
+    float getCrossfader() const noexcept { return crossfader.load(); }
+
+    // Prepares every deck and starts the worker threads
+    void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
+
+    // Renders all decks, in parallel where workers are available, and mixes them into the buffer
+    void getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill) override;
+
+    // Stops the worker threads and releases every deck
+    void releaseResources() override;
+
+    // Time the deck's source took to render in the last block, in microseconds. Audio thread only,
+    // after getNextAudioBlock has returned
+    float getDeckRenderMicros(int deckIndex) const noexcept;
+
+    // Gain of a deck on the given side at a crossfader position. Both sides play at full level in the
+    // middle and the far side fades out over the outer half of the travel
+    static float getCrossfaderGain(CrossfaderSide side, float position) noexcept;
+
+private:
+    // Renders decks for the audio callback; spins briefly between blocks, then sleeps until woken
+    class Worker : public juce::Thread {
+    public:
+        explicit Worker(DeckMixer& owner) : juce::Thread("Deck mixer worker"), mixer(owner) {}
+        void run() override;
+        void wakeIfSleeping();  // Called by the audio thread once a block is ready
+    private:
+        bool waitForBlock(juce::uint32 lastGeneration);  // Returns true once a newer block has started
+        DeckMixer& mixer;
+        std::atomic<bool> sleeping{ false };
+        juce::WaitableEvent wakeEvent;
+    };
+
+    struct Deck {
+        juce::AudioSource* source = nullptr;
+        std::atomic<CrossfaderSide> side{ CrossfaderSide::thru };
+        juce::AudioBuffer<float> buffer;  // The deck's output for the current block
+        float lastGain = 0.0f;  // Gain at the end of the previous block, ramped from to avoid clicks
+        float renderMicros = 0.0f;  // Written by whichever thread renders the deck, read after the barrier
+    };
+
+    // Starts one worker per deck beyond the first, as far as there are spare cores
+    void startWorkers(int samplesPerBlockExpected, double sampleRate);
+    void stopWorkers();
+
+    // Claims and renders decks of the current block until none are left (audio thread and workers)
+    void renderClaimedDecks();
+
+    juce::OwnedArray<Deck> decks;
+    juce::OwnedArray<Worker> workers;
+    std::atomic<float> crossfader{ 0.5f };
+
+    // Barrier for the block being rendered. decksDone is reset before nextDeck is, so a worker
+    // that claims a deck early for the next block is always counted
+    int blockNumSamples = 0;
+    std::atomic<int> nextDeck{ 0 };
+    std::atomic<int> decksDone{ 0 };
+    std::atomic<juce::uint32> blockGeneration{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DeckMixer)
+};
@@ -0,0 +1,60 @@
+/*
+  ==============================================================================
+
+    DeckSnapshot.cpp
+    Created: 17 Oct 2026 11:04:18am
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#include "DeckSnapshot.h"
+
+// Returns the playhead position in seconds
+double DeckSnapshot::getPositionInSeconds() const {
+    return sampleRate > 0.0 ? (double)positionSamples / sampleRate : 0.0;
+}
+
+// Returns the track length in seconds
+double DeckSnapshot::getLengthInSeconds() const {
+    return sampleRate > 0.0 ? (double)lengthSamples / sampleRate : 0.0;
+}
+
+// Returns the playhead position relative to the track length, clamped to 0 to 1
+double DeckSnapshot::getPositionRelative() const {
+    if (lengthSamples <= 0)
+        return 0.0;
+
+    return juce::jlimit(0.0, 1.0, (double)positionSamples / (double)lengthSamples);
+}
+
+// Writes the snapshot between two sequence bumps so readers can detect a torn copy
+void DeckSnapshotPublisher::publish(const DeckSnapshot& newSnapshot) {
+    const auto start = sequence.load(std::memory_order_relaxed);
+
+    sequence.store(start + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    std::memcpy(&snapshot, &newSnapshot, sizeof(DeckSnapshot));
+
+    sequence.store(start + 2, std::memory_order_release);
+}
+
+// Copies the snapshot, retrying if a publish happened in the middle of the copy
+DeckSnapshot DeckSnapshotPublisher::read() const {
+    DeckSnapshot copy;
+
+    for (;;) {
+        const auto before = sequence.load(std::memory_order_acquire);
+
+        if ((before & 1) == 0) {
+            std::memcpy(&copy, &snapshot, sizeof(DeckSnapshot));
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (sequence.load(std::memory_order_relaxed) == before)
+                return copy;
+        }
+
+        juce::Thread::yield();
+    }
+}
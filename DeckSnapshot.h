@@ -0,0 +1,72 @@
+/*
+  ==============================================================================
+
+    DeckSnapshot.h
+    Created: 17 Oct 2026 11:04:18am
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// State of one deck as rendered by the most recent audio block
+struct DeckSnapshot {
+    // Playhead and track length, counted in samples at sampleRate
+    juce::int64 positionSamples = 0;
+    juce::int64 lengthSamples = 0;
+    double sampleRate = 0.0;
+
+    // Parameters in effect for the block
+    double speed = 1.0;
+    float gain = 1.0f;
+    bool playing = false;
+    bool keylock = false;
+
+    // EQ band gains, filter position and trim in effect for the block
+    float eqLow = 1.0f, eqMid = 1.0f, eqHigh = 1.0f;
+    float filter = 0.0f;
+    float trim = 1.0f;
+
+    // Loudness auto-trim in effect for the block (1 when it is off or the track isn't measured yet)
+    float autoTrim = 1.0f;
+
+    // Loop points in samples at sampleRate (-1 when not set), and whether the loop is wrapping
+    juce::int64 loopStartSamples = -1;
+    juce::int64 loopEndSamples = -1;
+    bool looping = false;
+
+    // Peak output level of the block per channel (0 to 1)
+    float peakLeft = 0.0f;
+    float peakRight = 0.0f;
+
+    // Returns the playhead position in seconds
+    double getPositionInSeconds() const;
+
+    // Returns the track length in seconds
+    double getLengthInSeconds() const;
+
+    // Returns the playhead position relative to the track length (0 to 1)
+    double getPositionRelative() const;
+};
+
+// Publishes a DeckSnapshot from the audio thread to any number of readers using a seqlock.
+// The writer never waits; readers retry in the rare case they overlap a publish.
+class DeckSnapshotPublisher {
+public:
+
+    // Publishes a new snapshot (audio thread only)
+    void publish(const DeckSnapshot& newSnapshot);
+
+    // Returns a consistent copy of the latest snapshot (any thread)
+    DeckSnapshot read() const;
+
+private:
+    // Odd while a publish is in progress
+    std::atomic<juce::uint32> sequence{ 0 };
+
+    DeckSnapshot snapshot;
+
+    static_assert(std::is_trivially_copyable<DeckSnapshot>::value, "DeckSnapshot is copied without locks");
+};
@@ -0,0 +1,273 @@
+/*
+  ==============================================================================
+
+    FusedResamplerAudioSource.cpp
+    Created: 17 Oct 2026 4:20:31pm
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#include "FusedResamplerAudioSource.h"
+#include "VectorOps.h"
+
+// Polyphase filter for one cutoff: numPhases + 1 rows of numTaps coefficients
+struct FusedResamplerAudioSource::KernelBank {
+    double cutoff = 1.0;
+    int numTaps = 0;
+    int numPhases = 0;
+    std::vector<float> coefficients;
+
+    // Returns the row for a phase (0 to numPhases inclusive)
+    const float* getPhase(int phase) const { return coefficients.data() + (size_t)phase * (size_t)numTaps; }
+};
+
+namespace {
+
+    // Zeroth-order modified Bessel function, for the Kaiser window
+    double besselI0(double x) {
+        double sum = 1.0, term = 1.0;
+        for (int k = 1; k < 32; ++k) {
+            term *= (x / (2.0 * k)) * (x / (2.0 * k));
+            sum += term;
+            if (term < sum * 1.0e-12)
+                break;
+        }
+        return sum;
+    }
+
+    // Cutoffs (as a fraction of the input Nyquist) that banks are built for, in quarter-octave steps
+    std::vector<double> getBankCutoffs() {
+        std::vector<double> cutoffs;
+        for (double cutoff = 1.0; cutoff > 1.0 / FusedResamplerAudioSource::maxRatio - 1.0e-6; cutoff *= 0.8408964)
+            cutoffs.push_back(cutoff);
+        return cutoffs;
+    }
+}
+
+// Builds and caches the banks for a quality. Called from prepareToPlay, never from the audio thread.
+const std::vector<FusedResamplerAudioSource::KernelBank>& FusedResamplerAudioSource::getKernelBanks(Quality quality) {
+    static juce::CriticalSection buildLock;
+    static std::vector<KernelBank> cache[3];
+
+    const juce::ScopedLock sl(buildLock);
+    auto& banks = cache[(int)quality];
+
+    if (banks.empty()) {
+        const int baseTaps = quality == Quality::draft ? 8 : (quality == Quality::standard ? 16 : 32);
+        const int numPhases = quality == Quality::draft ? 64 : (quality == Quality::standard ? 128 : 256);
+        const double beta = quality == Quality::draft ? 5.0 : (quality == Quality::standard ? 7.0 : 9.0);
+
+        // Leave a little headroom below Nyquist for the transition band
+        const double rolloff = quality == Quality::high ? 0.95 : 0.9;
+
+        for (auto cutoff : getBankCutoffs()) {
+            KernelBank bank;
+            bank.cutoff = cutoff;
+            bank.numTaps = 2 * (int)std::ceil(baseTaps / (2.0 * cutoff));
+            bank.numPhases = numPhases;
+            bank.coefficients.resize((size_t)(numPhases + 1) * (size_t)bank.numTaps);
+
+            const int half = bank.numTaps / 2;
+            const double fc = cutoff * rolloff;
+
+            for (int phase = 0; phase <= numPhases; ++phase) {
+                auto* row = bank.coefficients.data() + (size_t)phase * (size_t)bank.numTaps;
+                const double frac = (double)phase / numPhases;
+                double sum = 0.0;
+
+                for (int tap = 0; tap < bank.numTaps; ++tap) {
+                    // Distance from the output instant to this input sample
+                    const double d = (double)(tap - (half - 1)) - frac;
+                    const double x = juce::MathConstants<double>::pi * fc * d;
+                    const double sinc = std::abs(x) < 1.0e-9 ? 1.0 : std::sin(x) / x;
+                    const double w = d / (double)half;
+                    const double window = std::abs(w) >= 1.0 ? 0.0 : besselI0(beta * std::sqrt(1.0 - w * w)) / besselI0(beta);
+                    const double value = fc * sinc * window;
+                    row[tap] = (float)value;
+                    sum += value;
+                }
+
+                // Unity gain at DC for every phase
+                if (sum != 0.0)
+                    for (int tap = 0; tap < bank.numTaps; ++tap)
+                        row[tap] = (float)(row[tap] / sum);
+            }
+
+            banks.push_back(std::move(bank));
+        }
+    }
+
+    return banks;
+}
+
+// Constructor for FusedResamplerAudioSource
+FusedResamplerAudioSource::FusedResamplerAudioSource(juce::AudioSource* inputSource, bool deleteInputWhenDeleted, int channels)
+    : input(inputSource), numChannels(juce::jmax(1, channels)) {
+    jassert(inputSource != nullptr);
+
+    if (deleteInputWhenDeleted)
+        ownedInput.reset(inputSource);
+}
+
+// Destructor for FusedResamplerAudioSource
+FusedResamplerAudioSource::~FusedResamplerAudioSource() {
+
+}
+
+// Sets the resampling ratio, clamped to what the banks support
+void FusedResamplerAudioSource::setResamplingRatio(double newRatio) {
+    ratio = juce::jlimit(1.0 / maxRatio, maxRatio, newRatio);
+    chooseBank();
+}
+
+// Returns the current resampling ratio
+double FusedResamplerAudioSource::getResamplingRatio() const {
+    return ratio;
+}
+
+// The kernel's look-ahead is pulled before the output it feeds, so this is about half a kernel once playing
+double FusedResamplerAudioSource::getBufferedInput() const {
+    return juce::jmax(0.0, historyFilled - 1 - readPosition);
+}
+
+// Selects the kernel quality; all banks were looked up in prepareToPlay so this neither allocates nor locks
+void FusedResamplerAudioSource::setQuality(Quality newQuality) {
+    if (quality != newQuality) {
+        quality = newQuality;
+        banks = qualityBanks[(size_t)quality];
+        chooseBank();
+    }
+}
+
+// Switches to a different input, starting with empty history
+void FusedResamplerAudioSource::setInputSource(juce::AudioSource* newInput) {
+    jassert(newInput != nullptr);
+    input = newInput;
+    flushBuffers();
+}
+
+// Clears the input history so the next output starts at the input's current position
+void FusedResamplerAudioSource::flushBuffers() {
+    history.clear();
+
+    // Pretend enough history for any kernel has already been read as silence
+    historyFilled = historyMargin;
+    readPosition = historyFilled - 1;
+}
+
+// Prepares the input and sizes the history for the longest kernel and the largest chunk
+void FusedResamplerAudioSource::prepareToPlay(int samplesPerBlockExpected, double sampleRate) {
+    input->prepareToPlay(samplesPerBlockExpected, sampleRate);
+
+    // Build every quality now so switching later never allocates or locks on the audio thread
+    for (auto each : { Quality::draft, Quality::standard, Quality::high })
+        qualityBanks[(size_t)each] = &getKernelBanks(each);
+
+    banks = qualityBanks[(size_t)quality];
+
+    maxChunk = juce::jmax(64, samplesPerBlockExpected);
+
+    // Keep enough history for the longest kernel of any quality, so switching quality is always safe
+    historyMargin = 0;
+    for (auto* eachBanks : qualityBanks)
+        historyMargin = juce::jmax(historyMargin, eachBanks->back().numTaps);
+
+    history.setSize(numChannels, 2 * historyMargin + (int)std::ceil(maxChunk * maxRatio) + 16);
+
+    chooseBank();
+    flushBuffers();
+}
+
+// Releases the input's resources
+void FusedResamplerAudioSource::releaseResources() {
+    input->releaseResources();
+}
+
+// Renders the block in chunks no longer than the history was sized for
+void FusedResamplerAudioSource::getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill) {
+    if (bank == nullptr) {
+        // Not prepared yet
+        bufferToFill.clearActiveBufferRegion();
+        return;
+    }
+
+    for (int done = 0; done < bufferToFill.numSamples;) {
+        const int numThisTime = juce::jmin(maxChunk, bufferToFill.numSamples - done);
+        renderChunk(bufferToFill, done, numThisTime);
+        done += numThisTime;
+    }
+}
+
+// Uses the bank with the widest passband that still rejects everything above the output Nyquist
+void FusedResamplerAudioSource::chooseBank() {
+    if (banks == nullptr || banks->empty())
+        return;
+
+    const double wantedCutoff = juce::jmin(1.0, 1.0 / ratio);
+    bank = &banks->back();
+
+    for (auto& candidate : *banks) {
+        if (candidate.cutoff <= wantedCutoff + 1.0e-9) {
+            bank = &candidate;
+            break;
+        }
+    }
+}
+
+// Reads enough input for the chunk, then evaluates the kernel at every output instant
+void FusedResamplerAudioSource::renderChunk(const juce::AudioSourceChannelInfo& bufferToFill, int startOffset, int numSamples) {
+    const int numTaps = bank->numTaps;
+    const int half = numTaps / 2;
+    const int numPhases = bank->numPhases;
+
+    // The last output of the chunk needs input up to floor(position) + half
+    const double lastPosition = readPosition + ratio * numSamples;
+    const int required = juce::jmin(history.getNumSamples(), (int)lastPosition + half + 1);
+
+    if (required > historyFilled) {
+        juce::AudioSourceChannelInfo info(&history, historyFilled, required - historyFilled);
+        input->getNextAudioBlock(info);
+        historyFilled = required;
+    }
+
+    const int numOutputChannels = bufferToFill.buffer->getNumChannels();
+
+    for (int i = 0; i < numSamples; ++i) {
+        readPosition += ratio;
+
+        const int base = (int)readPosition;
+        const double phasePosition = (readPosition - base) * numPhases;
+        const int phase = juce::jmin(numPhases - 1, (int)phasePosition);
+        const float blend = (float)(phasePosition - phase);
+
+        const float* kernelA = bank->getPhase(phase);
+        const float* kernelB = bank->getPhase(phase + 1);
+        const int first = base - (half - 1);
+
+        for (int channel = 0; channel < numOutputChannels; ++channel) {
+            const float* x = history.getReadPointer(juce::jmin(channel, numChannels - 1), first);
+            const float a = VectorOps::dotProduct(x, kernelA, numTaps);
+            const float b = VectorOps::dotProduct(x, kernelB, numTaps);
+            bufferToFill.buffer->getWritePointer(channel, bufferToFill.startSample + startOffset)[i] = a + blend * (b - a);
+        }
+    }
+
+    compactHistory();
+}
+
+// Shifts the history so it starts at the oldest sample the longest kernel can still reach
+void FusedResamplerAudioSource::compactHistory() {
+    const int keepFrom = (int)readPosition - historyMargin;
+    if (keepFrom <= 0)
+        return;
+
+    const int remaining = historyFilled - keepFrom;
+    for (int channel = 0; channel < numChannels; ++channel) {
+        auto* data = history.getWritePointer(channel);
+        std::memmove(data, data + keepFrom, (size_t)juce::jmax(0, remaining) * sizeof(float));
+    }
+
+    historyFilled = juce::jmax(0, remaining);
+    readPosition -= keepFrom;
+}
@@ -0,0 +1,106 @@
+/*
+  ==============================================================================
+
+    FusedResamplerAudioSource.h
+    Created: 17 Oct 2026 4:20:31pm
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// Single-pass windowed-sinc resampler that applies the file-to-device rate conversion
+// and the deck's speed ratio in one go.
+//
+// Kernels come from precomputed polyphase banks (one per cutoff, shared by every deck), so
+// each output sample costs two SIMD dot products per channel. When the ratio is above 1 a
+// narrower, longer kernel is picked so the source is band-limited before it's decimated.
+class FusedResamplerAudioSource : public juce::AudioSource {
+public:
+
+    // Trade-off between CPU cost and stop-band rejection
+    enum class Quality {
+        draft,      // 8 taps, 64 phases
+        standard,   // 16 taps, 128 phases
+        high        // 32 taps, 256 phases
+    };
+
+    // Constructor: reads from inputSource, optionally taking ownership of it
+    FusedResamplerAudioSource(juce::AudioSource* inputSource, bool deleteInputWhenDeleted, int numChannels = 2);
+
+    // Destructor
+    ~FusedResamplerAudioSource() override;
+
+    // Sets the number of input samples consumed per output sample (audio thread only)
+    void setResamplingRatio(double newRatio);
+
+    // Returns the current resampling ratio
+    double getResamplingRatio() const;
+
+    // Returns how far the input already pulled runs ahead of the last output sample, in input samples (audio thread only)
+    double getBufferedInput() const;
+
+    // Selects the kernel quality (audio thread only)
+    void setQuality(Quality newQuality);
+
+    // Switches to reading from a different, already prepared, source (audio thread only)
+    void setInputSource(juce::AudioSource* newInput);
+
+    // Drops the input history, e.g. after the input has been repositioned (audio thread only)
+    void flushBuffers();
+
+    // Prepares the input and allocates the history buffer
+    void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
+
+    // Releases the input's resources
+    void releaseResources() override;
+
+    // Renders the next block of resampled audio
+    void getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill) override;
+
+    // Highest ratio the kernel banks are designed for (8x decimation)
+    static constexpr double maxRatio = 8.0;
+
+private:
+    struct KernelBank;
+
+    // Returns the shared kernel banks for a quality, building them on first use
+    static const std::vector<KernelBank>& getKernelBanks(Quality quality);
+
+    // Picks the bank whose cutoff suits the current ratio
+    void chooseBank();
+
+    // Renders up to one chunk of output
+    void renderChunk(const juce::AudioSourceChannelInfo& bufferToFill, int startOffset, int numSamples);
+
+    // Discards history that no future kernel will touch
+    void compactHistory();
+
+    // The source being resampled
+    juce::AudioSource* input;
+    std::unique_ptr<juce::AudioSource> ownedInput;
+    const int numChannels;
+
+    double ratio = 1.0;
+    Quality quality = Quality::standard;
+    const std::vector<KernelBank>* banks = nullptr;
+    const KernelBank* bank = nullptr;
+
+    // The shared banks of each quality, looked up in prepareToPlay so setQuality never takes the build lock
+    std::array<const std::vector<KernelBank>*, 3> qualityBanks{};
+
+    // Input samples read but not yet fully consumed, and the position of the next output within them
+    juce::AudioBuffer<float> history;
+    int historyFilled = 0;
+    double readPosition = 0.0;
+
+    // Number of samples of history kept behind the read position (the longest kernel of any quality)
+    int historyMargin = 0;
+
+    // Output is produced in chunks of at most this many samples to bound the history size
+    int maxChunk = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FusedResamplerAudioSource)
+};
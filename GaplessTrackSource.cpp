@@ -0,0 +1,186 @@
+/*
+  ==============================================================================
+
+    GaplessTrackSource.cpp
+    Created: 18 Oct 2026 1:52:19am
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#include "GaplessTrackSource.h"
+
+// Returns the source the track plays from
+juce::PositionableAudioSource& GaplessTrackSource::Track::getSource() {
+    if (readAhead != nullptr)
+        return *readAhead;
+
+    return *readerSource;
+}
+
+// The settings are read under the lock but the buffer fills outside it, so the audio thread carries on meanwhile
+void GaplessTrackSource::prepareTrack(Track& track) {
+    int blockSize = 0;
+    double sampleRate = 0.0;
+    {
+        const juce::ScopedLock sl(lock);
+        if (!prepared)
+            return;
+
+        blockSize = preparedBlockSize;
+        sampleRate = preparedSampleRate;
+    }
+
+    track.getSource().prepareToPlay(blockSize, sampleRate);
+}
+
+// Replaces the playing track
+std::unique_ptr<GaplessTrackSource::Track> GaplessTrackSource::setTrack(std::unique_ptr<Track> newTrack) {
+    const juce::ScopedLock sl(lock);
+    std::swap(current, newTrack);
+    return newTrack;
+}
+
+// Sets the track that follows the playing one
+std::unique_ptr<GaplessTrackSource::Track> GaplessTrackSource::setNextTrack(std::unique_ptr<Track> newNextTrack) {
+    const juce::ScopedLock sl(lock);
+    std::swap(next, newNextTrack);
+    return newNextTrack;
+}
+
+// Returns the track that last played out
+std::unique_ptr<GaplessTrackSource::Track> GaplessTrackSource::takeFinishedTrack() {
+    const juce::ScopedLock sl(lock);
+    return std::move(finished);
+}
+
+// True while a track is waiting to follow the playing one
+bool GaplessTrackSource::hasNextTrack() const {
+    const juce::ScopedLock sl(lock);
+    return next != nullptr;
+}
+
+// The next track was primed from its start, so it takes over on the next block without a seek
+bool GaplessTrackSource::skipToNextTrack() {
+    const juce::ScopedLock sl(lock);
+
+    if (current == nullptr || next == nullptr)
+        return false;
+
+    return advance();
+}
+
+// Starts a next track at a different rate once the playing one has reached its end
+bool GaplessTrackSource::startNextTrackIfPlayedOut() {
+    const juce::ScopedLock sl(lock);
+
+    if (current == nullptr || next == nullptr || next->sampleRate == current->sampleRate)
+        return false;
+
+    auto& source = current->getSource();
+    if (source.getNextReadPosition() < source.getTotalLength() || !advance())
+        return false;
+
+    // The deck resets its resampler for the new rate, so this take-over isn't seamless
+    current->startedGaplessly = false;
+    return true;
+}
+
+// Returns the generation and rate of the playing track
+GaplessTrackSource::PlayingTrack GaplessTrackSource::getPlayingTrack() const {
+    const juce::ScopedLock sl(lock);
+
+    if (current == nullptr)
+        return {};
+
+    return { current->generation, current->sampleRate, current->startedGaplessly };
+}
+
+// Prepares the playing and next tracks, and remembers the settings for tracks prepared later
+void GaplessTrackSource::prepareToPlay(int samplesPerBlockExpected, double sampleRate) {
+    const juce::ScopedLock sl(lock);
+    preparedBlockSize = samplesPerBlockExpected;
+    preparedSampleRate = sampleRate;
+    prepared = true;
+
+    for (auto* track : { current.get(), next.get() })
+        if (track != nullptr)
+            track->getSource().prepareToPlay(samplesPerBlockExpected, sampleRate);
+}
+
+// Releases the playing and next tracks' resources
+void GaplessTrackSource::releaseResources() {
+    const juce::ScopedLock sl(lock);
+    prepared = false;
+
+    for (auto* track : { current.get(), next.get() })
+        if (track != nullptr)
+            track->getSource().releaseResources();
+}
+
+// A block that runs past the end of the playing track takes the rest of its samples from the start
+// of the next one, which its read-ahead already holds
+void GaplessTrackSource::getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill) {
+    const juce::ScopedLock sl(lock);
+
+    if (current == nullptr) {
+        bufferToFill.clearActiveBufferRegion();
+        return;
+    }
+
+    auto& source = current->getSource();
+    const juce::int64 remaining = source.getTotalLength() - source.getNextReadPosition();
+
+    if (next == nullptr || remaining >= bufferToFill.numSamples) {
+        source.getNextAudioBlock(bufferToFill);
+        return;
+    }
+
+    const int fromCurrent = (int)juce::jmax((juce::int64)0, remaining);
+    if (fromCurrent > 0)
+        source.getNextAudioBlock({ bufferToFill.buffer, bufferToFill.startSample, fromCurrent });
+
+    const juce::AudioSourceChannelInfo rest{ bufferToFill.buffer, bufferToFill.startSample + fromCurrent, bufferToFill.numSamples - fromCurrent };
+
+    // A track at another rate waits for startNextTrackIfPlayedOut. The current one holds at its end
+    // rather than reading past it, so the transport keeps running through the silence
+    if (next->sampleRate != current->sampleRate) {
+        rest.clearActiveBufferRegion();
+        return;
+    }
+
+    // With the last track still uncollected the current one plays out into silence, and the transport stops
+    if (advance())
+        current->getSource().getNextAudioBlock(rest);
+    else
+        source.getNextAudioBlock(rest);
+}
+
+// Positions within the playing track
+void GaplessTrackSource::setNextReadPosition(juce::int64 newPosition) {
+    const juce::ScopedLock sl(lock);
+
+    if (current != nullptr)
+        current->getSource().setNextReadPosition(newPosition);
+}
+
+juce::int64 GaplessTrackSource::getNextReadPosition() const {
+    const juce::ScopedLock sl(lock);
+    return current != nullptr ? current->getSource().getNextReadPosition() : 0;
+}
+
+juce::int64 GaplessTrackSource::getTotalLength() const {
+    const juce::ScopedLock sl(lock);
+    return current != nullptr ? current->getSource().getTotalLength() : 0;
+}
+
+// Only pointers move, so this is safe on the audio thread
+bool GaplessTrackSource::advance() {
+    if (finished != nullptr)
+        return false;
+
+    finished = std::move(current);
+    current = std::move(next);
+    current->startedGaplessly = true;
+    return true;
+}
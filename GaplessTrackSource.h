@@ -0,0 +1,110 @@
+/*
+  ==============================================================================
+
+    GaplessTrackSource.h
+    Created: 18 Oct 2026 1:52:19am
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// Plays a deck's track and runs straight on into the next one in its queue.
+//
+// Sits under the deck's transport in place of a single reader source. Every track arrives opened and
+// with its read-ahead already primed, so starting the next one only swaps a pointer on the audio
+// thread: the block that reaches the end of the playing track is finished from the first samples of
+// the next one, with no gap and no file access. The track that played out is parked until the
+// message thread collects it, so nothing is freed on the audio thread.
+//
+// Only a track at the same sample rate takes over mid-block. The deck's resampler can only change
+// its ratio between blocks, so a track at another rate starts at the top of the block after the
+// playing one ends, once the deck calls startNextTrackIfPlayedOut. That leaves a gap of less than a block.
+class GaplessTrackSource : public juce::PositionableAudioSource {
+public:
+
+    // An opened track, with the reader it plays from and optionally a read-ahead buffer in front of it
+    struct Track {
+        juce::URL url;
+        int generation = 0;
+        double sampleRate = 0.0;
+        std::unique_ptr<juce::AudioFormatReaderSource> readerSource;
+        std::unique_ptr<juce::BufferingAudioSource> readAhead;
+
+        // True once the track has taken over from the one before it without a seek
+        bool startedGaplessly = false;
+
+        // Returns the source the track plays from
+        juce::PositionableAudioSource& getSource();
+    };
+
+    // The playing track as the audio thread sees it
+    struct PlayingTrack {
+        int generation = 0;
+        double sampleRate = 0.0;
+        bool startedGaplessly = false;
+    };
+
+    // Constructor
+    GaplessTrackSource() = default;
+
+    // Primes a track's read-ahead for the current block size and rate, so it can start without
+    // touching the disk. Blocks while the buffer fills (not the audio thread).
+    void prepareTrack(Track& track);
+
+    // Replaces the playing track straight away and returns the old one to be freed by the caller (not the audio thread)
+    std::unique_ptr<Track> setTrack(std::unique_ptr<Track> newTrack);
+
+    // Sets the track that follows the playing one and returns the one it replaces (not the audio thread)
+    std::unique_ptr<Track> setNextTrack(std::unique_ptr<Track> newNextTrack);
+
+    // Returns the track that last played out or was skipped, if any, to be freed by the caller (not the audio thread)
+    std::unique_ptr<Track> takeFinishedTrack();
+
+    // True while a track is waiting to follow the playing one (any thread)
+    bool hasNextTrack() const;
+
+    // Starts the next track from its beginning at the start of the next block; false if either track is
+    // missing or the one before is still waiting to be collected (audio thread only, between blocks)
+    bool skipToNextTrack();
+
+    // Starts the next track if it's at a different rate and the playing one has reached its end; true
+    // if it did. Same-rate tracks take over inside getNextAudioBlock instead (audio thread only, between blocks)
+    bool startNextTrackIfPlayedOut();
+
+    // Returns the generation and rate of the playing track (any thread)
+    PlayingTrack getPlayingTrack() const;
+
+    // Prepares the playing and next tracks
+    void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
+
+    // Releases the playing and next tracks' resources
+    void releaseResources() override;
+
+    // Plays the current track, carrying on into the next one at its last sample if their rates match
+    void getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill) override;
+
+    // Positions within the playing track
+    void setNextReadPosition(juce::int64 newPosition) override;
+    juce::int64 getNextReadPosition() const override;
+    juce::int64 getTotalLength() const override;
+    bool isLooping() const override { return false; }
+
+private:
+    // Moves the next track into play and parks the current one; false if the parking slot is taken (lock held)
+    bool advance();
+
+    // Covers the tracks and the prepared settings; the audio thread holds it for one block at a time,
+    // like the transport's own lock
+    juce::CriticalSection lock;
+
+    std::unique_ptr<Track> current, next, finished;
+
+    int preparedBlockSize = 0;
+    double preparedSampleRate = 0.0;
+    bool prepared = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(GaplessTrackSource)
+};
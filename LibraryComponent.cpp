@@ -0,0 +1,181 @@
+/*
+  ==============================================================================
+
+    LibraryComponent.cpp
+    Created: 18 Oct 2026 2:58:06am
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#include "LibraryComponent.h"
+
+// Constructor: Sets up the search box, buttons and results list, and shows whatever index the library already has
+LibraryComponent::LibraryComponent(MusicLibrary& libraryToShow, int decks)
+    : library(libraryToShow), numDecks(decks)
+{
+    searchBox.setTextToShowWhenEmpty("Search library", juce::Colours::grey);
+    searchBox.setComponentID("librarySearch");
+    searchBox.onTextChange = [this] { runQuery(); };
+    searchBox.onReturnKey = [this] { showDeckMenu(resultsList.getSelectedRow() >= 0 ? resultsList.getSelectedRow() : 0); };
+
+    for (auto* button : { &addFolderButton, &rescanButton })
+        button->setColour(juce::TextButton::buttonColourId, juce::Colour::fromRGB(40, 40, 60));  // Dark Slate
+
+    addFolderButton.onClick = [this]
+    {
+        folderChooser.launchAsync(juce::FileBrowserComponent::openMode | juce::FileBrowserComponent::canSelectDirectories,
+            [this](const juce::FileChooser& chooser)
+            {
+                juce::File chosenFolder = chooser.getResult();
+                if (chosenFolder.isDirectory())
+                    library.addFolder(chosenFolder);
+            });
+    };
+    rescanButton.onClick = [this] { library.rescan(); };
+
+    resultsList.setRowHeight(22);
+    resultsList.setColour(juce::ListBox::backgroundColourId, juce::Colour::fromRGB(20, 20, 30));
+    statusLabel.setJustificationType(juce::Justification::centredRight);
+    statusLabel.setColour(juce::Label::textColourId, juce::Colour::fromRGB(230, 230, 250));  // Soft White
+
+    addAndMakeVisible(searchBox);
+    addAndMakeVisible(addFolderButton);
+    addAndMakeVisible(rescanButton);
+    addAndMakeVisible(statusLabel);
+    addAndMakeVisible(resultsList);
+
+    library.addChangeListener(this);
+    changeListenerCallback(&library);
+}
+
+// Destructor
+LibraryComponent::~LibraryComponent()
+{
+    library.removeChangeListener(this);
+}
+
+// paint: Draws the panel background
+void LibraryComponent::paint(juce::Graphics& g)
+{
+    g.fillAll(juce::Colour::fromRGB(30, 30, 45));
+}
+
+// resized: Search box and buttons along the top, results underneath
+void LibraryComponent::resized()
+{
+    auto area = getLocalBounds().reduced(8, 4);
+    auto topRow = area.removeFromTop(26);
+
+    rescanButton.setBounds(topRow.removeFromRight(80));
+    topRow.removeFromRight(4);
+    addFolderButton.setBounds(topRow.removeFromRight(100));
+    statusLabel.setBounds(topRow.removeFromRight(300));
+    searchBox.setBounds(topRow.reduced(0, 1));
+
+    area.removeFromTop(4);
+    resultsList.setBounds(area);
+}
+
+int LibraryComponent::getNumRows()
+{
+    return (int)results.size();
+}
+
+// Artist and title on the left, duration on the right
+void LibraryComponent::paintListBoxItem(int rowNumber, juce::Graphics& g, int width, int height, bool rowIsSelected)
+{
+    if (index == nullptr || rowNumber < 0 || rowNumber >= (int)results.size())
+        return;
+
+    if (rowIsSelected)
+        g.fillAll(juce::Colour::fromRGB(60, 60, 90));
+
+    const auto& track = index->getTracks()[(size_t)results[(size_t)rowNumber]];
+    const int seconds = juce::roundToInt(track.lengthSeconds);
+
+    g.setColour(juce::Colour::fromRGB(230, 230, 250));  // Soft White
+    g.setFont(14.0f);
+    g.drawText(juce::String::formatted("%d:%02d", seconds / 60, seconds % 60), 0, 0, width - 6, height, juce::Justification::centredRight);
+
+    const auto name = track.artist.isNotEmpty() ? track.artist + " - " + track.title : track.title;
+    g.drawText(name, 6, 0, width - 70, height, juce::Justification::centredLeft, true);
+}
+
+void LibraryComponent::listBoxItemDoubleClicked(int row, const juce::MouseEvent&)
+{
+    showDeckMenu(row);
+}
+
+void LibraryComponent::returnKeyPressed(int lastRowSelected)
+{
+    showDeckMenu(lastRowSelected);
+}
+
+// changeListenerCallback: A new index reruns the query; progress only updates the status
+void LibraryComponent::changeListenerCallback(juce::ChangeBroadcaster*)
+{
+    auto latest = library.getIndex();
+
+    if (latest != index)
+    {
+        index = std::move(latest);
+        runQuery();
+        return;
+    }
+
+    updateStatus();
+}
+
+// runQuery: Cheap enough to run on every keystroke, so there is no debounce
+void LibraryComponent::runQuery()
+{
+    const double startMs = juce::Time::getMillisecondCounterHiRes();
+    results = index != nullptr ? index->search(searchBox.getText(), maxResults) : std::vector<int>{};
+    lastQueryMs = juce::Time::getMillisecondCounterHiRes() - startMs;
+
+    resultsList.updateContent();
+    resultsList.repaint();
+    updateStatus();
+}
+
+// updateStatus: Shows the scan's progress while it runs, otherwise the size of the library and the last query's time
+void LibraryComponent::updateStatus()
+{
+    const auto progress = library.getProgress();
+    juce::String text;
+
+    if (progress.scanning)
+    {
+        text << "Scanning: " << progress.filesFound << " files";
+        if (progress.filesToRead > 0)
+            text << ", reading " << progress.filesRead << " of " << progress.filesToRead;
+    }
+    else
+    {
+        const int numTracks = index != nullptr ? (int)index->getTracks().size() : 0;
+        text << (int)results.size() << " of " << numTracks << " tracks in " << juce::String(lastQueryMs, 2) << " ms";
+    }
+
+    statusLabel.setText(text, juce::dontSendNotification);
+}
+
+// showDeckMenu: Load or queue on any deck; the menu runs asynchronously and keeps its own copy of the file
+void LibraryComponent::showDeckMenu(int row)
+{
+    if (index == nullptr || row < 0 || row >= (int)results.size() || onTrackChosen == nullptr)
+        return;
+
+    const auto file = index->getTracks()[(size_t)results[(size_t)row]].getFile();
+    juce::PopupMenu menu;
+
+    for (int deck = 0; deck < numDecks; ++deck)
+        menu.addItem("Load on deck " + juce::String(deck + 1), [this, file, deck] { onTrackChosen(file, deck, false); });
+
+    menu.addSeparator();
+
+    for (int deck = 0; deck < numDecks; ++deck)
+        menu.addItem("Queue on deck " + juce::String(deck + 1), [this, file, deck] { onTrackChosen(file, deck, true); });
+
+    menu.showMenuAsync(juce::PopupMenu::Options().withTargetComponent(&resultsList));
+}
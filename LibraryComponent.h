@@ -0,0 +1,78 @@
+/*
+  ==============================================================================
+
+    LibraryComponent.h
+    Created: 18 Oct 2026 2:58:06am
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "MusicLibrary.h"
+
+// LibraryComponent class
+// A search box over the music library and the tracks matching it. Every keystroke runs the query
+// against the library's latest index on the message thread; double-clicking a track, or pressing
+// return, offers to load it onto a deck or add it to a deck's queue.
+class LibraryComponent : public juce::Component,
+    public juce::ListBoxModel,
+    private juce::ChangeListener
+{
+public:
+    // Most tracks listed for one query
+    static constexpr int maxResults = 500;
+
+    // Constructor: the library must outlive the component; numDecks sets the choices offered for a track
+    LibraryComponent(MusicLibrary& libraryToShow, int numDecks);
+
+    // Destructor
+    ~LibraryComponent() override;
+
+    // Called with a chosen track, the deck it is for, and whether to queue it rather than load it
+    std::function<void(const juce::File& file, int deck, bool queue)> onTrackChosen;
+
+    // paint: Draws the panel background
+    void paint(juce::Graphics& g) override;
+
+    // resized: Search box and buttons along the top, results underneath
+    void resized() override;
+
+    // ListBoxModel: one row per matching track
+    int getNumRows() override;
+    void paintListBoxItem(int rowNumber, juce::Graphics& g, int width, int height, bool rowIsSelected) override;
+    void listBoxItemDoubleClicked(int row, const juce::MouseEvent&) override;
+    void returnKeyPressed(int lastRowSelected) override;
+
+private:
+    // Picks up a new index or scan progress
+    void changeListenerCallback(juce::ChangeBroadcaster*) override;
+
+    // Runs the search box's query against the current index
+    void runQuery();
+
+    // Shows the track count, how long the last query took and any scan in progress
+    void updateStatus();
+
+    // Offers the decks a track can go to
+    void showDeckMenu(int row);
+
+    MusicLibrary& library;
+    const int numDecks;
+
+    std::shared_ptr<const MusicLibrary::Index> index;
+    std::vector<int> results;
+    double lastQueryMs = 0.0;
+
+    juce::TextEditor searchBox;
+    juce::ListBox resultsList{ "Library", this };
+    juce::TextButton addFolderButton{ "ADD FOLDER" };
+    juce::TextButton rescanButton{ "RESCAN" };
+    juce::Label statusLabel;
+
+    juce::FileChooser folderChooser{ "Add a Music Folder.." };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LibraryComponent)
+};
@@ -0,0 +1,197 @@
+/*
+  ==============================================================================
+
+    LoopAudioSource.cpp
+    Created: 17 Oct 2026 11:08:36pm
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#include "LoopAudioSource.h"
+
+// Constructor for LoopAudioSource
+LoopAudioSource::LoopAudioSource(juce::PositionableAudioSource& inputSource, const juce::AudioTransportSource& transportSource, int channels)
+    : input(inputSource), transport(transportSource), numChannels(juce::jmax(1, channels)) {
+
+}
+
+void LoopAudioSource::setLoopIn() {
+    const auto playhead = getNextReadPosition();
+
+    // The capture has to start afresh at the new in point, with the input reading from there
+    if (playingCapture)
+        playFromInput();
+
+    loopStart = playhead;
+    loopEnd = -1;
+    capturedFrames = 0;
+    looping = false;
+}
+
+// A loop longer than the buffer is cut short at the buffer's length
+void LoopAudioSource::setLoopOut() {
+    const auto playhead = getNextReadPosition();
+
+    if (loopStart < 0 || playhead < loopStart + minLoopFrames)
+        return;
+
+    loopEnd = juce::jmin(playhead, loopStart + (juce::int64)maxLoopFrames);
+    looping = true;
+}
+
+void LoopAudioSource::startLoop(juce::int64 lengthInSamples) {
+    setLoopIn();
+
+    const auto length = juce::jlimit((juce::int64)minLoopFrames, (juce::int64)maxLoopFrames, lengthInSamples);
+    loopEnd = juce::jmin(loopStart + length, getTotalLength());
+    looping = loopEnd > loopStart;
+}
+
+// A playhead left beyond the new end wraps back by whole loop lengths, so the loop stays in phase
+void LoopAudioSource::halveLoop() {
+    if (loopStart < 0 || loopEnd < 0)
+        return;
+
+    const auto length = juce::jmax((juce::int64)minLoopFrames, (loopEnd - loopStart) / 2);
+    loopEnd = loopStart + length;
+
+    const auto playhead = getNextReadPosition();
+    if (looping && playhead >= loopEnd)
+        playFromCapture(loopStart + (playhead - loopStart) % length);
+}
+
+void LoopAudioSource::doubleLoop() {
+    if (loopStart < 0 || loopEnd < 0)
+        return;
+
+    const auto length = juce::jmin((juce::int64)maxLoopFrames, (loopEnd - loopStart) * 2);
+    loopEnd = juce::jmin(loopStart + length, getTotalLength());
+}
+
+void LoopAudioSource::exitLoop() {
+    looping = false;
+}
+
+void LoopAudioSource::clearLoop() {
+    if (playingCapture)
+        playFromInput();
+
+    loopStart = -1;
+    loopEnd = -1;
+    capturedFrames = 0;
+    looping = false;
+}
+
+// Called when the device starts, never from the audio thread, so the buffer is allocated here
+void LoopAudioSource::prepareToPlay(int samplesPerBlockExpected, double sampleRate) {
+    input.prepareToPlay(samplesPerBlockExpected, sampleRate);
+    capture.setSize(numChannels, maxLoopFrames);
+    clearLoop();
+}
+
+void LoopAudioSource::releaseResources() {
+    input.releaseResources();
+}
+
+void LoopAudioSource::getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill) {
+    if (loopStart < 0) {
+        input.getNextAudioBlock(bufferToFill);
+        return;
+    }
+
+    // A stopped deck stays where it is in the buffer, silent, as the transport would
+    if (!transport.isPlaying()) {
+        if (playingCapture)
+            bufferToFill.clearActiveBufferRegion();
+        else
+            input.getNextAudioBlock(bufferToFill);
+        return;
+    }
+
+    auto* buffer = bufferToFill.buffer;
+    const int numBufferChannels = buffer->getNumChannels();
+    int done = 0;
+
+    while (done < bufferToFill.numSamples) {
+        const int remaining = bufferToFill.numSamples - done;
+        const int destStart = bufferToFill.startSample + done;
+
+        // Wrap on the exact sample the loop ends at
+        if (looping && getNextReadPosition() >= loopEnd) {
+            playFromCapture(loopStart);
+            continue;
+        }
+
+        if (playingCapture) {
+            const auto captureEnd = loopStart + capturedFrames;
+            const auto stop = looping ? juce::jmin(captureEnd, loopEnd) : captureEnd;
+            const int numFromCapture = (int)juce::jmin((juce::int64)remaining, stop - position);
+
+            // Past the captured audio, e.g. after doubling or leaving the loop: the input is parked right here
+            if (numFromCapture <= 0) {
+                playFromInput();
+                continue;
+            }
+
+            for (int channel = 0; channel < numBufferChannels; ++channel)
+                buffer->copyFrom(channel, destStart, capture, juce::jmin(channel, numChannels - 1), (int)(position - loopStart), numFromCapture);
+
+            position += numFromCapture;
+            done += numFromCapture;
+            continue;
+        }
+
+        const auto playhead = input.getNextReadPosition();
+        const int numFromInput = looping ? (int)juce::jmin((juce::int64)remaining, loopEnd - playhead) : remaining;
+
+        input.getNextAudioBlock(juce::AudioSourceChannelInfo(buffer, destStart, numFromInput));
+
+        // Extend the capture while the input reads exactly where it ends
+        const int numToCapture = juce::jmin(numFromInput, maxLoopFrames - capturedFrames);
+        if (playhead == loopStart + capturedFrames && numToCapture > 0) {
+            for (int channel = 0; channel < numChannels; ++channel)
+                capture.copyFrom(channel, capturedFrames, *buffer, juce::jmin(channel, numBufferChannels - 1), destStart, numToCapture);
+
+            capturedFrames += numToCapture;
+        }
+
+        done += numFromInput;
+    }
+}
+
+void LoopAudioSource::setNextReadPosition(juce::int64 newPosition) {
+    playingCapture = false;
+    clearLoop();
+    input.setNextReadPosition(newPosition);
+}
+
+juce::int64 LoopAudioSource::getNextReadPosition() const {
+    return playingCapture ? position : input.getNextReadPosition();
+}
+
+juce::int64 LoopAudioSource::getTotalLength() const {
+    return input.getTotalLength();
+}
+
+bool LoopAudioSource::isLooping() const {
+    return looping;
+}
+
+// The input isn't read while the buffer plays, so parking it costs nothing audible, and it is
+// only moved at all if it isn't already where the capture ends
+void LoopAudioSource::playFromCapture(juce::int64 newPosition) {
+    position = newPosition;
+    playingCapture = true;
+
+    const auto captureEnd = loopStart + capturedFrames;
+    if (input.getNextReadPosition() != captureEnd)
+        input.setNextReadPosition(captureEnd);
+}
+
+void LoopAudioSource::playFromInput() {
+    playingCapture = false;
+
+    if (input.getNextReadPosition() != position)
+        input.setNextReadPosition(position);
+}
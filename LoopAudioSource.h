@@ -0,0 +1,101 @@
+/*
+  ==============================================================================
+
+    LoopAudioSource.h
+    Created: 17 Oct 2026 11:08:36pm
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// Loops a stretch of its input with sample-accurate wrap points, ahead of the deck's stretcher and
+// resampler so that speed and keylock apply to the loop like to the rest of the track.
+//
+// The first pass through a loop is read from the input as usual and copied into a buffer allocated
+// when the source is prepared; every later pass plays from that buffer while the input stays parked
+// at the end of what has been captured. Wrapping therefore never seeks or reads the file, and when
+// the loop is left, playback runs on through the buffer and back into the input without a seek.
+// Halving a loop reuses the captured audio; doubling one captures the extra half as it plays.
+class LoopAudioSource : public juce::PositionableAudioSource {
+public:
+    // Longest loop the capture buffer holds, about 24 seconds at 44.1 kHz
+    static constexpr int maxLoopFrames = 1 << 20;
+
+    // Shortest loop halving can make
+    static constexpr int minLoopFrames = 32;
+
+    // Constructor: reads input, and stays silent while transport is stopped; both must outlive the source
+    LoopAudioSource(juce::PositionableAudioSource& input, const juce::AudioTransportSource& transport, int numChannels = 2);
+
+    // The loop controls below are for the audio thread only, between blocks
+
+    // Marks the start of a loop at the playhead and starts capturing from there
+    void setLoopIn();
+
+    // Ends the loop marked by setLoopIn at the playhead and starts looping
+    void setLoopOut();
+
+    // Starts a loop of the given length at the playhead
+    void startLoop(juce::int64 lengthInSamples);
+
+    // Halves or doubles the loop, keeping its start
+    void halveLoop();
+    void doubleLoop();
+
+    // Stops wrapping; playback carries on past the end of the loop
+    void exitLoop();
+
+    // Forgets the loop and its captured audio
+    void clearLoop();
+
+    // Loop points at the input's sample rate, -1 when not set
+    juce::int64 getLoopStart() const noexcept { return loopStart; }
+    juce::int64 getLoopEnd() const noexcept { return loopEnd; }
+
+    // Prepares the input and allocates the capture buffer
+    void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
+
+    // Releases the input's resources
+    void releaseResources() override;
+
+    // Renders the next block, wrapping at the end of the loop
+    void getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill) override;
+
+    // Seeks the input and forgets the loop
+    void setNextReadPosition(juce::int64 newPosition) override;
+
+    // Playhead at the input's sample rate, inside the buffer while a loop is playing from it
+    juce::int64 getNextReadPosition() const override;
+
+    juce::int64 getTotalLength() const override;
+
+    // True while the loop is wrapping
+    bool isLooping() const override;
+
+private:
+    // Switches to playing from the buffer at newPosition, parking the input at the end of the capture
+    void playFromCapture(juce::int64 newPosition);
+
+    // Switches back to reading the input at the playhead
+    void playFromInput();
+
+    juce::PositionableAudioSource& input;
+    const juce::AudioTransportSource& transport;
+    const int numChannels;
+
+    // The loop's audio from loopStart onwards, capturedFrames long
+    juce::AudioBuffer<float> capture;
+    int capturedFrames = 0;
+
+    juce::int64 loopStart = -1, loopEnd = -1;
+    bool looping = false;
+
+    // True while playing from the buffer at position; otherwise the input's own position is the playhead
+    bool playingCapture = false;
+    juce::int64 position = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LoopAudioSource)
+};
@@ -0,0 +1,307 @@
+/*
+  ==============================================================================
+
+    LoudnessAnalyser.cpp
+    Created: 18 Oct 2026 3:41:12am
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#include "LoudnessAnalyser.h"
+
+namespace {
+    // Four-lane helpers over whichever instruction set VectorOps found
+    using namespace VectorOps::lanes;
+
+    // Loudness of a mean square K-weighted energy, in LUFS
+    double energyToLufs(double energy) {
+        return -0.691 + 10.0 * std::log10(juce::jmax(energy, 1.0e-20));
+    }
+
+    // Returns the largest absolute sample
+    float largestMagnitude(const float* samples, int numSamples) {
+        const auto range = juce::FloatVectorOperations::findMinAndMax(samples, numSamples);
+        return juce::jmax(-range.getStart(), range.getEnd());
+    }
+}
+
+// The gain is whichever of the target, the ceiling and the boost limit asks for least
+float TrackLoudness::getAutoTrimGain(double targetLufs, double ceilingDb, double maxBoostDb) const {
+    if (!measured)
+        return 1.0f;
+
+    const double gainDb = juce::jmin(targetLufs - integratedLufs, ceilingDb - truePeakDb, maxBoostDb);
+    return (float)std::pow(10.0, gainDb / 20.0);
+}
+
+// Resets the measurement and designs the filters for the track's rate and channels
+void LoudnessAnalyser::decodeStarted(int channels, double sampleRate, juce::int64 lengthInSamples) {
+    numChannels = juce::jmax(1, channels);
+    designKWeighting(sampleRate);
+
+    // Channel weights as BS.1770 gives them for 5.1: none for the LFE, +1.5 dB for the surrounds
+    channelWeights.assign((size_t)numChannels, 1.0f);
+    if (numChannels >= 6) {
+        channelWeights[3] = 0.0f;
+        channelWeights[4] = channelWeights[5] = 1.41f;
+    }
+
+    stepSamples = juce::jmax(1, juce::roundToInt(sampleRate * stepSeconds));
+    samplesInStep = 0;
+    stepEnergy = 0.0;
+    recentSteps.fill(0.0);
+    numSteps = 0;
+    windowEnergies.clear();
+    windowEnergies.reserve((size_t)juce::jmax((juce::int64)0, lengthInSamples / stepSamples) + 1);
+
+    designInterpolator(sampleRate < 96000.0 ? 4 : sampleRate < 192000.0 ? 2 : 1);
+    history.assign((size_t)numChannels, std::vector<float>((size_t)tapsPerPhase - 1, 0.0f));
+    extended.assign((size_t)(tapsPerPhase - 1 + TrackDecoder::blockSize), 0.0f);
+    peak = 0.0f;
+
+    restoredFromCache = false;
+}
+
+// Measures a block of the decode pass
+void LoudnessAnalyser::decodeBlock(const juce::AudioBuffer<float>& buffer, juce::int64 startSample, int numSamples) {
+    juce::ignoreUnused(startSample);
+    if (numSamples <= 0 || buffer.getNumChannels() == 0)
+        return;
+
+    // The high-pass rings down into denormals over silence
+    juce::ScopedNoDenormals noDenormals;
+
+    measureLoudness(buffer, numSamples);
+    measureTruePeak(buffer, numSamples);
+}
+
+// Names the analyser's section in the track cache
+juce::String LoudnessAnalyser::getCacheSectionName() const {
+    return "loudness";
+}
+
+// Writes the result of the pass
+void LoudnessAnalyser::saveToCache(juce::OutputStream& output) {
+    const TrackLoudness result = getResult();
+    output.writeDouble(result.integratedLufs);
+    output.writeDouble(result.truePeakDb);
+    output.writeBool(result.measured);
+}
+
+// Reads back a result written by saveToCache()
+bool LoudnessAnalyser::loadFromCache(juce::InputStream& input) {
+    if (input.getTotalLength() < 2 * (juce::int64)sizeof(double) + 1)
+        return false;
+
+    cachedResult.integratedLufs = input.readDouble();
+    cachedResult.truePeakDb = input.readDouble();
+    cachedResult.measured = input.readBool();
+    restoredFromCache = true;
+    return true;
+}
+
+// Gates the windows kept so far: first at -70 LUFS, then 10 LU under the loudness of what passed
+TrackLoudness LoudnessAnalyser::getResult() const {
+    if (restoredFromCache)
+        return cachedResult;
+
+    TrackLoudness result;
+    result.truePeakDb = 20.0 * std::log10(juce::jmax((double)peak, 1.0e-9));
+
+    double sum = 0.0;
+    int count = 0;
+    for (float energy : windowEnergies) {
+        if (energyToLufs(energy) > absoluteGateLufs) {
+            sum += energy;
+            ++count;
+        }
+    }
+
+    if (count == 0)
+        return result;
+
+    const double relativeGate = energyToLufs(sum / count) + relativeGateLu;
+    double gatedSum = 0.0;
+    int gatedCount = 0;
+    for (float energy : windowEnergies) {
+        const double lufs = energyToLufs(energy);
+        if (lufs > absoluteGateLufs && lufs > relativeGate) {
+            gatedSum += energy;
+            ++gatedCount;
+        }
+    }
+
+    // The relative gate sits under the mean of the blocks it gates, so at least one always passes
+    result.integratedLufs = energyToLufs(gatedSum / juce::jmax(1, gatedCount));
+    result.measured = gatedCount > 0;
+    return result;
+}
+
+// Coefficients from the analogue prototypes behind BS.1770's 48 kHz tables, so any rate gets the same curve
+void LoudnessAnalyser::designKWeighting(double sampleRate) {
+    const double pi = juce::MathConstants<double>::pi;
+
+    // Stage 1: high shelf, +4 dB above about 1.7 kHz
+    double k = std::tan(pi * 1681.974450955533 / sampleRate);
+    double q = 0.7071752369554196;
+    const double vh = std::pow(10.0, 3.999843853973347 / 20.0);
+    const double vb = std::pow(vh, 0.4996667741545416);
+    double a0 = 1.0 + k / q + k * k;
+    const double shelf[5] = { (vh + vb * k / q + k * k) / a0, 2.0 * (k * k - vh) / a0, (vh - vb * k / q + k * k) / a0,
+                              2.0 * (k * k - 1.0) / a0, (1.0 - k / q + k * k) / a0 };
+
+    // Stage 2: the RLB high-pass at about 38 Hz
+    k = std::tan(pi * 38.13547087602444 / sampleRate);
+    q = 0.5003270373238773;
+    a0 = 1.0 + k / q + k * k;
+    const double highPass[5] = { 1.0, -2.0, 1.0, 2.0 * (k * k - 1.0) / a0, (1.0 - k / q + k * k) / a0 };
+
+    kWeighting.assign((size_t)(numChannels + 1) / 2, KWeightingLanes());
+    for (auto& pair : kWeighting) {
+        float* coefficients[5] = { pair.b0, pair.b1, pair.b2, pair.a1, pair.a2 };
+        for (int c = 0; c < 5; ++c) {
+            coefficients[c][0] = coefficients[c][1] = (float)shelf[c];
+            coefficients[c][2] = coefficients[c][3] = (float)highPass[c];
+        }
+    }
+}
+
+// Blackman-windowed sinc cut off at the original Nyquist, split into one filter per output phase
+void LoudnessAnalyser::designInterpolator(int factor) {
+    oversampling = juce::jmin(factor, 4);
+    for (auto& tap : interpolatorTaps)
+        std::fill(std::begin(tap), std::end(tap), 0.0f);
+
+    if (oversampling <= 1)
+        return;
+
+    const int length = tapsPerPhase * oversampling;
+    const double centre = (length - 1) * 0.5;
+    const double pi = juce::MathConstants<double>::pi;
+
+    for (int phase = 0; phase < oversampling; ++phase) {
+        double taps[tapsPerPhase];
+        double sum = 0.0;
+
+        for (int tap = 0; tap < tapsPerPhase; ++tap) {
+            const int n = tap * oversampling + phase;
+            const double x = (n - centre) / oversampling;
+            const double sinc = std::abs(x) < 1.0e-9 ? 1.0 : std::sin(pi * x) / (pi * x);
+            const double window = 0.42 - 0.5 * std::cos(2.0 * pi * n / (length - 1)) + 0.08 * std::cos(4.0 * pi * n / (length - 1));
+            taps[tap] = sinc * window;
+            sum += taps[tap];
+        }
+
+        // Each phase passes DC at unity, so a full-scale constant reads 0 dBTP
+        for (int tap = 0; tap < tapsPerPhase; ++tap)
+            interpolatorTaps[tap][phase] = (float)(taps[tap] / sum);
+    }
+}
+
+// Runs both K-weighting stages over each channel pair up to every step boundary in the block
+void LoudnessAnalyser::measureLoudness(const juce::AudioBuffer<float>& buffer, int numSamples) {
+    const int channels = juce::jmin(numChannels, buffer.getNumChannels());
+
+    int i = 0;
+    while (i < numSamples) {
+        const int count = juce::jmin(stepSamples - samplesInStep, numSamples - i);
+
+        for (int first = 0; first < channels; first += 2) {
+            const int second = juce::jmin(first + 1, channels - 1);
+            const float* left = buffer.getReadPointer(first, i);
+            const float* right = buffer.getReadPointer(second, i);
+            auto& pair = kWeighting[(size_t)first / 2];
+
+            // Lanes 0 and 1 of the output are this sample's shelf, which the high-pass takes next
+            BiquadRegisters filter(pair);
+            Lanes output = load(pair.output);
+            Lanes energy = splat(0.0f);
+
+            for (int n = 0; n < count; ++n) {
+                output = filter.process(lowerHalves(set(left[n], right[n], 0.0f, 0.0f), output));
+                energy = add(energy, mul(output, output));
+            }
+
+            filter.saveState(pair);
+            store(pair.output, output);
+
+            // A lone last channel runs in both lanes but only counts once
+            const Lanes weighted = upperHalves(energy);
+            stepEnergy += channelWeights[(size_t)first] * lane0(weighted);
+            if (second != first)
+                stepEnergy += channelWeights[(size_t)second] * lane1(weighted);
+        }
+
+        i += count;
+        samplesInStep += count;
+
+        if (samplesInStep == stepSamples)
+            finishStep();
+    }
+}
+
+// Every input sample is multiplied into all the phases' taps at once; the lanes' running minimum
+// and maximum give the peak at the end of the block
+void LoudnessAnalyser::measureTruePeak(const juce::AudioBuffer<float>& buffer, int numSamples) {
+    const int channels = juce::jmin(numChannels, buffer.getNumChannels());
+    const int historySize = tapsPerPhase - 1;
+
+    if ((int)extended.size() < historySize + numSamples)
+        extended.resize((size_t)(historySize + numSamples));
+
+    for (int channel = 0; channel < channels; ++channel) {
+        const float* input = buffer.getReadPointer(channel);
+        peak = juce::jmax(peak, largestMagnitude(input, numSamples));
+
+        if (oversampling <= 1)
+            continue;
+
+        // The last samples of the previous block, then this one, so every tap has an input
+        auto& past = history[(size_t)channel];
+        std::copy(past.begin(), past.end(), extended.begin());
+        juce::FloatVectorOperations::copy(extended.data() + historySize, input, numSamples);
+
+        Lanes taps[tapsPerPhase];
+        for (int tap = 0; tap < tapsPerPhase; ++tap)
+            taps[tap] = load(interpolatorTaps[tap]);
+
+        Lanes lowest = splat(0.0f), highest = splat(0.0f);
+        for (int n = 0; n < numSamples; ++n) {
+            const float* newest = extended.data() + historySize + n;
+            // Two partial sums halve the chain of dependent adds
+            Lanes even = mul(taps[0], splat(newest[0]));
+            Lanes odd = mul(taps[1], splat(newest[-1]));
+            for (int tap = 2; tap < tapsPerPhase; tap += 2) {
+                even = add(even, mul(taps[tap], splat(newest[-tap])));
+                odd = add(odd, mul(taps[tap + 1], splat(newest[-tap - 1])));
+            }
+            const Lanes output = add(even, odd);
+
+            lowest = min(lowest, output);
+            highest = max(highest, output);
+        }
+
+        alignas(16) float lows[4], highs[4];
+        store(lows, lowest);
+        store(highs, highest);
+        for (int phase = 0; phase < 4; ++phase)
+            peak = juce::jmax(peak, -lows[phase], highs[phase]);
+
+        std::copy(extended.begin() + numSamples, extended.begin() + numSamples + historySize, past.begin());
+    }
+}
+
+// Windows overlap by three steps, so each one after the third completes a window
+void LoudnessAnalyser::finishStep() {
+    recentSteps[(size_t)(numSteps % 4)] = stepEnergy;
+    ++numSteps;
+
+    if (numSteps >= 4) {
+        const double windowEnergy = recentSteps[0] + recentSteps[1] + recentSteps[2] + recentSteps[3];
+        windowEnergies.push_back((float)(windowEnergy / (4.0 * stepSamples)));
+    }
+
+    stepEnergy = 0.0;
+    samplesInStep = 0;
+}
@@ -0,0 +1,123 @@
+/*
+  ==============================================================================
+
+    LoudnessAnalyser.h
+    Created: 18 Oct 2026 3:41:12am
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "TrackDecoder.h"
+#include "VectorOps.h"
+#include <array>
+
+// Integrated loudness and true peak of a track, small enough to copy freely between threads
+struct TrackLoudness {
+    // Loudness of the whole track in LUFS, gated as EBU R128 describes
+    double integratedLufs = 0.0;
+
+    // Highest level of the 4x oversampled signal, in dB relative to full scale
+    double truePeakDb = 0.0;
+
+    // False until a track has been measured, and for tracks too short or too quiet to measure
+    bool measured = false;
+
+    // Returns the gain that brings the track to targetLufs, reduced so its true peak stays under
+    // ceilingDb and limited to maxBoostDb of boost; 1 if the track hasn't been measured
+    float getAutoTrimGain(double targetLufs, double ceilingDb, double maxBoostDb) const;
+};
+
+// Measures a track's integrated loudness (ITU-R BS.1770-4, as used by EBU R128) and true peak
+// during the deck's decode pass, so normalising the track costs no extra read of the file.
+//
+// Each channel is K-weighted by the standard's high shelf and high-pass in series. The two
+// stages run as one four-lane SIMD biquad, two channels at a time: lanes 0 and 1 hold the shelf
+// of each channel and lanes 2 and 3 the high-pass, fed with the shelf's output from the sample
+// before. The weighted energy is summed over 100 ms steps, and every 400 ms window of four steps
+// is kept for the absolute and relative gates once the track ends. The true peak is the peak of
+// the signal interpolated to four times the rate (twice above 96 kHz) by a polyphase windowed
+// sinc whose phases share one SIMD register, so each input sample yields all of its outputs at once.
+class LoudnessAnalyser : public TrackDecodeConsumer {
+public:
+
+    // Gating block and the step between blocks, and the gates themselves
+    static constexpr double blockSeconds = 0.4;
+    static constexpr double stepSeconds = 0.1;
+    static constexpr double absoluteGateLufs = -70.0;
+    static constexpr double relativeGateLu = -10.0;
+
+    // Taps per phase of the true-peak interpolator
+    static constexpr int tapsPerPhase = 12;
+
+    // Constructor
+    LoudnessAnalyser() = default;
+
+    // TrackDecodeConsumer: a decode pass measures every block as it goes
+    void decodeStarted(int numChannels, double sampleRate, juce::int64 lengthInSamples) override;
+    void decodeBlock(const juce::AudioBuffer<float>& buffer, juce::int64 startSample, int numSamples) override;
+
+    // TrackDecodeConsumer: only the result is cached
+    juce::String getCacheSectionName() const override;
+    void saveToCache(juce::OutputStream& output) override;
+    bool loadFromCache(juce::InputStream& input) override;
+
+    // Returns the measurement of everything fed in so far, or the one loaded from the cache
+    TrackLoudness getResult() const;
+
+private:
+    // K-weighting for a pair of channels; lanes 0 and 1 are the shelf, lanes 2 and 3 the high-pass.
+    // output holds the last sample's outputs, whose lanes 0 and 1 feed the high-pass next
+    struct KWeightingLanes {
+        alignas(16) float b0[4]{}, b1[4]{}, b2[4]{}, a1[4]{}, a2[4]{};
+        alignas(16) float s1[4]{}, s2[4]{};
+        alignas(16) float output[4]{};
+    };
+
+    // Sets the K-weighting coefficients of every channel pair for a sample rate
+    void designKWeighting(double sampleRate);
+
+    // Builds the true-peak interpolator's phases for an oversampling factor
+    void designInterpolator(int factor);
+
+    // Adds a block's K-weighted energy, closing every step it completes
+    void measureLoudness(const juce::AudioBuffer<float>& buffer, int numSamples);
+
+    // Raises the true peak to the block's highest interpolated sample
+    void measureTruePeak(const juce::AudioBuffer<float>& buffer, int numSamples);
+
+    // Ends the current step and, once there are four, keeps the energy of the window they make
+    void finishStep();
+
+    int numChannels = 0;
+
+    // K-weighting, one entry per pair of channels, and each channel's weight in the sum (0 for LFE)
+    std::vector<KWeightingLanes> kWeighting;
+    std::vector<float> channelWeights;
+
+    // Samples per step, how far into the current one the pass is, and its weighted energy so far
+    int stepSamples = 1;
+    int samplesInStep = 0;
+    double stepEnergy = 0.0;
+
+    // Energies of the last four steps, and the mean square of every 400 ms window so far
+    std::array<double, 4> recentSteps{};
+    int numSteps = 0;
+    std::vector<float> windowEnergies;
+
+    // Interpolator taps with one lane per output phase (unused lanes are zero), the last input
+    // samples of every channel, and room for them ahead of a block
+    int oversampling = 1;
+    alignas(16) float interpolatorTaps[tapsPerPhase][4]{};
+    std::vector<std::vector<float>> history;
+    std::vector<float> extended;
+    float peak = 0.0f;
+
+    // Result restored by loadFromCache(), returned instead of measuring
+    TrackLoudness cachedResult;
+    bool restoredFromCache = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LoudnessAnalyser)
+};
@@ -1,87 +1,274 @@
-
-
-#include "MainComponent.h"
-
-//==============================================================================
-// Constructor for MainComponent
-// Initializes the main interface, sets up audio sources, and configures UI elements
-MainComponent::MainComponent()
-{
-    // Set the initial size of the main window
-    setSize(800, 600);
-
-    // Request microphone permission if required by the platform
-    if (juce::RuntimePermissions::isRequired(juce::RuntimePermissions::recordAudio)
-        && !juce::RuntimePermissions::isGranted(juce::RuntimePermissions::recordAudio))
-    {
-        juce::RuntimePermissions::request(juce::RuntimePermissions::recordAudio,
-            [&](bool granted)
-            {
-                // If permission is granted, open 2 input and 2 output channels; otherwise, no input
-                setAudioChannels(granted ? 2 : 0, 2);
-            });
-    }
-    else
-    {
-        // Open 2 input and 2 output channels if no permission is needed
-        setAudioChannels(2, 2);
-    }
-
-    // Make GUI components visible
-    addAndMakeVisible(GUI1);
-    addAndMakeVisible(GUI2);
-
-    // Register basic audio formats (e.g., WAV, MP3)
-    formatManager.registerBasicFormats();
-}
-
-// Destructor for MainComponent
-// Releases audio resources
-MainComponent::~MainComponent()
-{
-    shutdownAudio();  // Clean up audio resources
-}
-
-//==============================================================================
-// prepareToPlay: Prepares audio sources before playback begins
-// Configures the mixer source to manage multiple audio streams
-void MainComponent::prepareToPlay(int samplesPerBlockExpected, double sampleRate)
-{
-    // Add audio players to the mixer source without taking ownership
-    mixerSource.addInputSource(&player1, false);
-    mixerSource.addInputSource(&player2, false);
-
-    // Prepare mixer source with expected samples per block and sample rate
-    mixerSource.prepareToPlay(samplesPerBlockExpected, sampleRate);
-}
-
-// getNextAudioBlock: Called repeatedly to supply audio data for playback
-void MainComponent::getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill)
-{
-    mixerSource.getNextAudioBlock(bufferToFill);  // Fill buffer with audio data
-}
-
-// releaseResources: Releases resources allocated for audio playback
-void MainComponent::releaseResources()
-{
-    player1.releaseResources();     // Release resources for player 1
-    player2.releaseResources();     // Release resources for player 2
-
-    mixerSource.releaseResources(); // Release resources for mixer source
-}
-
-//==============================================================================
-// paint: Draws the background and other UI elements
-void MainComponent::paint(juce::Graphics& g)
-{
-    // Fill background with a solid color
-    g.fillAll(getLookAndFeel().findColour(juce::ResizableWindow::backgroundColourId));
-}
-
-// resized: Arranges UI components when the window size changes
-void MainComponent::resized()
-{
-    // Set bounds for GUI1 and GUI2 to divide the window into two halves
-    GUI1.setBounds(0, 0, getWidth() / 2, getHeight());
-    GUI2.setBounds(getWidth() / 2, 0, getWidth() / 2, getHeight());
-}
+
+
+#include "MainComponent.h"
+
+//==============================================================================
+// Constructor for MainComponent
+// Initializes the main interface, sets up audio sources, and configures UI elements
+MainComponent::MainComponent(int numDecks, bool openAudioDevice)
+{
+    numDecks = juce::jlimit(DeckMixer::minDecks, DeckMixer::maxDecks, numDecks);
+
+    // Create the decks; the left half of them sits on the left of the crossfader, the rest on the right
+    for (int i = 0; i < numDecks; ++i)
+    {
+        auto* player = players.add(new DJAudioPlayer(&trackCache));
+        deckGUIs.add(new DeckGUI(player, formatManager, thumbnailCache));
+        mixer.addDeck(player, i < numDecks / 2 ? DeckMixer::CrossfaderSide::left : DeckMixer::CrossfaderSide::right);
+    }
+
+    // MIDI controllers use the mapping in the app's data folder if there is one, otherwise one channel per deck
+    midiInput = std::make_unique<MidiControllerInput>(deviceManager, mixer, std::vector<DJAudioPlayer*>(players.begin(), players.end()));
+
+    const auto mappingFile = MidiMapping::getDefaultFile();
+    if (mappingFile.existsAsFile())
+    {
+        MidiMapping mapping;
+        auto result = mapping.loadFrom(mappingFile);
+
+        if (result.wasOk())
+            midiInput->setMapping(mapping);
+        else
+            juce::Logger::outputDebugString("MainComponent: ignoring " + mappingFile.getFullPathName() + ": " + result.getErrorMessage() + "\n");
+    }
+
+    // Tracks chosen in the library go through the deck's GUI, so its waveforms follow them
+    libraryPanel = std::make_unique<LibraryComponent>(library, numDecks);
+    libraryPanel->onTrackChosen = [this](const juce::File& file, int deck, bool queue)
+    {
+        if (queue)
+            deckGUIs[deck]->queueTracks({ file });
+        else
+            deckGUIs[deck]->loadTrack(juce::URL{ file });
+    };
+
+    // Crossfader starts in the middle, where both sides play at full level
+    crossfaderSlider.setRange(0.0, 1.0);
+    crossfaderSlider.setValue(0.5, juce::dontSendNotification);
+    crossfaderSlider.setColour(juce::Slider::thumbColourId, juce::Colour::fromRGB(230, 230, 250));
+    crossfaderSlider.addListener(this);
+    crossfaderSlider.setComponentID("crossfader");
+    crossfaderLabel.setJustificationType(juce::Justification::centred);
+
+    // REC lights up while the master output is being recorded
+    recordButton.setColour(juce::TextButton::buttonColourId, juce::Colour::fromRGB(40, 40, 60));  // Dark Slate
+    recordButton.setColour(juce::TextButton::buttonOnColourId, juce::Colour::fromRGB(255, 32, 78));  // Red
+    recordButton.setComponentID("record");
+    recordButton.onClick = [this] { toggleRecording(); };
+    recordStatusLabel.setJustificationType(juce::Justification::centredRight);
+    recordStatusLabel.setColour(juce::Label::textColourId, juce::Colour::fromRGB(230, 230, 250));  // Soft White
+
+    // Set the initial size of the main window: up to four decks per row, crossfader and library underneath
+    int columns = juce::jmin(numDecks, 4);
+    int rows = (numDecks + columns - 1) / columns;
+    setSize(400 * columns, 600 * rows + 40 + libraryHeight);
+
+    // Open the audio device, unless the caller is going to drive the audio callbacks itself
+    if (openAudioDevice)
+    {
+        // Request microphone permission if required by the platform
+        if (juce::RuntimePermissions::isRequired(juce::RuntimePermissions::recordAudio)
+            && !juce::RuntimePermissions::isGranted(juce::RuntimePermissions::recordAudio))
+        {
+            juce::RuntimePermissions::request(juce::RuntimePermissions::recordAudio,
+                [&](bool granted)
+                {
+                    // If permission is granted, open 2 input and 2 output channels; otherwise, no input
+                    setAudioChannels(granted ? 2 : 0, 2);
+                });
+        }
+        else
+        {
+            // Open 2 input and 2 output channels if no permission is needed
+            setAudioChannels(2, 2);
+        }
+    }
+
+    // Controllers only matter when there is a device to hear them on
+    if (openAudioDevice)
+        midiInput->openAllInputs();
+
+    // Make GUI components visible
+    for (auto* deckGUI : deckGUIs)
+        addAndMakeVisible(deckGUI);
+
+    addAndMakeVisible(crossfaderSlider);
+    addAndMakeVisible(crossfaderLabel);
+    addAndMakeVisible(recordButton);
+    addAndMakeVisible(recordStatusLabel);
+    addAndMakeVisible(*libraryPanel);
+
+    // The overlay is hidden until asked for, but keeps collecting timings either way
+    addChildComponent(profilerOverlay);
+    setWantsKeyboardFocus(true);
+    startTimerHz(10);
+
+    // Register basic audio formats (e.g., WAV, MP3)
+    formatManager.registerBasicFormats();
+
+    // The saved library index loads on the library's own thread and is rescanned there, so startup doesn't wait for either.
+    // A headless run leaves the user's library and its index file alone
+    if (openAudioDevice)
+        library.rescan();
+}
+
+// Destructor for MainComponent
+// Releases audio resources
+MainComponent::~MainComponent()
+{
+    shutdownAudio();  // Clean up audio resources
+    recorder.stop();  // Finish any recording once the audio thread has stopped feeding it
+
+    // Leave the session's audio thread profile in the log
+    profilerOverlay.dumpToLog();
+}
+
+//==============================================================================
+// prepareToPlay: Prepares audio sources before playback begins
+// The mixer prepares every deck and starts its render threads
+void MainComponent::prepareToPlay(int samplesPerBlockExpected, double sampleRate)
+{
+    currentSampleRate = sampleRate;
+    mixer.prepareToPlay(samplesPerBlockExpected, sampleRate);
+}
+
+// getNextAudioBlock: Called repeatedly to supply audio data for playback
+void MainComponent::getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill)
+{
+    const auto startTicks = AudioProfiler::now();
+    mixer.getNextAudioBlock(bufferToFill);  // Fill buffer with audio data
+    recorder.pushBlock(*bufferToFill.buffer, bufferToFill.startSample, bufferToFill.numSamples);
+
+    // Time the callback against the block's deadline and record every deck's share of it
+    AudioProfiler::CallbackTiming timing;
+    timing.callbackMicros = AudioProfiler::microsBetween(startTicks, AudioProfiler::now());
+    timing.budgetMicros = currentSampleRate > 0.0 ? (float)(bufferToFill.numSamples * 1.0e6 / currentSampleRate) : 0.0f;
+    timing.numDecks = mixer.getNumDecks();
+
+    for (int deck = 0; deck < timing.numDecks; ++deck)
+    {
+        timing.deckMicros[(size_t)deck] = mixer.getDeckRenderMicros(deck);
+        timing.controllerLatencyMicros = juce::jmax(timing.controllerLatencyMicros, players[deck]->takeControllerLatencyMicros());
+    }
+
+    lastCallbackTiming = timing;
+    profiler.recordCallback(timing);
+}
+
+// releaseResources: Releases resources allocated for audio playback
+void MainComponent::releaseResources()
+{
+    mixer.releaseResources();  // Releases every deck as well
+}
+
+//==============================================================================
+// paint: Draws the background and other UI elements
+void MainComponent::paint(juce::Graphics& g)
+{
+    // Fill background with a solid color
+    g.fillAll(getLookAndFeel().findColour(juce::ResizableWindow::backgroundColourId));
+}
+
+// resized: Arranges UI components when the window size changes
+void MainComponent::resized()
+{
+    // Library panel along the bottom, crossfader strip above it
+    auto area = getLocalBounds();
+    libraryPanel->setBounds(area.removeFromBottom(libraryHeight));
+
+    auto crossfaderArea = area.removeFromBottom(40).reduced(8, 4);
+    crossfaderLabel.setBounds(crossfaderArea.removeFromLeft(80));
+    recordButton.setBounds(crossfaderArea.removeFromRight(60));
+    recordStatusLabel.setBounds(crossfaderArea.removeFromRight(220));
+    crossfaderSlider.setBounds(crossfaderArea.withSizeKeepingCentre(juce::jmin(400, crossfaderArea.getWidth()), crossfaderArea.getHeight()));
+
+    // Decks in a grid of up to four columns, filling the rest of the window
+    int numDecks = deckGUIs.size();
+    int columns = juce::jmin(numDecks, 4);
+    int rows = (numDecks + columns - 1) / columns;
+    int deckWidth = area.getWidth() / columns;
+    int deckHeight = area.getHeight() / rows;
+
+    for (int i = 0; i < numDecks; ++i)
+        deckGUIs[i]->setBounds(area.getX() + (i % columns) * deckWidth, area.getY() + (i / columns) * deckHeight, deckWidth, deckHeight);
+
+    // Profiler overlay in the top-right corner, over the decks
+    auto overlayBounds = ProfilerOverlay::getPreferredBounds(numDecks);
+    profilerOverlay.setBounds(overlayBounds.withPosition(getWidth() - overlayBounds.getWidth() - 8, 8));
+}
+
+// sliderValueChanged: Passes crossfader movements to the mixer
+void MainComponent::sliderValueChanged(juce::Slider* slider)
+{
+    if (slider == &crossfaderSlider)
+        mixer.setCrossfader(static_cast<float>(slider->getValue()));
+}
+
+// toggleRecording: Each recording gets a new file named after the time it started
+void MainComponent::toggleRecording()
+{
+    if (recorder.isRecording())
+    {
+        recorder.stop();
+        timerCallback();
+        return;
+    }
+
+    auto file = juce::File::getSpecialLocation(juce::File::userMusicDirectory)
+        .getChildFile("OtoDesks Sets")
+        .getChildFile("Set " + juce::Time::getCurrentTime().formatted("%Y-%m-%d %H-%M-%S") + ".wav");
+
+    auto result = recorder.start(file, currentSampleRate);
+    if (result.failed())
+    {
+        juce::Logger::outputDebugString("MainComponent: cannot record: " + result.getErrorMessage() + "\n");
+        recordStatusLabel.setText("Cannot record", juce::dontSendNotification);
+        return;
+    }
+
+    timerCallback();
+}
+
+// timerCallback: Mirrors the crossfader, then shows the recording time, how full the FIFO has been at worst and any dropped audio
+void MainComponent::timerCallback()
+{
+    // A controller moves the crossfader without going through the slider
+    if (!crossfaderSlider.isMouseButtonDown())
+        crossfaderSlider.setValue(mixer.getCrossfader(), juce::dontSendNotification);
+
+    // Only a recording in progress, or one that has just stopped, needs its status redrawn
+    const auto stats = recorder.getStats();
+    if (!stats.recording && !recordButton.getToggleState())
+        return;
+
+    recordButton.setToggleState(stats.recording, juce::dontSendNotification);
+
+    const int seconds = stats.sampleRate > 0.0 ? (int)(stats.framesWritten / stats.sampleRate) : 0;
+    juce::String text = (stats.recording ? "REC " : "Saved ")
+        + juce::String::formatted("%d:%02d", seconds / 60, seconds % 60)
+        + "  FIFO peak " + juce::String(100 * stats.fifoHighWater / juce::jmax(1, stats.fifoCapacity)) + "%";
+
+    if (stats.framesDropped > 0)
+        text << "  dropped " << juce::String(stats.framesDropped);
+
+    recordStatusLabel.setText(text, juce::dontSendNotification);
+    recordStatusLabel.setColour(juce::Label::textColourId, stats.framesDropped > 0 ? juce::Colour::fromRGB(255, 32, 78) : juce::Colour::fromRGB(230, 230, 250));
+}
+
+// keyPressed: Shortcuts for the audio profiler
+bool MainComponent::keyPressed(const juce::KeyPress& key)
+{
+    if (key.getTextCharacter() == 'p' || key.getTextCharacter() == 'P')
+    {
+        profilerOverlay.setVisible(!profilerOverlay.isVisible());
+        return true;
+    }
+
+    if (key.getTextCharacter() == 'l' || key.getTextCharacter() == 'L')
+    {
+        profilerOverlay.dumpToLog();
+        return true;
+    }
+
+    return false;
+}
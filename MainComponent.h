@@ -1,58 +1,120 @@
-#pragma once
-
-#include <JuceHeader.h>
-#include "djAudioPlayer.h"
-#include "DeckGUI.h"
-
-// MainComponent class
-// Manages the main application interface, including deck GUIs and audio management
-class MainComponent : public juce::AudioAppComponent
-{
-public:
-    //==============================================================================
-    // Constructor: Initializes MainComponent and sets up audio channels
-    MainComponent();
-
-    // Destructor: Cleans up audio resources
-    ~MainComponent() override;
-
-    //==============================================================================
-    // prepareToPlay: Called before audio playback starts
-    // Configures sample rate and buffer size
-    void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
-
-    // getNextAudioBlock: Called repeatedly to fill buffers with audio data
-    void getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill) override;
-
-    // releaseResources: Releases resources allocated for audio playback
-    void releaseResources() override;
-
-    //==============================================================================
-    // paint: Draws the background and other UI elements
-    void paint(juce::Graphics& g) override;
-
-    // resized: Arranges UI components when the window size changes
-    void resized() override;
-
-private:
-    //==============================================================================
-    // Audio format manager: Handles audio file formats (e.g., WAV, MP3)
-    juce::AudioFormatManager formatManager;
-
-    // Audio thumbnail cache: Caches waveforms for faster display
-    juce::AudioThumbnailCache thumbnailCache{ 100 };
-
-    // Audio players for each deck
-    DJAudioPlayer player1;  // Manages playback for deck 1
-    DJAudioPlayer player2;  // Manages playback for deck 2
-
-    // GUI components for each deck
-    DeckGUI GUI1{ &player1, formatManager, thumbnailCache };  // GUI for deck 1
-    DeckGUI GUI2{ &player2, formatManager, thumbnailCache };  // GUI for deck 2
-
-    // Mixer source: Combines audio from both decks for output
-    juce::MixerAudioSource mixerSource;
-
-    // Prevents copying and assignment of MainComponent
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MainComponent)
-};
+#pragma once
+
+#include <JuceHeader.h>
+#include "djAudioPlayer.h"
+#include "DeckGUI.h"
+#include "DeckMixer.h"
+#include "AudioProfiler.h"
+#include "ProfilerOverlay.h"
+#include "MasterRecorder.h"
+#include "MidiControllerInput.h"
+#include "MusicLibrary.h"
+#include "LibraryComponent.h"
+
+// MainComponent class
+// Manages the main application interface, including deck GUIs and audio management
+class MainComponent : public juce::AudioAppComponent,
+    public juce::Slider::Listener,
+    private juce::Timer
+{
+public:
+    //==============================================================================
+    // Constructor: Initializes MainComponent with numDecks decks (2 to 8) and sets up audio channels.
+    // Without openAudioDevice no device is opened, and the caller drives the audio callbacks itself
+    explicit MainComponent(int numDecks = 2, bool openAudioDevice = true);
+
+    // Destructor: Cleans up audio resources
+    ~MainComponent() override;
+
+    //==============================================================================
+    // prepareToPlay: Called before audio playback starts
+    // Configures sample rate and buffer size
+    void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
+
+    // getNextAudioBlock: Called repeatedly to fill buffers with audio data
+    void getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill) override;
+
+    // releaseResources: Releases resources allocated for audio playback
+    void releaseResources() override;
+
+    //==============================================================================
+    // paint: Draws the background and other UI elements
+    void paint(juce::Graphics& g) override;
+
+    // resized: Arranges UI components when the window size changes
+    void resized() override;
+
+    // Handles crossfader movements
+    void sliderValueChanged(juce::Slider* slider) override;
+
+    // Access to the decks, for automation such as the soak test
+    int getNumDecks() const { return deckGUIs.size(); }
+    DeckGUI* getDeckGUI(int index) const { return deckGUIs[index]; }
+    DJAudioPlayer* getPlayer(int index) const { return players[index]; }
+
+    // Timing of the most recent audio callback (audio thread only, after getNextAudioBlock has returned)
+    const AudioProfiler::CallbackTiming& getLastCallbackTiming() const { return lastCallbackTiming; }
+
+    // Starts recording the master output to a new file in the user's music folder, or stops the recording
+    void toggleRecording();
+
+    // keyPressed: P shows or hides the audio profiler overlay, L writes its report to the log
+    bool keyPressed(const juce::KeyPress& key) override;
+
+private:
+    // Height of the library panel along the bottom of the window
+    static constexpr int libraryHeight = 200;
+
+    // timerCallback: Shows the recorder's progress next to the REC button and mirrors the crossfader
+    void timerCallback() override;
+
+    //==============================================================================
+    // Audio format manager: Handles audio file formats (e.g., WAV, MP3)
+    juce::AudioFormatManager formatManager;
+
+    // Audio thumbnail cache: Caches waveforms for faster display
+    juce::AudioThumbnailCache thumbnailCache{ 100 };
+
+    // Track cache: Keeps waveforms and beat grids on disk so known tracks load without decoding
+    TrackCache trackCache{ TrackCache::getDefaultDirectory() };
+
+    // Audio players for each deck
+    juce::OwnedArray<DJAudioPlayer> players;
+
+    // GUI components for each deck, declared after the players they control so they are destroyed first
+    juce::OwnedArray<DeckGUI> deckGUIs;
+
+    // Mixer: Renders the decks in parallel and combines them through the crossfader
+    DeckMixer mixer;
+
+    // MIDI controller input, feeding the decks' controller queues straight from the MIDI thread
+    std::unique_ptr<MidiControllerInput> midiInput;
+
+    // Music library: Indexed and rescanned in the background through the same format manager the decks use
+    MusicLibrary library{ formatManager, MusicLibrary::getDefaultIndexFile() };
+
+    // Library panel along the bottom: search the library and send tracks to the decks
+    std::unique_ptr<LibraryComponent> libraryPanel;
+
+    // Crossfader between the left-hand and right-hand decks
+    juce::Slider crossfaderSlider{ juce::Slider::LinearHorizontal, juce::Slider::NoTextBox };
+    juce::Label crossfaderLabel{ {}, "Crossfader" };
+
+    // Profiler: Times every audio callback and deck; the overlay drains it and shows the results
+    AudioProfiler profiler;
+    ProfilerOverlay profilerOverlay{ profiler, deviceManager };
+
+    // Master recorder: The mixed output is copied to it after every callback and written to disk on its own thread
+    MasterRecorder recorder;
+    juce::TextButton recordButton{ "REC" };
+    juce::Label recordStatusLabel;
+
+    // Sample rate of the running device, which sets each callback's deadline
+    double currentSampleRate = 0.0;
+
+    // Copy of the last timing handed to the profiler (audio thread only)
+    AudioProfiler::CallbackTiming lastCallbackTiming;
+
+    // Prevents copying and assignment of MainComponent
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MainComponent)
+};
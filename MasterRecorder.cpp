@@ -0,0 +1,162 @@
+/*
+  ==============================================================================
+
+    MasterRecorder.cpp
+    Created: 17 Oct 2026 11:58:14pm
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#include "MasterRecorder.h"
+
+// Constructor for MasterRecorder
+MasterRecorder::MasterRecorder(int channels)
+    : juce::Thread("Master recorder"), numChannels(juce::jmax(1, channels)) {
+    fifoBuffer.setSize(numChannels, fifoFrames);
+}
+
+// Destructor for MasterRecorder
+MasterRecorder::~MasterRecorder() {
+    stop();
+}
+
+juce::Result MasterRecorder::start(const juce::File& file, double sampleRate) {
+    if (isRecording())
+        return juce::Result::fail("already recording to " + recordingFile.getFullPathName());
+
+    if (sampleRate <= 0.0)
+        return juce::Result::fail("no audio device is running");
+
+    file.getParentDirectory().createDirectory();
+    file.deleteFile();
+    std::unique_ptr<juce::FileOutputStream> stream(file.createOutputStream());
+    if (stream == nullptr)
+        return juce::Result::fail("cannot write " + file.getFullPathName());
+
+    std::unique_ptr<juce::AudioFormat> format;
+    if (file.hasFileExtension("flac"))
+        format = std::make_unique<juce::FlacAudioFormat>();
+    else
+        format = std::make_unique<juce::WavAudioFormat>();
+
+    writer.reset(format->createWriterFor(stream.get(), sampleRate, (unsigned int)numChannels, 24, {}, 0));
+    if (writer == nullptr)
+        return juce::Result::fail("cannot write a 24-bit " + format->getFormatName() + " file");
+    stream.release();  // Now owned by the writer
+
+    recordingFile = file;
+    recordingSampleRate = sampleRate;
+    fifo.reset();
+    framesWritten = 0;
+    framesDropped = 0;
+    fifoHighWater = 0;
+
+    startThread(juce::Thread::Priority::normal);
+    armed = true;
+    return juce::Result::ok();
+}
+
+// Once armed is clear and no push is in flight the audio thread can't touch the FIFO again, so
+// everything in it is final and the writer can drain it and close the file
+void MasterRecorder::stop() {
+    if (!isThreadRunning())
+        return;
+
+    armed = false;
+    while (activePushes.load() != 0)
+        juce::Thread::yield();
+
+    stopThread(10000);
+    writer.reset();  // Finishes the file's header
+
+    const auto stats = getStats();
+    juce::Logger::outputDebugString("MasterRecorder: wrote " + juce::String(stats.framesWritten) + " frames to "
+        + recordingFile.getFullPathName() + ", dropped " + juce::String(stats.framesDropped)
+        + ", FIFO high-water " + juce::String(stats.fifoHighWater) + "/" + juce::String(stats.fifoCapacity) + "\n");
+}
+
+// Copies into the two halves of the free space the AbstractFifo hands out, which never allocates or waits
+void MasterRecorder::pushBlock(const juce::AudioBuffer<float>& buffer, int startSample, int numSamples) noexcept {
+    ++activePushes;
+
+    if (armed.load() && numSamples > 0) {
+        if (fifo.getFreeSpace() < numSamples) {
+            framesDropped += numSamples;
+        }
+        else {
+            int start1, size1, start2, size2;
+            fifo.prepareToWrite(numSamples, start1, size1, start2, size2);
+
+            const int numSourceChannels = buffer.getNumChannels();
+            for (int channel = 0; channel < numChannels; ++channel) {
+                const int source = juce::jmin(channel, numSourceChannels - 1);
+                if (size1 > 0)
+                    fifoBuffer.copyFrom(channel, start1, buffer, source, startSample, size1);
+                if (size2 > 0)
+                    fifoBuffer.copyFrom(channel, start2, buffer, source, startSample + size1, size2);
+            }
+
+            fifo.finishedWrite(size1 + size2);
+
+            const int ready = fifo.getNumReady();
+            if (ready > fifoHighWater.load())
+                fifoHighWater = ready;
+        }
+    }
+
+    --activePushes;
+}
+
+MasterRecorder::Stats MasterRecorder::getStats() const {
+    Stats stats;
+    stats.recording = isRecording();
+    stats.sampleRate = recordingSampleRate;
+    stats.framesWritten = framesWritten.load();
+    stats.framesDropped = framesDropped.load();
+    stats.fifoHighWater = fifoHighWater.load();
+    stats.fifoCapacity = fifo.getTotalSize() - 1;  // The AbstractFifo keeps one slot free
+    return stats;
+}
+
+void MasterRecorder::run() {
+    auto lastFlushMs = juce::Time::getMillisecondCounterHiRes();
+
+    while (!threadShouldExit()) {
+        if (fifo.getNumReady() >= writeChunkFrames)
+            drainFifo(writeChunkFrames);
+        else
+            wait(20);
+
+        // Rewrites the header of a WAV file, so the file on disk is always playable
+        const auto nowMs = juce::Time::getMillisecondCounterHiRes();
+        if (nowMs - lastFlushMs >= flushIntervalMs) {
+            drainFifo(fifo.getNumReady());
+            writer->flush();
+            lastFlushMs = nowMs;
+        }
+    }
+
+    while (drainFifo(writeChunkFrames) > 0) {}
+}
+
+int MasterRecorder::drainFifo(int maxFrames) {
+    const int numToWrite = juce::jmin(maxFrames, fifo.getNumReady());
+    if (numToWrite <= 0)
+        return 0;
+
+    int start1, size1, start2, size2;
+    fifo.prepareToRead(numToWrite, start1, size1, start2, size2);
+
+    bool ok = size1 <= 0 || writer->writeFromAudioSampleBuffer(fifoBuffer, start1, size1);
+    ok = (size2 <= 0 || writer->writeFromAudioSampleBuffer(fifoBuffer, start2, size2)) && ok;
+
+    fifo.finishedRead(size1 + size2);
+
+    if (ok)
+        framesWritten += size1 + size2;
+    else
+        juce::Logger::outputDebugString("MasterRecorder: write failed on " + recordingFile.getFullPathName() + "\n");
+
+    return size1 + size2;
+}
@@ -0,0 +1,92 @@
+/*
+  ==============================================================================
+
+    MasterRecorder.h
+    Created: 17 Oct 2026 11:58:14pm
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// Records the master output to a WAV or FLAC file without the audio thread ever touching the disk.
+//
+// The audio thread copies each block into a FIFO allocated when the recorder is created; a writer
+// thread drains it in large sequential writes and flushes the file every couple of seconds. For WAV
+// the flush rewrites the header, so a crash leaves a playable file that is at most a flush interval
+// short. A block that doesn't fit in the FIFO is dropped whole and counted, never waited for.
+class MasterRecorder : private juce::Thread {
+public:
+    // Frames the FIFO holds, about 12 seconds at 44.1 kHz
+    static constexpr int fifoFrames = 1 << 19;
+
+    // Frames the writer waits to collect before writing, so writes stay large and sequential
+    static constexpr int writeChunkFrames = 1 << 15;
+
+    // Time between flushes of the file while recording
+    static constexpr int flushIntervalMs = 2000;
+
+    // What the recording has done so far, for display and the log
+    struct Stats {
+        bool recording = false;
+        double sampleRate = 0.0;
+        juce::int64 framesWritten = 0;
+        juce::int64 framesDropped = 0;
+        int fifoHighWater = 0;  // Most frames the FIFO has held since recording started
+        int fifoCapacity = 0;
+    };
+
+    // Constructor: allocates the FIFO for up to numChannels channels
+    explicit MasterRecorder(int numChannels = 2);
+
+    // Destructor: stops and finishes any recording
+    ~MasterRecorder() override;
+
+    // Opens file and starts recording at sampleRate; FLAC for a .flac file, WAV otherwise (message thread)
+    juce::Result start(const juce::File& file, double sampleRate);
+
+    // Stops recording, writes what is left in the FIFO and closes the file (message thread)
+    void stop();
+
+    // Copies a block of the master output into the FIFO while recording (audio thread only)
+    void pushBlock(const juce::AudioBuffer<float>& buffer, int startSample, int numSamples) noexcept;
+
+    // True between start() and stop()
+    bool isRecording() const noexcept { return armed.load(); }
+
+    // File being recorded to, or the last one recorded
+    juce::File getFile() const { return recordingFile; }
+
+    // Counters of the current or last recording (any thread)
+    Stats getStats() const;
+
+private:
+    // Drains the FIFO to the writer until told to stop, then drains what is left (writer thread)
+    void run() override;
+
+    // Writes up to maxFrames from the FIFO; returns the number written (writer thread)
+    int drainFifo(int maxFrames);
+
+    const int numChannels;
+
+    // Written by the audio thread and read by the writer through the AbstractFifo's positions
+    juce::AbstractFifo fifo{ fifoFrames };
+    juce::AudioBuffer<float> fifoBuffer;
+
+    // Owned by the writer thread while it runs, and by the message thread otherwise
+    std::unique_ptr<juce::AudioFormatWriter> writer;
+    juce::File recordingFile;
+    double recordingSampleRate = 0.0;
+
+    // Set while the audio thread may push; stop() waits for activePushes to fall to zero after clearing it
+    std::atomic<bool> armed{ false };
+    std::atomic<int> activePushes{ 0 };
+
+    std::atomic<juce::int64> framesWritten{ 0 };
+    std::atomic<juce::int64> framesDropped{ 0 };
+    std::atomic<int> fifoHighWater{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MasterRecorder)
+};
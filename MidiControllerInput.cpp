@@ -0,0 +1,303 @@
+/*
+  ==============================================================================
+
+    MidiControllerInput.cpp
+    Created: 18 Oct 2026 12:21:07am
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#include "MidiControllerInput.h"
+
+namespace {
+    struct ActionInfo {
+        const char* name;
+        MidiMapping::Action action;
+        double minValue, maxValue;
+    };
+
+    // Default ranges follow the deck's own controls
+    const ActionInfo actions[] = {
+        { "play",       MidiMapping::Action::playPause,  0.0,  1.0 },
+        { "gain",       MidiMapping::Action::gain,       0.0,  1.0 },
+        { "speed",      MidiMapping::Action::speed,      0.0,  2.0 },
+        { "low",        MidiMapping::Action::eqLow,      0.0,  DeckEQ::maxGain },
+        { "mid",        MidiMapping::Action::eqMid,      0.0,  DeckEQ::maxGain },
+        { "high",       MidiMapping::Action::eqHigh,     0.0,  DeckEQ::maxGain },
+        { "filter",     MidiMapping::Action::filter,    -1.0,  1.0 },
+        { "trim",       MidiMapping::Action::trim,       0.0,  DeckEQ::maxGain },
+        { "loopin",     MidiMapping::Action::loopIn,     0.0,  1.0 },
+        { "loopout",    MidiMapping::Action::loopOut,    0.0,  1.0 },
+        { "halve",      MidiMapping::Action::halveLoop,  0.0,  1.0 },
+        { "double",     MidiMapping::Action::doubleLoop, 0.0,  1.0 },
+        { "exit",       MidiMapping::Action::exitLoop,   0.0,  1.0 },
+        { "crossfader", MidiMapping::Action::crossfader, 0.0,  1.0 }
+    };
+
+    constexpr int numChannels = 16;
+    constexpr int numNumbers = 128;
+
+    // True for an optionally negative decimal with at least one digit, such as "-0.5" but not "-" or ".."
+    bool isNumber(const juce::String& token) {
+        const auto digits = token.startsWithChar('-') ? token.substring(1) : token;
+        return digits.containsOnly("0123456789.") && digits.containsAnyOf("0123456789")
+            && digits.indexOfChar('.') == digits.lastIndexOfChar('.');
+    }
+}
+
+bool MidiMapping::Binding::isButton() const {
+    switch (action) {
+    case Action::playPause:
+    case Action::loopIn:
+    case Action::loopOut:
+    case Action::halveLoop:
+    case Action::doubleLoop:
+    case Action::exitLoop:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Knobs with a neutral setting reach it exactly at 64, the centre detent of most controllers
+double MidiMapping::Binding::mapControllerValue(int value) const {
+    value = juce::jlimit(0, 127, value);
+
+    const bool hasCentre = action == Action::eqLow || action == Action::eqMid || action == Action::eqHigh
+        || action == Action::filter || action == Action::trim;
+
+    if (!hasCentre)
+        return minValue + (maxValue - minValue) * value / 127.0;
+
+    const double centre = action == Action::filter ? 0.0 : 1.0;
+    return value <= 64 ? minValue + (centre - minValue) * value / 64.0
+                       : centre + (maxValue - centre) * (value - 64) / 63.0;
+}
+
+juce::Result MidiMapping::parse(const juce::String& text) {
+    bindings.clear();
+
+    auto lines = juce::StringArray::fromLines(text);
+
+    for (int lineIndex = 0; lineIndex < lines.size(); ++lineIndex) {
+        auto line = lines[lineIndex].upToFirstOccurrenceOf("#", false, false).trim();
+        if (line.isEmpty())
+            continue;
+
+        auto fail = [lineIndex](const juce::String& message) {
+            return juce::Result::fail("line " + juce::String(lineIndex + 1) + ": " + message);
+        };
+
+        auto tokens = juce::StringArray::fromTokens(line, " \t", "");
+        tokens.removeEmptyStrings();
+
+        if (tokens.size() != 5 && tokens.size() != 7)
+            return fail("expected <cc|note> <channel> <number> <deck> <action> [min max]");
+
+        Binding binding;
+        if (tokens[0] == "note")
+            binding.isNote = true;
+        else if (tokens[0] != "cc")
+            return fail("unknown message type '" + tokens[0] + "'");
+
+        binding.channel = tokens[1] == "*" ? 0 : tokens[1].getIntValue();
+        if (tokens[1] != "*" && (binding.channel < 1 || binding.channel > numChannels))
+            return fail("channel must be 1 to 16 or *");
+
+        binding.number = tokens[2].getIntValue();
+        if (binding.number < 0 || binding.number >= numNumbers || !tokens[2].containsOnly("0123456789"))
+            return fail("controller or note number must be 0 to 127");
+
+        const ActionInfo* info = nullptr;
+        for (auto& candidate : actions)
+            if (tokens[4] == candidate.name)
+                info = &candidate;
+
+        if (info == nullptr)
+            return fail("unknown action '" + tokens[4] + "'");
+
+        binding.action = info->action;
+        binding.minValue = info->minValue;
+        binding.maxValue = info->maxValue;
+
+        if (binding.action == Action::crossfader) {
+            if (tokens[3] != "-")
+                return fail("the crossfader takes - instead of a deck");
+        }
+        else {
+            const int deckNumber = tokens[3].getIntValue();
+            if (deckNumber < 1 || deckNumber > DeckMixer::maxDecks)
+                return fail("deck must be 1 to " + juce::String(DeckMixer::maxDecks));
+
+            binding.deck = deckNumber - 1;
+        }
+
+        if (tokens.size() == 7) {
+            if (!isNumber(tokens[5]) || !isNumber(tokens[6]))
+                return fail("min and max must be numbers");
+
+            binding.minValue = tokens[5].getDoubleValue();
+            binding.maxValue = tokens[6].getDoubleValue();
+        }
+
+        bindings.push_back(binding);
+    }
+
+    return juce::Result::ok();
+}
+
+juce::Result MidiMapping::loadFrom(const juce::File& mappingFile) {
+    if (!mappingFile.existsAsFile())
+        return juce::Result::fail("cannot find " + mappingFile.getFullPathName());
+
+    return parse(mappingFile.loadFileAsString());
+}
+
+MidiMapping MidiMapping::createDefault(int numDecks) {
+    juce::String text;
+
+    for (int deck = 1; deck <= numDecks; ++deck) {
+        const juce::String prefix = " " + juce::String(deck) + " ";
+        text << "cc" << prefix << "7 " << deck << " gain\n"
+             << "cc" << prefix << "8 " << deck << " speed 0.92 1.08\n"
+             << "cc" << prefix << "16 " << deck << " low\n"
+             << "cc" << prefix << "17 " << deck << " mid\n"
+             << "cc" << prefix << "18 " << deck << " high\n"
+             << "cc" << prefix << "19 " << deck << " filter\n"
+             << "cc" << prefix << "20 " << deck << " trim\n"
+             << "note" << prefix << "1 " << deck << " play\n"
+             << "note" << prefix << "2 " << deck << " loopin\n"
+             << "note" << prefix << "3 " << deck << " loopout\n"
+             << "note" << prefix << "4 " << deck << " halve\n"
+             << "note" << prefix << "5 " << deck << " double\n"
+             << "note" << prefix << "6 " << deck << " exit\n";
+    }
+
+    text << "cc * 10 - crossfader\n";
+
+    MidiMapping mapping;
+    mapping.parse(text);
+    return mapping;
+}
+
+juce::File MidiMapping::getDefaultFile() {
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+        .getChildFile("OtoDesks")
+        .getChildFile("midi-mapping.txt");
+}
+
+// Constructor for MidiControllerInput
+MidiControllerInput::MidiControllerInput(juce::AudioDeviceManager& manager, DeckMixer& mixerToControl, std::vector<DJAudioPlayer*> decks)
+    : deviceManager(manager), mixer(mixerToControl), players(std::move(decks)),
+      table((size_t)(2 * numChannels * numNumbers)) {
+    setMapping(MidiMapping::createDefault((int)players.size()));
+}
+
+// Destructor for MidiControllerInput
+MidiControllerInput::~MidiControllerInput() {
+    if (attached)
+        deviceManager.removeMidiInputDeviceCallback({}, this);
+}
+
+// Removing the callback waits for any call in progress, so the table is never read while it changes
+void MidiControllerInput::setMapping(const MidiMapping& mapping) {
+    if (attached)
+        deviceManager.removeMidiInputDeviceCallback({}, this);
+
+    bindings.clear();
+    for (auto& list : table)
+        list.clear();
+
+    for (const auto& binding : mapping.getBindings()) {
+        if (binding.deck >= (int)players.size())
+            continue;
+
+        const int index = (int)bindings.size();
+        bindings.push_back(binding);
+
+        for (int channel = 1; channel <= numChannels; ++channel)
+            if (binding.channel == 0 || binding.channel == channel)
+                table[(size_t)getTableIndex(binding.isNote, channel, binding.number)].push_back(index);
+    }
+
+    deviceManager.addMidiInputDeviceCallback({}, this);
+    attached = true;
+}
+
+void MidiControllerInput::openAllInputs() {
+    for (const auto& device : juce::MidiInput::getAvailableDevices()) {
+        deviceManager.setMidiInputDeviceEnabled(device.identifier, true);
+        juce::Logger::outputDebugString("MidiControllerInput: listening to " + device.name + "\n");
+    }
+}
+
+int MidiControllerInput::getTableIndex(bool isNote, int channel, int number) noexcept {
+    return ((isNote ? 1 : 0) * numChannels + (channel - 1)) * numNumbers + number;
+}
+
+// Stamped on arrival, so the deck can tell how long the command took to reach the audio thread
+void MidiControllerInput::handleIncomingMidiMessage(juce::MidiInput*, const juce::MidiMessage& message) {
+    const auto receivedTicks = juce::Time::getHighResolutionTicks();
+    ++messagesReceived;
+
+    const bool isNote = message.isNoteOn() || message.isNoteOff();
+    if (!isNote && !message.isController()) {
+        ++messagesUnmapped;
+        return;
+    }
+
+    const int number = isNote ? message.getNoteNumber() : message.getControllerNumber();
+    const auto& matches = table[(size_t)getTableIndex(isNote, message.getChannel(), number)];
+
+    if (matches.empty()) {
+        ++messagesUnmapped;
+        return;
+    }
+
+    for (int index : matches) {
+        const auto& binding = bindings[(size_t)index];
+
+        DeckCommand command;
+        command.sentTicks = receivedTicks;
+
+        if (binding.isButton()) {
+            const bool pressed = isNote ? message.isNoteOn() : message.getControllerValue() > 63;
+            if (!pressed)
+                continue;
+
+            switch (binding.action) {
+            case MidiMapping::Action::playPause:  command.type = DeckCommand::Type::togglePlayback; break;
+            case MidiMapping::Action::loopIn:     command.type = DeckCommand::Type::setLoopIn; break;
+            case MidiMapping::Action::loopOut:    command.type = DeckCommand::Type::setLoopOut; break;
+            case MidiMapping::Action::halveLoop:  command.type = DeckCommand::Type::halveLoop; break;
+            case MidiMapping::Action::doubleLoop: command.type = DeckCommand::Type::doubleLoop; break;
+            default:                              command.type = DeckCommand::Type::exitLoop; break;
+            }
+        }
+        else {
+            // A note drives a knob by its velocity; its release leaves the knob where it is
+            if (isNote && !message.isNoteOn())
+                continue;
+
+            const double value = binding.mapControllerValue(isNote ? (int)message.getVelocity() : message.getControllerValue());
+            command.value = value;
+
+            switch (binding.action) {
+            case MidiMapping::Action::crossfader:
+                mixer.setCrossfader((float)value);
+                continue;
+            case MidiMapping::Action::gain:   command.type = DeckCommand::Type::setGain; break;
+            case MidiMapping::Action::speed:  command.type = DeckCommand::Type::setSpeed; break;
+            case MidiMapping::Action::eqLow:  command.type = DeckCommand::Type::setEqLow; break;
+            case MidiMapping::Action::eqMid:  command.type = DeckCommand::Type::setEqMid; break;
+            case MidiMapping::Action::eqHigh: command.type = DeckCommand::Type::setEqHigh; break;
+            case MidiMapping::Action::filter: command.type = DeckCommand::Type::setFilter; break;
+            default:                          command.type = DeckCommand::Type::setTrim; break;
+            }
+        }
+
+        if (!players[(size_t)binding.deck]->queueControllerCommand(command))
+            ++messagesDropped;
+    }
+}
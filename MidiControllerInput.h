@@ -0,0 +1,113 @@
+/*
+  ==============================================================================
+
+    MidiControllerInput.h
+    Created: 18 Oct 2026 12:21:07am
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "djAudioPlayer.h"
+#include "DeckMixer.h"
+
+// MidiMapping class
+// Which controls of a MIDI controller drive which deck parameters. One binding per line:
+//
+//     <cc|note> <channel> <number> <deck> <action> [min max]
+//
+// Channels are 1 to 16 or * for any, decks are numbered from 1 as on screen (- for the crossfader),
+// and # starts a comment. Knobs and faders sweep from min to max, which default to the range of the
+// matching on-screen control; the EQ, filter and trim knobs have their neutral setting at the centre.
+// Buttons act on a note-on, or when a cc goes above 63.
+//
+//     cc   1 7  1 gain
+//     cc   1 8  1 speed 0.92 1.08        (a +-8% pitch fader)
+//     cc   1 16 1 low                    (also mid, high, filter, trim)
+//     note 1 1  1 play                   (toggles play and stop)
+//     note 1 2  1 loopin                 (also loopout, halve, double, exit)
+//     cc   * 10 - crossfader
+class MidiMapping {
+public:
+    enum class Action { playPause, gain, speed, eqLow, eqMid, eqHigh, filter, trim, loopIn, loopOut, halveLoop, doubleLoop, exitLoop, crossfader };
+
+    struct Binding {
+        bool isNote = false;
+        int channel = 0;  // 1 to 16, or 0 for any
+        int number = 0;  // Controller or note number
+        int deck = -1;  // Zero-based; -1 for the crossfader
+        Action action = Action::gain;
+        double minValue = 0.0, maxValue = 1.0;
+
+        // True for actions fired by a press rather than set to a position
+        bool isButton() const;
+
+        // Converts a 7-bit controller value to the parameter's value
+        double mapControllerValue(int value) const;
+    };
+
+    // Parses a mapping, replacing the current bindings
+    juce::Result parse(const juce::String& text);
+
+    // Reads and parses a mapping file
+    juce::Result loadFrom(const juce::File& mappingFile);
+
+    // One MIDI channel per deck, numbered like the decks, with the same controls on each
+    static MidiMapping createDefault(int numDecks);
+
+    // Where a user's own mapping is kept
+    static juce::File getDefaultFile();
+
+    const std::vector<Binding>& getBindings() const { return bindings; }
+
+private:
+    std::vector<Binding> bindings;
+};
+
+// MidiControllerInput class
+// Handles MIDI input on the MIDI callback thread. Each message is looked up in a table built from the
+// mapping and turned straight into a deck command on the deck's controller queue, which the deck drains
+// at the start of its next audio block, so a busy message thread adds nothing to the latency. The deck
+// widgets only mirror the state the audio thread publishes afterwards.
+class MidiControllerInput : private juce::MidiInputCallback {
+public:
+    // Constructor: the device manager, mixer and players must outlive the input
+    MidiControllerInput(juce::AudioDeviceManager& deviceManager, DeckMixer& mixer, std::vector<DJAudioPlayer*> players);
+
+    // Destructor: stops receiving MIDI
+    ~MidiControllerInput() override;
+
+    // Replaces the mapping, detaching from the MIDI thread while the lookup table is rebuilt (message thread)
+    void setMapping(const MidiMapping& mapping);
+
+    // Enables every MIDI input currently connected, including ALSA virtual ports such as those of
+    // snd-virmidi, so latency can be measured by sending to one from the same machine (message thread)
+    void openAllInputs();
+
+    // Messages received, and those that matched no binding or found their deck's queue full (any thread)
+    juce::uint64 getMessagesReceived() const noexcept { return messagesReceived.load(); }
+    juce::uint64 getMessagesUnmapped() const noexcept { return messagesUnmapped.load(); }
+    juce::uint64 getMessagesDropped() const noexcept { return messagesDropped.load(); }
+
+private:
+    // Turns a message into deck commands (MIDI thread)
+    void handleIncomingMidiMessage(juce::MidiInput* source, const juce::MidiMessage& message) override;
+
+    // Slot of a control in the lookup table
+    static int getTableIndex(bool isNote, int channel, int number) noexcept;
+
+    juce::AudioDeviceManager& deviceManager;
+    DeckMixer& mixer;
+    const std::vector<DJAudioPlayer*> players;
+
+    // Bindings of every note and controller on every channel, only rebuilt while detached from the MIDI thread
+    std::vector<MidiMapping::Binding> bindings;
+    std::vector<std::vector<int>> table;
+    bool attached = false;
+
+    std::atomic<juce::uint64> messagesReceived{ 0 }, messagesUnmapped{ 0 }, messagesDropped{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MidiControllerInput)
+};
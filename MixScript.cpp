@@ -0,0 +1,146 @@
+/*
+  ==============================================================================
+
+    MixScript.cpp
+    Created: 17 Oct 2026 7:48:12pm
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#include "MixScript.h"
+#include "DeckMixer.h"
+
+namespace {
+    struct CommandInfo {
+        const char* name;
+        MixEvent::Type type;
+        bool takesDeck;
+        bool takesValue;
+    };
+
+    const CommandInfo commands[] = {
+        { "load",       MixEvent::Type::load,       true,  false },
+        { "play",       MixEvent::Type::play,       true,  false },
+        { "stop",       MixEvent::Type::stop,       true,  false },
+        { "gain",       MixEvent::Type::gain,       true,  true },
+        { "speed",      MixEvent::Type::speed,      true,  true },
+        { "keylock",    MixEvent::Type::keylock,    true,  true },
+        { "seek",       MixEvent::Type::seek,       true,  true },
+        { "cue",        MixEvent::Type::cue,        true,  true },
+        { "jump",       MixEvent::Type::jumpCue,    true,  false },
+        { "crossfader", MixEvent::Type::crossfader, false, true },
+        { "end",        MixEvent::Type::end,        false, false }
+    };
+
+    // True for an optionally negative decimal with at least one digit, such as "-0.5" but not "-" or ".."
+    bool isNumber(const juce::String& token) {
+        const auto digits = token.startsWithChar('-') ? token.substring(1) : token;
+        return digits.containsOnly("0123456789.") && digits.containsAnyOf("0123456789")
+            && digits.indexOfChar('.') == digits.lastIndexOfChar('.');
+    }
+}
+
+juce::Result MixScript::parse(const juce::String& text, const juce::File& baseDirectory) {
+    events.clear();
+    numDecks = DeckMixer::minDecks;
+    endTimeSeconds = -1.0;
+
+    auto lines = juce::StringArray::fromLines(text);
+
+    for (int lineIndex = 0; lineIndex < lines.size(); ++lineIndex) {
+        auto line = lines[lineIndex].upToFirstOccurrenceOf("#", false, false).trim();
+        if (line.isEmpty())
+            continue;
+
+        auto fail = [lineIndex](const juce::String& message) {
+            return juce::Result::fail("line " + juce::String(lineIndex + 1) + ": " + message);
+        };
+
+        auto tokens = juce::StringArray::fromTokens(line, " \t", "\"");
+        tokens.removeEmptyStrings();
+
+        MixEvent event;
+        if (!parseTime(tokens[0], event.timeSeconds))
+            return fail("bad time '" + tokens[0] + "'");
+
+        const CommandInfo* command = nullptr;
+        for (auto& candidate : commands)
+            if (tokens[1] == candidate.name)
+                command = &candidate;
+
+        if (command == nullptr)
+            return fail("unknown command '" + tokens[1] + "'");
+
+        event.type = command->type;
+        int nextToken = 2;
+
+        if (command->takesDeck) {
+            const int deckNumber = tokens[nextToken++].getIntValue();
+            if (deckNumber < 1 || deckNumber > DeckMixer::maxDecks)
+                return fail("deck must be 1 to " + juce::String(DeckMixer::maxDecks));
+
+            event.deck = deckNumber - 1;
+            numDecks = juce::jmax(numDecks, deckNumber);
+        }
+
+        if (event.type == MixEvent::Type::load) {
+            const auto path = tokens[nextToken++].unquoted();
+            if (path.isEmpty())
+                return fail("load needs a file");
+
+            event.file = juce::File::isAbsolutePath(path) ? juce::File(path) : baseDirectory.getChildFile(path);
+        }
+        else if (event.type == MixEvent::Type::keylock) {
+            const auto state = tokens[nextToken++];
+            if (state != "on" && state != "off")
+                return fail("keylock takes on or off");
+
+            event.value = state == "on" ? 1.0 : 0.0;
+        }
+        else if (command->takesValue) {
+            const auto valueToken = tokens[nextToken++];
+            if (valueToken.isEmpty())
+                return fail(juce::String(command->name) + " needs a value");
+
+            if (!isNumber(valueToken))
+                return fail("bad value '" + valueToken + "'");
+
+            event.value = valueToken.getDoubleValue();
+        }
+
+        if (nextToken < tokens.size())
+            return fail("unexpected '" + tokens[nextToken] + "'");
+
+        if (event.type == MixEvent::Type::end)
+            endTimeSeconds = event.timeSeconds;
+        else
+            events.push_back(event);
+    }
+
+    if (endTimeSeconds < 0.0)
+        return juce::Result::fail("the script has no end event");
+
+    std::stable_sort(events.begin(), events.end(),
+        [](const MixEvent& a, const MixEvent& b) { return a.timeSeconds < b.timeSeconds; });
+
+    return juce::Result::ok();
+}
+
+juce::Result MixScript::loadFrom(const juce::File& scriptFile) {
+    if (!scriptFile.existsAsFile())
+        return juce::Result::fail("cannot find " + scriptFile.getFullPathName());
+
+    return parse(scriptFile.loadFileAsString(), scriptFile.getParentDirectory());
+}
+
+bool MixScript::parseTime(const juce::String& token, double& seconds) {
+    if (token.isEmpty() || !token.containsOnly("0123456789.:"))
+        return false;
+
+    seconds = 0.0;
+    for (auto& part : juce::StringArray::fromTokens(token, ":", {}))
+        seconds = seconds * 60.0 + part.getDoubleValue();
+
+    return true;
+}
@@ -0,0 +1,65 @@
+/*
+  ==============================================================================
+
+    MixScript.h
+    Created: 17 Oct 2026 7:48:12pm
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// One timed instruction of a mix script
+struct MixEvent {
+    enum class Type { load, play, stop, gain, speed, keylock, seek, cue, jumpCue, crossfader, end };
+
+    double timeSeconds = 0.0;
+    Type type = Type::end;
+    int deck = -1;  // Zero-based; -1 for mixer-wide events
+    double value = 0.0;
+    juce::File file;  // Track for load events
+};
+
+// MixScript class
+// A timestamped list of deck and mixer actions for offline rendering. One event per line:
+//
+//     <time> <command> [deck] [value]
+//
+// Times are seconds or m:ss.s, decks are numbered from 1 as on screen, and # starts a comment.
+//
+//     0:00   load 1 "tracks/intro.wav"     (relative paths are resolved against the script)
+//     0:00   play 1
+//     1:30   cue 2 12.5                    (remembers a cue point on deck 2)
+//     1:30   jump 2                        (jumps to the next cue point, like JUMP CUE)
+//     1:30   play 2
+//     1:45   crossfader 0.75               (0 is fully left, 1 fully right)
+//     2:10   gain 1 0.4 / speed 2 1.04 / keylock 2 on / seek 1 95 / stop 1
+//     3:00   end                           (required: where the render stops)
+class MixScript {
+public:
+    // Parses a script; relative track paths are resolved against baseDirectory
+    juce::Result parse(const juce::String& text, const juce::File& baseDirectory);
+
+    // Reads and parses a script file
+    juce::Result loadFrom(const juce::File& scriptFile);
+
+    // Events in time order; events at the same time keep their order in the script
+    const std::vector<MixEvent>& getEvents() const { return events; }
+
+    // Number of decks the script refers to, at least two
+    int getNumDecks() const { return numDecks; }
+
+    // Time of the end event
+    double getEndTimeSeconds() const { return endTimeSeconds; }
+
+private:
+    // Parses "95.5" or "1:35.5" into seconds, returning false if it is neither
+    static bool parseTime(const juce::String& token, double& seconds);
+
+    std::vector<MixEvent> events;
+    int numDecks = 2;
+    double endTimeSeconds = -1.0;
+};
@@ -0,0 +1,539 @@
+/*
+  ==============================================================================
+
+    MusicLibrary.cpp
+    Created: 18 Oct 2026 2:37:51am
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#include "MusicLibrary.h"
+#include <cctype>
+#include <unordered_map>
+
+namespace {
+    // "OTL1" at the start of the index, after decompression
+    constexpr int indexMagic = 0x4f544c31;
+    // Version 2 added the unreadable flag; a version 1 index still loads
+    constexpr int indexVersion = 2;
+    constexpr int maxTracks = 10000000;
+
+    // Word prefixes are told apart from trigrams by their top byte
+    constexpr juce::uint32 twoLetterPrefix = 0x01000000;
+    constexpr juce::uint32 oneLetterPrefix = 0x02000000;
+
+    // Lower-cases text as UTF-8 and turns ASCII punctuation into spaces, so "Daft Punk - One More Time
+    // (Radio Edit)" becomes words that match however the query is punctuated
+    std::string normalise(const juce::String& text) {
+        auto result = text.toLowerCase().toStdString();
+
+        for (auto& c : result)
+            if ((unsigned char)c < 0x80 && !std::isalnum((unsigned char)c))
+                c = ' ';
+
+        return result;
+    }
+
+    // Packs three bytes of text into a trigram key
+    juce::uint32 trigramKey(const std::string& text, size_t i) {
+        return ((juce::uint32)(unsigned char)text[i] << 16) | ((juce::uint32)(unsigned char)text[i + 1] << 8)
+            | (juce::uint32)(unsigned char)text[i + 2];
+    }
+
+    // Returns the key of a one- or two-letter word prefix
+    juce::uint32 prefixKey(const std::string& text, size_t i, size_t length) {
+        if (length == 1)
+            return oneLetterPrefix | (juce::uint32)(unsigned char)text[i];
+
+        return twoLetterPrefix | ((juce::uint32)(unsigned char)text[i] << 8) | (juce::uint32)(unsigned char)text[i + 1];
+    }
+
+    // Returns the first of a file's tags that is set
+    juce::String findTag(const juce::StringPairArray& tags, std::initializer_list<const char*> names) {
+        for (auto* name : names) {
+            auto value = tags.getValue(name, {}).trim();
+            if (value.isNotEmpty())
+                return value;
+        }
+
+        return {};
+    }
+}
+
+// Sorts the tracks, then collects every (key, track) pair and groups them by key
+MusicLibrary::Index::Index(std::vector<Track> tracksToIndex)
+    : tracks(std::move(tracksToIndex)) {
+    tracks.erase(std::remove_if(tracks.begin(), tracks.end(), [](const Track& track) { return track.unreadable; }),
+                 tracks.end());
+
+    std::sort(tracks.begin(), tracks.end(), [](const Track& a, const Track& b) {
+        if (const int byArtist = a.artist.compareIgnoreCase(b.artist))
+            return byArtist < 0;
+
+        if (const int byTitle = a.title.compareIgnoreCase(b.title))
+            return byTitle < 0;
+
+        return a.path < b.path;
+    });
+
+    // Key in the top 32 bits, track position in the bottom 32, so sorting groups them by key in track order
+    std::vector<juce::uint64> entries;
+    searchText.reserve(tracks.size());
+
+    for (size_t i = 0; i < tracks.size(); ++i) {
+        const auto& track = tracks[i];
+        searchText.push_back(normalise(track.artist + " " + track.title + " " + track.album + " "
+                                       + track.getFile().getFileNameWithoutExtension()));
+        const auto& text = searchText.back();
+
+        auto add = [&entries, i](juce::uint32 key) {
+            entries.push_back(((juce::uint64)key << 32) | (juce::uint64)i);
+        };
+
+        for (size_t j = 0; j < text.size(); ++j) {
+            if (text[j] == ' ')
+                continue;
+
+            if (j == 0 || text[j - 1] == ' ') {
+                add(prefixKey(text, j, 1));
+                if (j + 1 < text.size() && text[j + 1] != ' ')
+                    add(prefixKey(text, j, 2));
+            }
+
+            if (j + 2 < text.size() && text[j + 1] != ' ' && text[j + 2] != ' ')
+                add(trigramKey(text, j));
+        }
+    }
+
+    std::sort(entries.begin(), entries.end());
+    entries.erase(std::unique(entries.begin(), entries.end()), entries.end());
+    postings.reserve(entries.size());
+
+    for (auto entry : entries) {
+        const auto key = (juce::uint32)(entry >> 32);
+
+        if (keys.empty() || keys.back() != key) {
+            keys.push_back(key);
+            postingStarts.push_back((int)postings.size());
+        }
+
+        postings.push_back((int)(entry & 0xffffffffu));
+    }
+
+    postingStarts.push_back((int)postings.size());
+}
+
+// The shortest posting list among the query's keys drives the search; a candidate must be in every
+// other list as well, and contain each long word, since a word's trigrams can be scattered over the text
+std::vector<int> MusicLibrary::Index::search(const juce::String& query, int maxResults) const {
+    std::vector<int> results;
+    if (maxResults <= 0)
+        return results;
+
+    const auto text = normalise(query);
+    std::vector<std::string> words;
+
+    for (size_t start = 0; start < text.size();) {
+        const auto end = std::min(text.find(' ', start), text.size());
+        if (end > start)
+            words.push_back(text.substr(start, end - start));
+
+        start = end + 1;
+    }
+
+    if (words.empty()) {
+        const int count = juce::jmin(maxResults, (int)tracks.size());
+        for (int i = 0; i < count; ++i)
+            results.push_back(i);
+
+        return results;
+    }
+
+    std::vector<std::pair<const int*, const int*>> lists;
+
+    for (auto& word : words) {
+        if (word.size() < 3) {
+            lists.push_back(findPostings(prefixKey(word, 0, word.size())));
+            continue;
+        }
+
+        for (size_t j = 0; j + 2 < word.size(); ++j)
+            lists.push_back(findPostings(trigramKey(word, j)));
+    }
+
+    // Shortest first, so a candidate usually fails on the first list it is looked up in
+    std::sort(lists.begin(), lists.end(), [](const auto& a, const auto& b) {
+        return a.second - a.first < b.second - b.first;
+    });
+    lists.erase(std::unique(lists.begin(), lists.end()), lists.end());
+
+    const auto& driver = lists.front();
+
+    for (auto track = driver.first; track != driver.second && (int)results.size() < maxResults; ++track) {
+        bool matches = true;
+
+        for (auto list = lists.begin() + 1; matches && list != lists.end(); ++list)
+            matches = std::binary_search(list->first, list->second, *track);
+
+        for (auto word = words.begin(); matches && word != words.end(); ++word)
+            if (word->size() >= 3)
+                matches = searchText[(size_t)*track].find(*word) != std::string::npos;
+
+        if (matches)
+            results.push_back(*track);
+    }
+
+    return results;
+}
+
+// Binary search of the sorted keys
+std::pair<const int*, const int*> MusicLibrary::Index::findPostings(juce::uint32 key) const {
+    const auto found = std::lower_bound(keys.begin(), keys.end(), key);
+    if (found == keys.end() || *found != key)
+        return { nullptr, nullptr };
+
+    const auto i = (size_t)(found - keys.begin());
+    return { postings.data() + postingStarts[i], postings.data() + postingStarts[i + 1] };
+}
+
+// Constructor: nothing is read until the first rescan
+MusicLibrary::MusicLibrary(juce::AudioFormatManager& formatManagerToUse, const juce::File& file)
+    : juce::Thread("Music library"), formatManager(formatManagerToUse), indexFile(file) {
+}
+
+// The reader jobs give up as soon as the scan thread is told to exit, so this only waits for open files
+MusicLibrary::~MusicLibrary() {
+    signalThreadShouldExit();
+    rescanRequested.signal();
+    stopThread(4000);
+}
+
+// Returns the per-user index file the app uses
+juce::File MusicLibrary::getDefaultIndexFile() {
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+        .getChildFile("OtoDesks")
+        .getChildFile("Library.index");
+}
+
+// Starts the scan thread on first use
+void MusicLibrary::rescan() {
+    if (!isThreadRunning())
+        startThread(juce::Thread::Priority::low);
+
+    rescanRequested.signal();
+}
+
+// A folder inside one already scanned adds nothing; one containing others takes their place
+void MusicLibrary::addFolder(const juce::File& folder) {
+    {
+        const juce::ScopedLock sl(foldersLock);
+
+        for (auto& existing : folders)
+            if (folder == existing || folder.isAChildOf(existing))
+                return;
+
+        for (int i = folders.size(); --i >= 0;)
+            if (folders[i].isAChildOf(folder))
+                folders.remove(i);
+
+        folders.add(folder);
+    }
+
+    foldersChanged = true;
+    rescan();
+}
+
+// Returns the folders the library scans
+juce::Array<juce::File> MusicLibrary::getFolders() const {
+    const juce::ScopedLock sl(foldersLock);
+    return folders;
+}
+
+// Returns the latest index
+std::shared_ptr<const MusicLibrary::Index> MusicLibrary::getIndex() const {
+    const juce::ScopedLock sl(publishLock);
+    return published;
+}
+
+// Returns how far the current scan has got
+MusicLibrary::Progress MusicLibrary::getProgress() const {
+    return { scanning.load(), filesFound.load(), filesToRead.load(), filesRead.load() };
+}
+
+// The tracks live here between scans, so a rescan starts from the last one's result
+void MusicLibrary::run() {
+    std::vector<Track> tracks;
+    bool loaded = false;
+
+    while (!threadShouldExit()) {
+        rescanRequested.wait(-1.0);
+        if (threadShouldExit())
+            break;
+
+        scanning = true;
+        sendChangeMessage();
+
+        // The saved index is searchable before the first scan starts; a first run begins with the user's music folder
+        if (!loaded) {
+            loaded = true;
+
+            if (!loadIndex(tracks)) {
+                const juce::ScopedLock sl(foldersLock);
+                if (folders.isEmpty())
+                    folders.add(juce::File::getSpecialLocation(juce::File::userMusicDirectory));
+            }
+
+            publish(std::make_shared<const Index>(tracks));
+        }
+
+        bool changed = false;
+        const double startMs = juce::Time::getMillisecondCounterHiRes();
+
+        if (scanFolders(tracks, changed)) {
+            if (changed)
+                publish(std::make_shared<const Index>(tracks));
+
+            if (changed || foldersChanged.exchange(false))
+                saveIndex(tracks);
+
+            juce::Logger::outputDebugString("MusicLibrary: scanned " + juce::String(filesFound.load()) + " files, read "
+                                            + juce::String(filesRead.load()) + " in "
+                                            + juce::String(juce::Time::getMillisecondCounterHiRes() - startMs, 0) + " ms\n");
+        }
+
+        scanning = false;
+        sendChangeMessage();
+    }
+}
+
+// The index is gzipped, so the shared folder prefixes of the paths cost next to nothing
+bool MusicLibrary::loadIndex(std::vector<Track>& tracks) {
+    juce::FileInputStream file(indexFile);
+    if (!file.openedOk())
+        return false;
+
+    juce::GZIPDecompressorInputStream input(file);
+
+    const bool isIndex = input.readInt() == indexMagic;
+    const int version = input.readInt();
+
+    if (!isIndex || version < 1 || version > indexVersion) {
+        juce::Logger::outputDebugString("MusicLibrary: ignoring " + indexFile.getFullPathName() + ": not an index of this version\n");
+        return false;
+    }
+
+    juce::Array<juce::File> savedFolders;
+    const int numFolders = input.readInt();
+
+    for (int i = 0; i < numFolders && !input.isExhausted(); ++i)
+        savedFolders.add(juce::File(input.readString()));
+
+    const int numTracks = input.readInt();
+    if (numTracks < 0 || numTracks > maxTracks)
+        return false;
+
+    std::vector<Track> loadedTracks;
+    loadedTracks.reserve((size_t)numTracks);
+
+    for (int i = 0; i < numTracks; ++i) {
+        if (input.isExhausted()) {
+            juce::Logger::outputDebugString("MusicLibrary: ignoring " + indexFile.getFullPathName() + ": truncated\n");
+            return false;
+        }
+
+        Track track;
+        track.path = input.readString();
+        track.sizeBytes = input.readInt64();
+        track.modifiedMs = input.readInt64();
+        track.lengthSeconds = input.readFloat();
+        track.artist = input.readString();
+        track.title = input.readString();
+        track.album = input.readString();
+        track.unreadable = version >= 2 && input.readBool();
+        loadedTracks.push_back(std::move(track));
+    }
+
+    {
+        const juce::ScopedLock sl(foldersLock);
+        for (auto& folder : savedFolders)
+            if (!folders.contains(folder))
+                folders.add(folder);
+    }
+
+    tracks = std::move(loadedTracks);
+    return true;
+}
+
+// Writes the index and folders to a temporary file that then replaces the saved one
+void MusicLibrary::saveIndex(const std::vector<Track>& tracks) {
+    if (auto result = indexFile.getParentDirectory().createDirectory(); result.failed()) {
+        juce::Logger::outputDebugString("MusicLibrary: cannot save the index: " + result.getErrorMessage() + "\n");
+        return;
+    }
+
+    const auto foldersToSave = getFolders();
+    juce::TemporaryFile temporary(indexFile);
+
+    {
+        juce::FileOutputStream file(temporary.getFile());
+        if (!file.openedOk()) {
+            juce::Logger::outputDebugString("MusicLibrary: cannot write " + temporary.getFile().getFullPathName() + "\n");
+            return;
+        }
+
+        juce::GZIPCompressorOutputStream output(file);
+        output.writeInt(indexMagic);
+        output.writeInt(indexVersion);
+
+        output.writeInt(foldersToSave.size());
+        for (auto& folder : foldersToSave)
+            output.writeString(folder.getFullPathName());
+
+        output.writeInt((int)tracks.size());
+        for (auto& track : tracks) {
+            output.writeString(track.path);
+            output.writeInt64(track.sizeBytes);
+            output.writeInt64(track.modifiedMs);
+            output.writeFloat(track.lengthSeconds);
+            output.writeString(track.artist);
+            output.writeString(track.title);
+            output.writeString(track.album);
+            output.writeBool(track.unreadable);
+        }
+    }
+
+    if (!temporary.overwriteTargetFileWithTemporary())
+        juce::Logger::outputDebugString("MusicLibrary: cannot replace " + indexFile.getFullPathName() + "\n");
+}
+
+// Only the directory walk touches every file, and it reads no more than the directory entries;
+// files are opened only when new or changed, by the reader pool
+bool MusicLibrary::scanFolders(std::vector<Track>& tracks, bool& changed) {
+    const auto foldersToScan = getFolders();
+    const auto wildcard = formatManager.getWildcardForAllFormats();
+
+    std::unordered_map<juce::String, size_t> known;
+    known.reserve(tracks.size());
+    for (size_t i = 0; i < tracks.size(); ++i)
+        known.emplace(tracks[i].path, i);
+
+    std::vector<Track> scanned, pending;
+    scanned.reserve(tracks.size());
+    filesFound = 0;
+    filesToRead = 0;
+    filesRead = 0;
+
+    auto lastProgressMs = juce::Time::getMillisecondCounter();
+    auto reportProgress = [this, &lastProgressMs] {
+        const auto now = juce::Time::getMillisecondCounter();
+        if (now - lastProgressMs >= (juce::uint32)progressIntervalMs) {
+            lastProgressMs = now;
+            sendChangeMessage();
+        }
+    };
+
+    for (auto& folder : foldersToScan) {
+        // A folder that has gone, such as an unplugged drive, keeps its tracks until it comes back
+        if (!folder.isDirectory()) {
+            for (auto& track : tracks)
+                if (track.getFile().isAChildOf(folder))
+                    scanned.push_back(track);
+
+            continue;
+        }
+
+        for (const auto& entry : juce::RangedDirectoryIterator(folder, true, wildcard)) {
+            if (threadShouldExit())
+                return false;
+
+            Track track;
+            track.path = entry.getFile().getFullPathName();
+            track.sizeBytes = entry.getFileSize();
+            track.modifiedMs = entry.getModificationTime().toMilliseconds();
+            ++filesFound;
+
+            const auto found = known.find(track.path);
+            if (found != known.end() && tracks[found->second].sizeBytes == track.sizeBytes
+                && tracks[found->second].modifiedMs == track.modifiedMs)
+                scanned.push_back(tracks[found->second]);
+            else
+                pending.push_back(std::move(track));
+
+            reportProgress();
+        }
+    }
+
+    // Each job fills in its own slice of pending, so the jobs share nothing but the counter
+    std::vector<char> readOk(pending.size(), 0);
+    filesToRead = (int)pending.size();
+
+    for (size_t start = 0; start < pending.size(); start += (size_t)filesPerJob) {
+        const size_t end = juce::jmin(start + (size_t)filesPerJob, pending.size());
+
+        readerPool.addJob([this, &pending, &readOk, start, end] {
+            for (size_t i = start; i < end && !threadShouldExit(); ++i) {
+                readOk[i] = readTrack(pending[i].getFile(), pending[i]) ? 1 : 0;
+                ++filesRead;
+            }
+        });
+    }
+
+    // The jobs refer to pending and readOk, so they must all be gone before returning, even when abandoning
+    while (readerPool.getNumJobs() > 0) {
+        wait(progressIntervalMs);
+        sendChangeMessage();
+    }
+
+    if (threadShouldExit())
+        return false;
+
+    changed = !pending.empty() || scanned.size() != tracks.size();
+
+    // A file that failed keeps its size and time, so the next scan skips it until it changes
+    for (size_t i = 0; i < pending.size(); ++i) {
+        pending[i].unreadable = readOk[i] == 0;
+        scanned.push_back(std::move(pending[i]));
+    }
+
+    tracks = std::move(scanned);
+    return true;
+}
+
+// Tag names differ between formats; a file without tags falls back on an "Artist - Title" file name
+bool MusicLibrary::readTrack(const juce::File& file, Track& track) const {
+    std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file));
+    if (reader == nullptr)
+        return false;
+
+    if (reader->sampleRate > 0.0)
+        track.lengthSeconds = (float)(reader->lengthInSamples / reader->sampleRate);
+
+    const auto& tags = reader->metadataValues;
+    track.artist = findTag(tags, { "artist", "IART", "id3artist" });
+    track.title = findTag(tags, { "title", "INAM", "id3title" });
+    track.album = findTag(tags, { "album", "IPRD", "id3album" });
+
+    if (track.title.isEmpty()) {
+        auto name = file.getFileNameWithoutExtension();
+
+        if (track.artist.isEmpty() && name.contains(" - ")) {
+            track.artist = name.upToFirstOccurrenceOf(" - ", false, false).trim();
+            name = name.fromFirstOccurrenceOf(" - ", false, false).trim();
+        }
+
+        track.title = name;
+    }
+
+    return true;
+}
+
+// Swaps the pointer under the lock; listeners hear about it on the message thread
+void MusicLibrary::publish(std::shared_ptr<const Index> newIndex) {
+    {
+        const juce::ScopedLock sl(publishLock);
+        published = std::move(newIndex);
+    }
+
+    sendChangeMessage();
+}
@@ -0,0 +1,165 @@
+/*
+  ==============================================================================
+
+    MusicLibrary.h
+    Created: 18 Oct 2026 2:37:51am
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// The tracks under the user's music folders, kept in a compact index file and searchable as you type.
+//
+// A background thread loads the saved index, publishes it straight away and only then walks the
+// folders, so startup never waits for a scan. Files whose size and modification time match the
+// index keep their entry; new and changed ones are opened through the shared AudioFormatManager on
+// a pool of worker threads for their tags and duration. A file no format can open keeps an entry
+// marked unreadable, so it isn't retried until it changes. The finished scan replaces the index in
+// memory and, gzipped, on disk.
+//
+// Every published index is an immutable snapshot, like WaveformPyramid's, with posting lists of the
+// tracks holding each trigram of their search text and each one- and two-letter word prefix, so a
+// query only looks at the tracks that can match it. A change message goes out whenever a new index
+// is published and now and then while a scan is in progress.
+class MusicLibrary : public juce::ChangeBroadcaster,
+                     private juce::Thread {
+public:
+
+    // One track in the library
+    struct Track {
+        juce::String path;
+        juce::int64 sizeBytes = 0;
+        juce::int64 modifiedMs = 0;
+        float lengthSeconds = 0.0f;
+        juce::String artist;
+        juce::String title;
+        juce::String album;
+
+        // Set when no format could open the file; such entries only stop it being reread, and are left out of the index
+        bool unreadable = false;
+
+        // Returns the track's file
+        juce::File getFile() const { return juce::File(path); }
+    };
+
+    // The tracks and the search structures built over them
+    class Index {
+    public:
+        // Drops unreadable entries, sorts the rest by artist then title and indexes their artist, title, album and file name
+        explicit Index(std::vector<Track> tracksToIndex);
+
+        // Returns the tracks in index order
+        const std::vector<Track>& getTracks() const { return tracks; }
+
+        // Returns the positions of the tracks matching every word of the query, in index order and at
+        // most maxResults of them. A word of three letters or more matches anywhere in the text, a
+        // shorter one the start of a word; an empty query matches everything (any thread).
+        std::vector<int> search(const juce::String& query, int maxResults) const;
+
+    private:
+        // Returns the tracks holding a key, or an empty range if none do
+        std::pair<const int*, const int*> findPostings(juce::uint32 key) const;
+
+        std::vector<Track> tracks;
+
+        // Lower-case search text of every track, as UTF-8
+        std::vector<std::string> searchText;
+
+        // Sorted keys and, for key i, the sorted track positions postings[postingStarts[i] .. postingStarts[i + 1])
+        std::vector<juce::uint32> keys;
+        std::vector<int> postingStarts;
+        std::vector<int> postings;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Index)
+    };
+
+    // Scan progress, for display
+    struct Progress {
+        bool scanning = false;
+        int filesFound = 0;
+        int filesToRead = 0;
+        int filesRead = 0;
+    };
+
+    // Files handed to a reader job at a time
+    static constexpr int filesPerJob = 32;
+
+    // Time between change messages during a scan
+    static constexpr int progressIntervalMs = 250;
+
+    // Constructor: formatManager must have its formats registered before the first rescan, and
+    // outlive the library
+    MusicLibrary(juce::AudioFormatManager& formatManager, const juce::File& indexFile);
+
+    // Destructor: abandons any scan in progress
+    ~MusicLibrary() override;
+
+    // Returns the per-user index file the app uses
+    static juce::File getDefaultIndexFile();
+
+    // Loads the saved index the first time, then rescans the folders in the background;
+    // a request during a scan runs another one after it (message thread)
+    void rescan();
+
+    // Adds a folder to the library and rescans (message thread)
+    void addFolder(const juce::File& folder);
+
+    // Returns the folders the library scans
+    juce::Array<juce::File> getFolders() const;
+
+    // Returns the latest index, or nullptr before the saved one has loaded (any thread)
+    std::shared_ptr<const Index> getIndex() const;
+
+    // Returns how far the current scan has got (any thread)
+    Progress getProgress() const;
+
+private:
+    // Waits for rescan requests and runs them (scan thread)
+    void run() override;
+
+    // Reads the saved index and folders; false if there is none or it can't be read (scan thread)
+    bool loadIndex(std::vector<Track>& tracks);
+
+    // Writes the index and folders to a temporary file that then replaces the saved one (scan thread)
+    void saveIndex(const std::vector<Track>& tracks);
+
+    // Walks the folders, rereading only new and changed files, readable or not; sets changed if any
+    // entry came, went or was reread. False if abandoned (scan thread)
+    bool scanFolders(std::vector<Track>& tracks, bool& changed);
+
+    // Opens a file for its tags and duration; false if no format can read it (reader pool)
+    bool readTrack(const juce::File& file, Track& track) const;
+
+    // Swaps in a new index and tells listeners
+    void publish(std::shared_ptr<const Index> newIndex);
+
+    juce::AudioFormatManager& formatManager;
+    const juce::File indexFile;
+
+    // Folders to scan; the scan thread works on a copy
+    mutable juce::CriticalSection foldersLock;
+    juce::Array<juce::File> folders;
+
+    // Set when the folders change, so the next scan saves the index even if no track changed
+    std::atomic<bool> foldersChanged{ false };
+
+    // Signalled by rescan(); the scan thread runs one scan per signal, however many arrived meanwhile
+    juce::WaitableEvent rescanRequested;
+
+    // Opens new and changed files in parallel
+    juce::ThreadPool readerPool{ juce::jmax(1, juce::SystemStats::getNumCpus() - 1) };
+
+    std::atomic<bool> scanning{ false };
+    std::atomic<int> filesFound{ 0 };
+    std::atomic<int> filesToRead{ 0 };
+    std::atomic<int> filesRead{ 0 };
+
+    // Latest index; the lock only covers swapping the pointer
+    juce::CriticalSection publishLock;
+    std::shared_ptr<const Index> published;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MusicLibrary)
+};
@@ -0,0 +1,172 @@
+/*
+  ==============================================================================
+
+    OfflineRenderer.cpp
+    Created: 17 Oct 2026 7:48:12pm
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#include "OfflineRenderer.h"
+#include "djAudioPlayer.h"
+#include "DeckMixer.h"
+#include <iostream>
+
+// Constructor for OfflineRenderer
+OfflineRenderer::OfflineRenderer(double rate, int maxBlockSize, int bits)
+    : sampleRate(rate), blockSize(maxBlockSize), bitsPerSample(bits) {
+}
+
+// Runs the script block by block, applying each event at its exact sample
+juce::Result OfflineRenderer::render(const MixScript& script, const juce::File& outputFile) {
+    stats = {};
+
+    // Same graph as MainComponent: the left half of the decks on the left of the crossfader
+    juce::OwnedArray<DJAudioPlayer> players;
+    DeckMixer mixer;
+    const int numDecks = script.getNumDecks();
+
+    for (int i = 0; i < numDecks; ++i) {
+        auto* player = players.add(new DJAudioPlayer());
+        player->setReadAheadSize(0);  // Read-ahead depends on thread timing; straight reads are repeatable
+        mixer.addDeck(player, i < numDecks / 2 ? DeckMixer::CrossfaderSide::left : DeckMixer::CrossfaderSide::right);
+    }
+
+    outputFile.deleteFile();
+    std::unique_ptr<juce::FileOutputStream> stream(outputFile.createOutputStream());
+    if (stream == nullptr)
+        return juce::Result::fail("cannot write " + outputFile.getFullPathName());
+
+    juce::WavAudioFormat wavFormat;
+    std::unique_ptr<juce::AudioFormatWriter> writer(wavFormat.createWriterFor(stream.get(), sampleRate, 2, bitsPerSample, {}, 0));
+    if (writer == nullptr)
+        return juce::Result::fail("cannot write a " + juce::String(bitsPerSample) + "-bit WAV file");
+    stream.release();  // Now owned by the writer
+
+    mixer.prepareToPlay(blockSize, sampleRate);
+
+    // Cue points per deck, cycled through by jump events like the JUMP CUE button
+    std::vector<std::vector<double>> cuePoints((size_t)numDecks);
+    std::vector<int> cueIndex((size_t)numDecks, -1);
+
+    const auto& events = script.getEvents();
+    const juce::int64 endSample = (juce::int64)std::llround(script.getEndTimeSeconds() * sampleRate);
+    auto eventSample = [this](const MixEvent& event) { return (juce::int64)std::llround(event.timeSeconds * sampleRate); };
+
+    juce::AudioBuffer<float> buffer(2, blockSize);
+    juce::int64 position = 0;
+    size_t nextEvent = 0;
+    juce::Result result = juce::Result::ok();
+
+    const auto start = juce::Time::getHighResolutionTicks();
+
+    while (position < endSample && result.wasOk()) {
+        // Deck commands queued here are applied by each deck at the start of the next block
+        while (nextEvent < events.size() && eventSample(events[nextEvent]) <= position) {
+            const auto& event = events[nextEvent++];
+            auto* player = event.deck >= 0 ? players[event.deck] : nullptr;
+
+            switch (event.type) {
+            case MixEvent::Type::load:
+                if (!player->loadURLNow(juce::URL(event.file)))
+                    result = juce::Result::fail("cannot load " + event.file.getFullPathName());
+                break;
+            case MixEvent::Type::play:       player->start(); break;
+            case MixEvent::Type::stop:       player->stop(); break;
+            case MixEvent::Type::gain:       player->setGain(event.value); break;
+            case MixEvent::Type::speed:      player->setspeed(event.value); break;
+            case MixEvent::Type::keylock:    player->setKeylock(event.value > 0.5); break;
+            case MixEvent::Type::seek:       player->setPosition(event.value); break;
+            case MixEvent::Type::crossfader: mixer.setCrossfader((float)event.value); break;
+            case MixEvent::Type::cue:
+                cuePoints[(size_t)event.deck].push_back(event.value);
+                break;
+            case MixEvent::Type::jumpCue: {
+                auto& cues = cuePoints[(size_t)event.deck];
+                auto& index = cueIndex[(size_t)event.deck];
+                if (!cues.empty()) {
+                    index = (index + 1) % (int)cues.size();
+                    player->setPosition(cues[(size_t)index]);
+                }
+                break;
+            }
+            case MixEvent::Type::end:
+                break;
+            }
+        }
+
+        // Stop the block at the next event so it lands on its exact sample
+        juce::int64 blockEnd = juce::jmin(endSample, position + blockSize);
+        if (nextEvent < events.size())
+            blockEnd = juce::jmin(blockEnd, eventSample(events[nextEvent]));
+
+        const int numSamples = (int)(blockEnd - position);
+        juce::AudioSourceChannelInfo info(&buffer, 0, numSamples);
+        mixer.getNextAudioBlock(info);
+
+        if (!writer->writeFromAudioSampleBuffer(buffer, 0, numSamples))
+            result = juce::Result::fail("write failed on " + outputFile.getFullPathName());
+
+        position = blockEnd;
+    }
+
+    stats.wallSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+    stats.audioSeconds = (double)position / sampleRate;
+
+    mixer.releaseResources();
+    return result;
+}
+
+int OfflineRenderer::runFromCommandLine(const juce::StringArray& arguments) {
+    auto option = [&arguments](const char* name) {
+        const int index = arguments.indexOf(name);
+        return index >= 0 ? arguments[index + 1].unquoted() : juce::String();
+    };
+
+    const auto scriptPath = option("--render");
+    const auto outputPath = option("--out");
+    const auto rate = option("--rate");
+    const auto block = option("--block");
+    const auto bits = option("--bits");
+
+    const double sampleRate = rate.isNotEmpty() ? rate.getDoubleValue() : 44100.0;
+    const int bitDepth = bits.isNotEmpty() ? bits.getIntValue() : 24;
+
+    // A rate that doesn't parse reads as 0, so the range check catches it too
+    const bool rateOk = sampleRate >= 8000.0 && sampleRate <= 384000.0;
+    const bool bitsOk = bitDepth == 16 || bitDepth == 24 || bitDepth == 32;
+
+    if (scriptPath.isEmpty() || outputPath.isEmpty() || !rateOk || !bitsOk) {
+        std::cerr << "usage: OtoDesks --render <script> --out <file.wav> [--rate 8000-384000] [--block samples] [--bits 16|24|32]" << std::endl;
+        return 1;
+    }
+
+    auto resolve = [](const juce::String& path) {
+        return juce::File::getCurrentWorkingDirectory().getChildFile(path);
+    };
+
+    MixScript script;
+    const auto parsed = script.loadFrom(resolve(scriptPath));
+    if (parsed.failed()) {
+        std::cerr << scriptPath << ": " << parsed.getErrorMessage() << std::endl;
+        return 1;
+    }
+
+    OfflineRenderer renderer(sampleRate,
+        block.isNotEmpty() ? juce::jlimit(16, 65536, block.getIntValue()) : 512,
+        bitDepth);
+
+    const auto outputFile = resolve(outputPath);
+    const auto rendered = renderer.render(script, outputFile);
+    if (rendered.failed()) {
+        std::cerr << rendered.getErrorMessage() << std::endl;
+        return 1;
+    }
+
+    const auto& stats = renderer.getStats();
+    std::cout << "rendered " << juce::String(stats.audioSeconds, 1) << " s of audio in "
+        << juce::String(stats.wallSeconds, 2) << " s (" << juce::String(stats.getRealtimeFactor(), 1)
+        << "x realtime) to " << outputFile.getFullPathName() << std::endl;
+    return 0;
+}
@@ -0,0 +1,50 @@
+/*
+  ==============================================================================
+
+    OfflineRenderer.h
+    Created: 17 Oct 2026 7:48:12pm
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "MixScript.h"
+
+// OfflineRenderer class
+// Plays a mix script through the same decks and mixer as the app, without a window or an audio device,
+// as fast as the CPU allows, and writes the result to a WAV file. Tracks are read straight from disk
+// and blocks are split at event times, so the same script always renders the same samples. Each load
+// measures its track before the render goes on, so the decks' loudness auto-trim is applied as in the app.
+class OfflineRenderer {
+public:
+    // Timing of the last render
+    struct Stats {
+        double audioSeconds = 0.0;
+        double wallSeconds = 0.0;
+        double getRealtimeFactor() const { return wallSeconds > 0.0 ? audioSeconds / wallSeconds : 0.0; }
+    };
+
+    // Constructor: output sample rate, largest block rendered at once and WAV bit depth (16, 24 or 32 for float)
+    OfflineRenderer(double sampleRate = 44100.0, int blockSize = 512, int bitsPerSample = 24);
+
+    // Renders the script into outputFile, replacing it
+    juce::Result render(const MixScript& script, const juce::File& outputFile);
+
+    // Returns the timing of the last render
+    const Stats& getStats() const { return stats; }
+
+    // Handles "--render script --out file.wav [--rate hz] [--block samples] [--bits 16|24|32]"
+    // and returns the process exit code; a rate outside 8000-384000 Hz or another bit depth gets the usage message
+    static int runFromCommandLine(const juce::StringArray& arguments);
+
+private:
+    double sampleRate;
+    int blockSize;
+    int bitsPerSample;
+    Stats stats;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OfflineRenderer)
+};
@@ -0,0 +1,123 @@
+/*
+  ==============================================================================
+
+    ProfilerOverlay.cpp
+    Created: 17 Oct 2026 8:52:40pm
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#include "ProfilerOverlay.h"
+
+namespace {
+    // How often the profiler is drained, and the least time between automatic log reports
+    constexpr int refreshHz = 4;
+    constexpr double autoDumpIntervalMs = 5000.0;
+
+    constexpr int lineHeight = 16;
+    constexpr int fixedLines = 5;  // Title, callback, budget, MIDI latency and counters
+}
+
+// Constructor for ProfilerOverlay
+ProfilerOverlay::ProfilerOverlay(AudioProfiler& profilerToRead, juce::AudioDeviceManager& deviceManagerToWatch)
+    : profiler(profilerToRead), deviceManager(deviceManagerToWatch)
+{
+    // Purely informational, so clicks go through to the decks underneath
+    setInterceptsMouseClicks(false, false);
+
+    // The timer keeps the ring drained even while the overlay is hidden
+    startTimerHz(refreshHz);
+}
+
+// Destructor for ProfilerOverlay
+ProfilerOverlay::~ProfilerOverlay()
+{
+    stopTimer();
+}
+
+juce::Rectangle<int> ProfilerOverlay::getPreferredBounds(int numDecks)
+{
+    return { 0, 0, 430, (fixedLines + numDecks) * lineHeight + 12 };
+}
+
+void ProfilerOverlay::paint(juce::Graphics& g)
+{
+    g.setColour(juce::Colours::black.withAlpha(0.75f));
+    g.fillRoundedRectangle(getLocalBounds().toFloat(), 6.0f);
+
+    g.setFont(juce::Font(juce::Font::getDefaultMonospacedFontName(), 13.0f, juce::Font::plain));
+
+    auto area = getLocalBounds().reduced(8, 6);
+    const auto drawLine = [&g, &area](const juce::String& text, juce::Colour colour) {
+        g.setColour(colour);
+        g.drawText(text, area.removeFromTop(lineHeight), juce::Justification::centredLeft, false);
+    };
+
+    const auto formatRow = [](const juce::String& label, const AudioProfiler::Percentiles& percentiles, const char* unit) {
+        return label
+            + juce::String(percentiles.p50, 0).paddedLeft(' ', 7) + unit
+            + juce::String(percentiles.p99, 0).paddedLeft(' ', 7) + unit
+            + juce::String(percentiles.max, 0).paddedLeft(' ', 7) + unit;
+    };
+
+    drawLine("Audio thread       p50    p99    max  (budget " + juce::String(summary.budgetMicros, 0) + " us)", juce::Colours::white);
+
+    // Callback time turns orange past half the budget and red once a deadline is at risk
+    const float p99 = summary.budgetUsedPercent.p99;
+    const auto loadColour = p99 > 90.0f ? juce::Colours::red : p99 > 50.0f ? juce::Colours::orange : juce::Colours::lightgreen;
+    drawLine(formatRow("callback us  ", summary.callbackMicros, " "), loadColour);
+    drawLine(formatRow("budget %     ", summary.budgetUsedPercent, " "), loadColour);
+
+    for (int deck = 0; deck < summary.numDecks; ++deck)
+        drawLine(formatRow("deck " + juce::String(deck + 1) + " us    ", summary.deckMicros[(size_t)deck], " ")
+            + " load " + juce::String(summary.deckLoadPercent[(size_t)deck], 1) + "%", juce::Colours::lightgrey);
+
+    // MIDI latency to the audio thread; the device's output latency comes on top before it is heard
+    if (summary.numControllerCallbacks > 0)
+    {
+        auto* device = deviceManager.getCurrentAudioDevice();
+        const double outputMicros = device != nullptr && device->getCurrentSampleRate() > 0.0
+            ? device->getOutputLatencyInSamples() * 1.0e6 / device->getCurrentSampleRate() : 0.0;
+
+        drawLine(formatRow("midi us      ", summary.controllerLatencyMicros, " ")
+            + " +" + juce::String(outputMicros + summary.budgetMicros, 0) + " out", juce::Colours::lightgrey);
+    }
+    else
+    {
+        drawLine("midi us      no controller input yet", juce::Colours::grey);
+    }
+
+    const int xruns = deviceManager.getXRunCount();
+    drawLine("missed " + juce::String((juce::int64)summary.missedDeadlines)
+        + "  xruns " + (xruns >= 0 ? juce::String(xruns) : juce::String("n/a"))
+        + "  dropped " + juce::String((juce::int64)summary.droppedTimings),
+        summary.missedDeadlines > 0 ? juce::Colours::red : juce::Colours::lightgrey);
+}
+
+void ProfilerOverlay::timerCallback()
+{
+    profiler.collect();
+    summary = profiler.getSummary();
+
+    // Report each new run of missed deadlines, at most every few seconds
+    const double nowMs = juce::Time::getMillisecondCounterHiRes();
+    if (summary.missedDeadlines > loggedMissedDeadlines && nowMs - lastAutoDumpMs >= autoDumpIntervalMs)
+    {
+        juce::Logger::outputDebugString("ProfilerOverlay: " + juce::String((juce::int64)(summary.missedDeadlines - loggedMissedDeadlines))
+            + " audio callback(s) missed their deadline\n");
+        dumpToLog();
+        loggedMissedDeadlines = summary.missedDeadlines;
+        lastAutoDumpMs = nowMs;
+    }
+
+    if (isVisible())
+        repaint();
+}
+
+void ProfilerOverlay::dumpToLog()
+{
+    profiler.collect();
+    summary = profiler.getSummary();
+    juce::Logger::writeToLog(AudioProfiler::formatSummary(summary, deviceManager.getXRunCount()));
+}
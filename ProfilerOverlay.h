@@ -0,0 +1,53 @@
+/*
+  ==============================================================================
+
+    ProfilerOverlay.h
+    Created: 17 Oct 2026 8:52:40pm
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "AudioProfiler.h"
+
+// ProfilerOverlay class
+// Reads the audio profiler on the message thread a few times a second and, when shown, draws its
+// percentiles and per-deck load over the decks. Also writes a report to the log whenever a callback
+// misses its deadline, so a dropout always leaves data behind.
+class ProfilerOverlay : public juce::Component,
+    public juce::Timer
+{
+public:
+    // Constructor: both the profiler and the device manager must outlive the overlay
+    ProfilerOverlay(AudioProfiler& profilerToRead, juce::AudioDeviceManager& deviceManagerToWatch);
+
+    // Destructor
+    ~ProfilerOverlay() override;
+
+    // paint: Draws the latest summary in a translucent panel
+    void paint(juce::Graphics& g) override;
+
+    // Drains the profiler, logs new missed deadlines and repaints while visible
+    void timerCallback() override;
+
+    // Writes the latest summary to the log
+    void dumpToLog();
+
+    // Size the overlay needs to show a given number of decks
+    static juce::Rectangle<int> getPreferredBounds(int numDecks);
+
+private:
+    AudioProfiler& profiler;
+    juce::AudioDeviceManager& deviceManager;
+
+    AudioProfiler::Summary summary;
+
+    // Missed deadlines at the last automatic report, and when it was written
+    juce::uint64 loggedMissedDeadlines = 0;
+    double lastAutoDumpMs = 0.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ProfilerOverlay)
+};
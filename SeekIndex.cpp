@@ -0,0 +1,348 @@
+/*
+  ==============================================================================
+
+    SeekIndex.cpp
+    Created: 17 Oct 2026 11:36:52pm
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#include "SeekIndex.h"
+
+namespace {
+    constexpr int formatVersion = 1;
+
+    // Frame offsets searched either way when lining the index up with the decoder
+    constexpr int maxOffsetFrames = 3;
+
+    // Layer III header fields of one frame
+    struct MpegFrame {
+        int versionBits = 0;
+        int sampleRate = 0;
+        int samplesPerFrame = 0;
+        int lengthInBytes = 0;
+    };
+
+    // Parses a four-byte layer III frame header; false for anything else, including free-format frames
+    bool parseFrameHeader(const juce::uint8* header, MpegFrame& frame) {
+        if (header[0] != 0xff || (header[1] & 0xe0) != 0xe0)
+            return false;
+
+        const int versionBits = (header[1] >> 3) & 3;  // 3 = MPEG-1, 2 = MPEG-2, 0 = MPEG-2.5
+        const int layerBits = (header[1] >> 1) & 3;  // 1 = layer III
+        const int bitrateIndex = header[2] >> 4;
+        const int sampleRateIndex = (header[2] >> 2) & 3;
+        const int padding = (header[2] >> 1) & 1;
+
+        if (versionBits == 1 || layerBits != 1 || bitrateIndex == 0 || bitrateIndex == 15 || sampleRateIndex == 3)
+            return false;
+
+        static const int mpeg1Kbps[] = { 0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320 };
+        static const int mpeg2Kbps[] = { 0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160 };
+        static const int mpeg1Rates[] = { 44100, 48000, 32000 };
+
+        const bool mpeg1 = versionBits == 3;
+        const int bitrate = (mpeg1 ? mpeg1Kbps : mpeg2Kbps)[bitrateIndex] * 1000;
+
+        frame.versionBits = versionBits;
+        frame.sampleRate = mpeg1Rates[sampleRateIndex] >> (mpeg1 ? 0 : versionBits == 2 ? 1 : 2);
+        frame.samplesPerFrame = mpeg1 ? 1152 : 576;
+        frame.lengthInBytes = (mpeg1 ? 144 : 72) * bitrate / frame.sampleRate + padding;
+        return true;
+    }
+
+    // Skips an ID3v2 tag at the start of the stream, if there is one
+    void skipId3Tag(juce::InputStream& input) {
+        juce::uint8 tag[10];
+        if (input.read(tag, 10) == 10 && tag[0] == 'I' && tag[1] == 'D' && tag[2] == '3') {
+            const juce::int64 size = ((tag[6] & 0x7f) << 21) | ((tag[7] & 0x7f) << 14) | ((tag[8] & 0x7f) << 7) | (tag[9] & 0x7f);
+            const bool hasFooter = (tag[5] & 0x10) != 0;
+            input.setPosition(10 + size + (hasFooter ? 10 : 0));
+        }
+        else {
+            input.setPosition(0);
+        }
+    }
+}
+
+bool SeekIndex::isEmpty() const {
+    return checkpoints.empty() || samplesPerFrame <= 0;
+}
+
+// Binary search for the last checkpoint at least the preroll before the sample
+const SeekIndex::Checkpoint* SeekIndex::findStartFor(juce::int64 sample) const {
+    if (isEmpty())
+        return nullptr;
+
+    const juce::int64 latestStart = sample - (juce::int64)prerollFrames * samplesPerFrame;
+    auto after = std::upper_bound(checkpoints.begin(), checkpoints.end(), latestStart,
+        [](juce::int64 value, const Checkpoint& checkpoint) { return value < checkpoint.sample; });
+
+    return after == checkpoints.begin() ? nullptr : &*(after - 1);
+}
+
+void SeekIndex::writeTo(juce::OutputStream& output) const {
+    output.writeInt(formatVersion);
+    output.writeInt(samplesPerFrame);
+    output.writeInt64((juce::int64)checkpoints.size());
+
+    for (const auto& checkpoint : checkpoints) {
+        output.writeInt64(checkpoint.sample);
+        output.writeInt64(checkpoint.byteOffset);
+    }
+}
+
+bool SeekIndex::readFrom(juce::InputStream& input) {
+    if (input.readInt() != formatVersion)
+        return false;
+
+    samplesPerFrame = input.readInt();
+    const juce::int64 numCheckpoints = input.readInt64();
+
+    // Each checkpoint is two int64s; anything that doesn't fit the stream is a damaged entry
+    if (numCheckpoints < 0 || numCheckpoints * 16 > input.getNumBytesRemaining())
+        return false;
+
+    checkpoints.resize((size_t)numCheckpoints);
+    for (auto& checkpoint : checkpoints) {
+        checkpoint.sample = input.readInt64();
+        checkpoint.byteOffset = input.readInt64();
+    }
+
+    return true;
+}
+
+// Syncs on the first header that is followed by another one where its length says, then walks
+// the frames one header at a time, skipping their contents
+SeekIndex SeekIndex::scanMpegFrames(juce::InputStream& source) {
+    juce::BufferedInputStream input(&source, 1 << 16, false);
+    skipId3Tag(input);
+
+    SeekIndex index;
+    juce::uint8 header[4];
+    MpegFrame first, frame;
+
+    // Look for the first frame within the opening stretch of the stream, past any padding or junk
+    constexpr int maxSyncSearchBytes = 1 << 16;
+    juce::int64 firstFrameOffset = -1;
+
+    for (int searched = 0; searched < maxSyncSearchBytes && firstFrameOffset < 0; ++searched) {
+        const juce::int64 position = input.getPosition();
+        if (input.read(header, 4) != 4)
+            return {};
+
+        if (parseFrameHeader(header, first)) {
+            input.setPosition(position + first.lengthInBytes);
+            if (input.read(header, 4) == 4 && parseFrameHeader(header, frame)
+                && frame.versionBits == first.versionBits && frame.sampleRate == first.sampleRate)
+                firstFrameOffset = position;
+        }
+
+        input.setPosition(firstFrameOffset >= 0 ? firstFrameOffset : position + 1);
+    }
+
+    if (firstFrameOffset < 0)
+        return {};
+
+    index.samplesPerFrame = first.samplesPerFrame;
+
+    // The audio ends at the first thing that isn't a frame of the same stream, such as an ID3v1 tag
+    for (juce::int64 frameIndex = 0;; ++frameIndex) {
+        const juce::int64 position = input.getPosition();
+        if (input.read(header, 4) != 4 || !parseFrameHeader(header, frame)
+            || frame.versionBits != first.versionBits || frame.sampleRate != first.sampleRate)
+            break;
+
+        if (frameIndex % checkpointInterval == 0)
+            index.checkpoints.push_back({ frameIndex * index.samplesPerFrame, position });
+
+        input.skipNextBytes(frame.lengthInBytes - 4);
+    }
+
+    return index;
+}
+
+const char* const SeekIndexBuilder::sectionName = "seekindex";
+
+// Constructor for SeekIndexBuilder
+SeekIndexBuilder::SeekIndexBuilder(const juce::File& file, juce::AudioFormatManager& manager)
+    : audioFile(file), formatManager(manager) {
+
+}
+
+// Only MP3s are indexed; the other formats the app reads already seek directly
+void SeekIndexBuilder::decodeStarted(int numChannels, double sampleRate, juce::int64 lengthInSamples) {
+    juce::ignoreUnused(numChannels, sampleRate);
+
+    index = {};
+    alignmentStart = -1;
+
+    if (!audioFile.hasFileExtension("mp3") || lengthInSamples < 4 * alignmentLength)
+        return;
+
+    alignmentStart = lengthInSamples / 2;
+    alignmentSamples.assign((size_t)alignmentLength, 0.0f);
+}
+
+void SeekIndexBuilder::decodeBlock(const juce::AudioBuffer<float>& buffer, juce::int64 startSample, int numSamples) {
+    if (alignmentStart < 0)
+        return;
+
+    const juce::int64 overlapStart = juce::jmax(startSample, alignmentStart);
+    const juce::int64 overlapEnd = juce::jmin(startSample + numSamples, alignmentStart + alignmentLength);
+
+    for (juce::int64 sample = overlapStart; sample < overlapEnd; ++sample)
+        alignmentSamples[(size_t)(sample - alignmentStart)] = buffer.getSample(0, (int)(sample - startSample));
+}
+
+void SeekIndexBuilder::decodeFinished(bool completed) {
+    if (!completed || alignmentStart < 0)
+        return;
+
+    juce::FileInputStream input(audioFile);
+    if (!input.openedOk())
+        return;
+
+    SeekIndex scanned = SeekIndex::scanMpegFrames(input);
+    juce::int64 offset = 0;
+
+    if (scanned.isEmpty() || !findDecoderOffset(scanned, offset)) {
+        juce::Logger::outputDebugString("SeekIndexBuilder: no seek index for " + audioFile.getFileName() + "\n");
+        return;
+    }
+
+    for (auto& checkpoint : scanned.checkpoints)
+        checkpoint.sample += offset;
+
+    index = std::move(scanned);
+}
+
+juce::String SeekIndexBuilder::getCacheSectionName() const {
+    return sectionName;
+}
+
+// Writes the index, which is empty for tracks that aren't indexed
+void SeekIndexBuilder::saveToCache(juce::OutputStream& output) {
+    index.writeTo(output);
+}
+
+// Readers load the index straight from the cache entry, so this only checks that it is intact
+bool SeekIndexBuilder::loadFromCache(juce::InputStream& input) {
+    return index.readFrom(input);
+}
+
+// Decodes from a checkpoint well before the samples kept from the pass, then slides the two against
+// each other a whole sample at a time. Past the preroll the decoder's output is bit-exact, so only
+// the true offset matches; silence matches everywhere and is rejected.
+bool SeekIndexBuilder::findDecoderOffset(const SeekIndex& scanned, juce::int64& offset) const {
+    const float peak = juce::FloatVectorOperations::findMaximum(alignmentSamples.data(), alignmentLength);
+    const float trough = juce::FloatVectorOperations::findMinimum(alignmentSamples.data(), alignmentLength);
+    if (juce::jmax(peak, -trough) < 1.0e-4f)
+        return false;
+
+    const int maxOffset = maxOffsetFrames * scanned.samplesPerFrame;
+    const auto* checkpoint = scanned.findStartFor(alignmentStart - maxOffset);
+    auto* format = formatManager.findFormatForFileExtension(audioFile.getFileExtension());
+
+    if (checkpoint == nullptr || format == nullptr)
+        return false;
+
+    auto file = std::make_unique<juce::FileInputStream>(audioFile);
+    if (!file->openedOk())
+        return false;
+
+    std::unique_ptr<juce::AudioFormatReader> reader(format->createReaderFor(
+        new juce::SubregionStream(file.release(), checkpoint->byteOffset, -1, true), true));
+
+    if (reader == nullptr)
+        return false;
+
+    const int numToDecode = (int)(alignmentStart - checkpoint->sample) + maxOffset + alignmentLength;
+    juce::AudioBuffer<float> decoded((int)reader->numChannels, numToDecode);
+    reader->readSamples(reinterpret_cast<int* const*>(decoded.getArrayOfWritePointers()), (int)reader->numChannels, 0, 0, numToDecode);
+
+    const int minStart = SeekIndex::prerollFrames * scanned.samplesPerFrame;
+
+    for (int distance = 0; distance <= maxOffset; ++distance) {
+        for (int candidate : { distance, -distance }) {
+            const juce::int64 start = alignmentStart - checkpoint->sample - candidate;
+            if (start < minStart || start + alignmentLength > numToDecode)
+                continue;
+
+            const float* decodedSamples = decoded.getReadPointer(0, (int)start);
+            bool matches = true;
+
+            for (int i = 0; i < alignmentLength && matches; ++i)
+                matches = std::abs(decodedSamples[i] - alignmentSamples[(size_t)i]) <= 1.0e-6f;
+
+            if (matches) {
+                offset = candidate;
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+// Constructor for SeekIndexedReader
+SeekIndexedReader::SeekIndexedReader(juce::AudioFormat& audioFormat, const juce::File& file, SeekIndex seekIndex,
+    std::unique_ptr<juce::AudioFormatReader> wholeFileReader)
+    : juce::AudioFormatReader(nullptr, wholeFileReader->getFormatName()),
+      format(audioFormat), audioFile(file), index(std::move(seekIndex)), decoder(std::move(wholeFileReader)) {
+    sampleRate = decoder->sampleRate;
+    bitsPerSample = 32;
+    lengthInSamples = decoder->lengthInSamples;
+    numChannels = decoder->numChannels;
+    usesFloatingPointData = true;
+    metadataValues = decoder->metadataValues;
+
+    discard.setSize((int)numChannels, 4096);
+}
+
+// Short hops forward are decoded through rather than restarted, since a fresh decoder has to
+// decode its preroll anyway
+bool SeekIndexedReader::readSamples(int* const* destChannels, int numDestChannels, int startOffsetInDestBuffer,
+    juce::int64 startSampleInFile, int numSamples) {
+    const juce::int64 maxDecodeThrough = (juce::int64)(SeekIndex::checkpointInterval + SeekIndex::prerollFrames) * index.samplesPerFrame;
+
+    if (decoder == nullptr || startSampleInFile < decoderPosition || startSampleInFile - decoderPosition > maxDecodeThrough)
+        if (!startDecoderFor(startSampleInFile))
+            return false;
+
+    while (decoderPosition < startSampleInFile) {
+        const int numToDiscard = (int)juce::jmin((juce::int64)discard.getNumSamples(), startSampleInFile - decoderPosition);
+        decoder->readSamples(reinterpret_cast<int* const*>(discard.getArrayOfWritePointers()), (int)numChannels, 0,
+            decoderPosition - decoderStart, numToDiscard);
+        decoderPosition += numToDiscard;
+    }
+
+    const bool ok = decoder->readSamples(destChannels, numDestChannels, startOffsetInDestBuffer,
+        startSampleInFile - decoderStart, numSamples);
+    decoderPosition = startSampleInFile + numSamples;
+    return ok;
+}
+
+bool SeekIndexedReader::startDecoderFor(juce::int64 sample) {
+    decoder.reset();
+
+    auto file = std::make_unique<juce::FileInputStream>(audioFile);
+    if (!file->openedOk())
+        return false;
+
+    // Before the first usable checkpoint the decoder simply starts at the top of the file
+    const auto* checkpoint = index.findStartFor(sample);
+    juce::InputStream* stream = file.release();
+    if (checkpoint != nullptr)
+        stream = new juce::SubregionStream(stream, checkpoint->byteOffset, -1, true);
+
+    decoder.reset(format.createReaderFor(stream, true));
+    decoderStart = checkpoint != nullptr ? checkpoint->sample : 0;
+    decoderPosition = decoderStart;
+
+    if (decoder == nullptr)
+        juce::Logger::outputDebugString("SeekIndexedReader could not reopen " + audioFile.getFileName() + "\n");
+
+    return decoder != nullptr;
+}
@@ -0,0 +1,125 @@
+/*
+  ==============================================================================
+
+    SeekIndex.h
+    Created: 17 Oct 2026 11:36:52pm
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "TrackDecoder.h"
+
+// Frame offset table of an MPEG layer III track: where every few frames start in the file and the
+// sample each one decodes to. A reader can start decoding at the checkpoint just before any position
+// instead of scanning the file from the top, and the table is small enough to keep in the track cache.
+struct SeekIndex {
+    struct Checkpoint {
+        juce::int64 sample = 0;  // First sample the frame decodes to, on the timeline of a reader over the whole file
+        juce::int64 byteOffset = 0;  // Start of the frame's header in the file
+    };
+
+    // Frames between checkpoints
+    static constexpr int checkpointInterval = 8;
+
+    // Frames decoded and thrown away after a checkpoint before the output is exact, covering the
+    // bit reservoir and the decoder's overlap
+    static constexpr int prerollFrames = 8;
+
+    int samplesPerFrame = 0;
+    std::vector<Checkpoint> checkpoints;
+
+    // Returns true if the index holds no checkpoints, e.g. for a format that doesn't need one
+    bool isEmpty() const;
+
+    // Returns the last checkpoint from which decoding reaches sample exactly, or nullptr if decoding has
+    // to start at the top of the file
+    const Checkpoint* findStartFor(juce::int64 sample) const;
+
+    // Writes the index to a stream, and reads back one written by writeTo()
+    void writeTo(juce::OutputStream& output) const;
+    bool readFrom(juce::InputStream& input);
+
+    // Finds the frames of an MPEG layer III stream by their headers alone, without decoding anything.
+    // Checkpoint samples are nominal (frame index times frame length) until lined up with a decoder.
+    // Returns an empty index for any other stream, or if the frames don't follow on from each other.
+    static SeekIndex scanMpegFrames(juce::InputStream& input);
+};
+
+// Builds a track's seek index during its decode pass. Once the pass completes it scans the file's
+// frame headers, then lines the nominal frame positions up with the decoder by decoding a few frames
+// from a checkpoint half-way through and matching them against the samples the pass decoded there.
+// If they never match exactly the index is left empty and the track is read the ordinary way.
+class SeekIndexBuilder : public TrackDecodeConsumer {
+public:
+    // Constructor: both must outlive the builder
+    SeekIndexBuilder(const juce::File& audioFile, juce::AudioFormatManager& formatManager);
+
+    // TrackDecodeConsumer: keeps the samples around the middle of the track for the alignment check
+    void decodeStarted(int numChannels, double sampleRate, juce::int64 lengthInSamples) override;
+    void decodeBlock(const juce::AudioBuffer<float>& buffer, juce::int64 startSample, int numSamples) override;
+    void decodeFinished(bool completed) override;
+
+    // TrackDecodeConsumer: the index is cached next to the waveform and beat grid
+    juce::String getCacheSectionName() const override;
+    void saveToCache(juce::OutputStream& output) override;
+    bool loadFromCache(juce::InputStream& input) override;
+
+    // Name of the index's section in a track cache entry
+    static const char* const sectionName;
+
+    // Samples compared when lining the index up with the decoder
+    static constexpr int alignmentLength = 4096;
+
+private:
+    // Finds the offset between nominal frame positions and the decoder's output; false if none matches
+    bool findDecoderOffset(const SeekIndex& scanned, juce::int64& offset) const;
+
+    const juce::File audioFile;
+    juce::AudioFormatManager& formatManager;
+
+    // First channel of the decoded samples at alignmentStart, or -1 when the track isn't indexed
+    juce::int64 alignmentStart = -1;
+    std::vector<float> alignmentSamples;
+
+    SeekIndex index;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SeekIndexBuilder)
+};
+
+// Reads an indexed track like an ordinary reader, but a read that doesn't follow on from the last
+// one starts a fresh decoder at the checkpoint just before it, over a stream of the file beginning
+// at that frame, and decodes only the preroll and the few frames up to the wanted sample. Seeking
+// anywhere in a long MP3 therefore costs the same, and lands on exactly the sample an unindexed
+// reader would have produced.
+class SeekIndexedReader : public juce::AudioFormatReader {
+public:
+    // Constructor: wholeFileReader reads the file from the top and provides its length and layout;
+    // format must outlive the reader
+    SeekIndexedReader(juce::AudioFormat& format, const juce::File& audioFile, SeekIndex index,
+        std::unique_ptr<juce::AudioFormatReader> wholeFileReader);
+
+    // Continues the current decoder, or starts one at the nearest checkpoint
+    bool readSamples(int* const* destChannels, int numDestChannels, int startOffsetInDestBuffer,
+        juce::int64 startSampleInFile, int numSamples) override;
+
+private:
+    // Replaces the decoder with one that starts as close before sample as the index allows
+    bool startDecoderFor(juce::int64 sample);
+
+    juce::AudioFormat& format;
+    const juce::File audioFile;
+    const SeekIndex index;
+
+    // The decoder, the file sample its output starts at, and the next file sample it will produce
+    std::unique_ptr<juce::AudioFormatReader> decoder;
+    juce::int64 decoderStart = 0;
+    juce::int64 decoderPosition = 0;
+
+    // Receives the samples decoded on the way to a read's start
+    juce::AudioBuffer<float> discard;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SeekIndexedReader)
+};
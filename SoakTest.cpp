@@ -0,0 +1,378 @@
+/*
+  ==============================================================================
+
+    SoakTest.cpp
+    Created: 17 Oct 2026 9:31:50pm
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#include "SoakTest.h"
+#include <iostream>
+
+namespace {
+    // Actions kept for matching with overruns, and how far before an overrun they are listed
+    constexpr size_t maxRecentActions = 64;
+    constexpr double actionLookbackSeconds = 2.0;
+
+    // A swept speed knob goes from 0.5x to 1.5x and back over this period
+    constexpr double sweepPeriodSeconds = 8.0;
+
+    constexpr double progressIntervalSeconds = 60.0;
+
+    double ticksToSeconds(juce::int64 ticks) {
+        return juce::Time::highResolutionTicksToSeconds(ticks);
+    }
+
+    juce::String formatMillis(float micros) {
+        return juce::String(micros / 1000.0f, 2) + " ms";
+    }
+}
+
+// Constructor for SoakTest
+SoakTest::SoakTest(const Options& optionsToUse)
+    : options(optionsToUse), random(optionsToUse.seed)
+{
+    options.numDecks = juce::jlimit(DeckMixer::minDecks, DeckMixer::maxDecks, options.numDecks);
+
+    // The real component tree, without a window or a sound card
+    mainComponent = std::make_unique<MainComponent>(options.numDecks, false);
+    device = std::make_unique<VirtualAudioDevice>(*mainComponent, options.sampleRate, options.blockSize);
+    device->setListener(this);
+}
+
+// Destructor for SoakTest
+SoakTest::~SoakTest()
+{
+    stopTimer();
+    device = nullptr;
+    mainComponent = nullptr;
+}
+
+void SoakTest::start(std::function<void(int)> finishedCallback)
+{
+    onFinished = std::move(finishedCallback);
+
+    if (options.reportFile != juce::File())
+    {
+        options.reportFile.deleteFile();
+        report = std::make_unique<juce::FileOutputStream>(options.reportFile);
+
+        if (report->failedToOpen())
+        {
+            std::cerr << "soak: could not write " << options.reportFile.getFullPathName() << std::endl;
+            report = nullptr;
+        }
+    }
+
+    startTicks = juce::Time::getHighResolutionTicks();
+    lastProgressTicks = startTicks;
+
+    writeLine("soak: " + juce::String(options.numDecks) + " decks, " + juce::String(options.tracks.size()) + " tracks, "
+        + juce::String(options.sampleRate, 0) + " Hz, " + juce::String(options.blockSize) + " samples per block ("
+        + formatMillis((float)(options.blockSize * 1.0e6 / options.sampleRate)) + "), "
+        + juce::String(options.durationSeconds / 60.0, 1) + " minutes, action every " + juce::String(options.actionIntervalMs)
+        + " ms, seed " + juce::String(options.seed));
+
+    device->start();
+    startTimer(options.actionIntervalMs);
+}
+
+void SoakTest::timerCallback()
+{
+    const juce::int64 nowTicks = juce::Time::getHighResolutionTicks();
+
+    performRandomAction();
+
+    // Swept speed knobs move a little on every tick
+    for (int deckIndex = 0; deckIndex < options.numDecks; ++deckIndex)
+    {
+        if (!sweeping[(size_t)deckIndex])
+            continue;
+
+        sweepPhase[(size_t)deckIndex] += juce::MathConstants<double>::twoPi * options.actionIntervalMs / (sweepPeriodSeconds * 1000.0);
+
+        if (auto* speed = dynamic_cast<juce::Slider*>(mainComponent->getDeckGUI(deckIndex)->findChildWithID("speed")))
+            speed->setValue(1.0 + 0.5 * std::sin(sweepPhase[(size_t)deckIndex]), juce::sendNotificationSync);
+    }
+
+    reportOverruns();
+
+    if (ticksToSeconds(nowTicks - lastProgressTicks) >= progressIntervalSeconds)
+    {
+        lastProgressTicks = nowTicks;
+        writeLine(formatElapsed(nowTicks) + " " + juce::String(blocksRendered.load()) + " blocks, "
+            + juce::String(numOverruns.load()) + " overruns, " + juce::String(device->getNumSkippedBlocks()) + " skipped, worst callback "
+            + formatMillis(worstCallbackMicros.load()) + ", " + juce::String(actionsPerformed) + " actions");
+    }
+
+    if (ticksToSeconds(nowTicks - startTicks) >= options.durationSeconds)
+        finish();
+}
+
+void SoakTest::blockRendered(const VirtualAudioDevice::BlockTiming& timing)
+{
+    blocksRendered.store(timing.blockIndex + 1, std::memory_order_relaxed);
+
+    // Only this thread writes the worst case, so a plain compare is enough
+    if (timing.callbackMicros > worstCallbackMicros.load(std::memory_order_relaxed))
+        worstCallbackMicros.store(timing.callbackMicros, std::memory_order_relaxed);
+
+    if (!timing.missedDeadline())
+        return;
+
+    numOverruns.fetch_add(1, std::memory_order_relaxed);
+
+    if (overrunFifo.getFreeSpace() < 1)
+    {
+        unreportedOverruns.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // The decks were rendered on this thread, so their snapshots are the state of the late block
+    overrunFifo.write(1).forEach([this, &timing](int index) {
+        auto& overrun = overruns[(size_t)index];
+        overrun.timing = timing;
+        overrun.deckTiming = mainComponent->getLastCallbackTiming();
+
+        for (int deckIndex = 0; deckIndex < options.numDecks; ++deckIndex)
+            overrun.decks[(size_t)deckIndex] = mainComponent->getPlayer(deckIndex)->getSnapshot();
+    });
+}
+
+void SoakTest::performRandomAction()
+{
+    const int deckIndex = random.nextInt(options.numDecks);
+    auto* deck = mainComponent->getDeckGUI(deckIndex);
+    const juce::String deckName = "deck " + juce::String(deckIndex + 1);
+
+    // Buttons are clicked and knobs turned through the same listeners the mouse would reach
+    auto click = [deck](const juce::String& id) {
+        if (auto* button = dynamic_cast<juce::Button*>(deck->findChildWithID(id)))
+            button->triggerClick();
+    };
+
+    auto turn = [deck](const juce::String& id, double value) {
+        if (auto* slider = dynamic_cast<juce::Slider*>(deck->findChildWithID(id)))
+            slider->setValue(value, juce::sendNotificationSync);
+    };
+
+    const int roll = random.nextInt(100);
+
+    if (roll < 10)
+    {
+        const auto& track = options.tracks.getReference(random.nextInt(options.tracks.size()));
+        deck->filesDropped(juce::StringArray(track.getFullPathName()), 0, 0);
+        logAction(deckName + " load " + track.getFileName());
+    }
+    else if (roll < 25)
+    {
+        click("play");
+        logAction(deckName + " play");
+    }
+    else if (roll < 30)
+    {
+        click("stop");
+        logAction(deckName + " stop");
+    }
+    else if (roll < 50)
+    {
+        const double position = random.nextDouble();
+        turn("position", position);
+        logAction(deckName + " seek " + juce::String(position, 3));
+    }
+    else if (roll < 60)
+    {
+        click("setCue");
+        logAction(deckName + " set cue");
+    }
+    else if (roll < 70)
+    {
+        click("jumpCue");
+        logAction(deckName + " jump cue");
+    }
+    else if (roll < 75)
+    {
+        static const char* const loopControls[] = { "loopIn", "loopOut", "beatLoop", "halveLoop", "doubleLoop" };
+        const juce::String control = loopControls[random.nextInt(juce::numElementsInArray(loopControls))];
+        click(control);
+        logAction(deckName + " " + control);
+    }
+    else if (roll < 80)
+    {
+        sweeping[(size_t)deckIndex] = !sweeping[(size_t)deckIndex];
+        logAction(deckName + (sweeping[(size_t)deckIndex] ? " speed sweep on" : " speed sweep off"));
+    }
+    else if (roll < 85)
+    {
+        click("keylock");
+        logAction(deckName + " keylock toggle");
+    }
+    else if (roll < 90)
+    {
+        const double gain = random.nextDouble();
+        turn("volume", gain);
+        logAction(deckName + " volume " + juce::String(gain, 2));
+    }
+    else if (roll < 93)
+    {
+        // Queued tracks take over without a gap when the playing one ends, or at once on NEXT
+        if (random.nextBool())
+        {
+            const auto& track = options.tracks.getReference(random.nextInt(options.tracks.size()));
+            mainComponent->getPlayer(deckIndex)->appendToQueue(juce::URL{ track });
+            logAction(deckName + " queue " + track.getFileName());
+        }
+        else
+        {
+            click("next");
+            logAction(deckName + " next");
+        }
+    }
+    else if (auto* crossfader = dynamic_cast<juce::Slider*>(mainComponent->findChildWithID("crossfader")))
+    {
+        const double position = random.nextDouble();
+        crossfader->setValue(position, juce::sendNotificationSync);
+        logAction("crossfader " + juce::String(position, 2));
+    }
+}
+
+void SoakTest::logAction(const juce::String& description)
+{
+    recentActions.push_back({ juce::Time::getHighResolutionTicks(), description });
+    if (recentActions.size() > maxRecentActions)
+        recentActions.pop_front();
+
+    ++actionsPerformed;
+}
+
+void SoakTest::reportOverruns()
+{
+    overrunFifo.read(overrunFifo.getNumReady()).forEach([this](int index) {
+        reportOverrun(overruns[(size_t)index]);
+    });
+
+    if (const auto unreported = unreportedOverruns.exchange(0))
+        writeLine("    (" + juce::String(unreported) + " more overruns came too fast to report)");
+}
+
+void SoakTest::reportOverrun(const Overrun& overrun)
+{
+    const auto& timing = overrun.timing;
+    writeLine(formatElapsed(timing.dueTicks) + " block " + juce::String(timing.blockIndex) + " overran: callback "
+        + formatMillis(timing.callbackMicros) + " + woke " + formatMillis(timing.wakeLateMicros) + " late, budget "
+        + formatMillis(timing.budgetMicros));
+
+    for (int deckIndex = 0; deckIndex < options.numDecks; ++deckIndex)
+    {
+        const auto& deck = overrun.decks[(size_t)deckIndex];
+        writeLine("    deck " + juce::String(deckIndex + 1) + ": " + formatMillis(overrun.deckTiming.deckMicros[(size_t)deckIndex])
+            + ", " + (deck.playing ? "playing " : "stopped ") + juce::String(deck.speed, 2) + "x"
+            + (deck.keylock ? " keylock" : "") + " at " + juce::String(deck.getPositionInSeconds(), 1)
+            + " of " + juce::String(deck.getLengthInSeconds(), 1) + " s");
+    }
+
+    // What the user side had been doing just before the block was due
+    const auto ticksPerSecond = (double)juce::Time::getHighResolutionTicksPerSecond();
+    const auto fromTicks = timing.dueTicks - (juce::int64)(actionLookbackSeconds * ticksPerSecond);
+    const auto toTicks = timing.dueTicks + (juce::int64)(timing.budgetMicros * 1.0e-6 * ticksPerSecond);
+
+    juce::String actions;
+    for (const auto& action : recentActions)
+        if (action.ticks >= fromTicks && action.ticks <= toTicks)
+            actions << (actions.isEmpty() ? "" : "; ") << juce::String(ticksToSeconds(action.ticks - timing.dueTicks), 3)
+                    << " s " << action.description;
+
+    writeLine("    recent: " + (actions.isEmpty() ? juce::String("none") : actions));
+}
+
+void SoakTest::finish()
+{
+    stopTimer();
+    device->stop();
+    reportOverruns();
+
+    const auto overrunCount = numOverruns.load();
+    const auto skipped = device->getNumSkippedBlocks();
+
+    writeLine(formatElapsed(juce::Time::getHighResolutionTicks()) + " soak finished: " + juce::String(blocksRendered.load())
+        + " blocks, " + juce::String(overrunCount) + " overruns, " + juce::String(skipped) + " skipped, worst callback "
+        + formatMillis(worstCallbackMicros.load()) + ", " + juce::String(actionsPerformed) + " actions");
+
+    report = nullptr;
+
+    if (onFinished != nullptr)
+        onFinished(overrunCount > 0 || skipped > 0 ? 1 : 0);
+}
+
+void SoakTest::writeLine(const juce::String& line)
+{
+    std::cout << line << std::endl;
+
+    if (report != nullptr)
+    {
+        report->writeText(line + "\n", false, false, nullptr);
+        report->flush();  // So a run that is killed still leaves its report
+    }
+}
+
+juce::String SoakTest::formatElapsed(juce::int64 ticks) const
+{
+    const auto milliseconds = (juce::int64)(juce::jmax(0.0, ticksToSeconds(ticks - startTicks)) * 1000.0);
+
+    return "[" + juce::String(milliseconds / 3600000).paddedLeft('0', 2)
+        + ":" + juce::String((milliseconds / 60000) % 60).paddedLeft('0', 2)
+        + ":" + juce::String((milliseconds / 1000) % 60).paddedLeft('0', 2)
+        + "." + juce::String(milliseconds % 1000).paddedLeft('0', 3) + "]";
+}
+
+std::unique_ptr<SoakTest> SoakTest::createFromCommandLine(const juce::StringArray& arguments)
+{
+    auto option = [&arguments](const char* name) {
+        const int index = arguments.indexOf(name);
+        return index >= 0 ? arguments[index + 1].unquoted() : juce::String();
+    };
+
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+
+    // Every argument after --soak up to the next option is a track or a folder of tracks
+    Options options;
+    for (int i = arguments.indexOf("--soak") + 1; i < arguments.size() && !arguments[i].startsWith("--"); ++i)
+    {
+        const auto file = juce::File::getCurrentWorkingDirectory().getChildFile(arguments[i].unquoted());
+
+        if (file.isDirectory())
+            options.tracks.addArray(file.findChildFiles(juce::File::findFiles, true, formats.getWildcardForAllFormats()));
+        else if (file.existsAsFile())
+            options.tracks.add(file);
+        else
+            std::cerr << "soak: no such track or folder " << file.getFullPathName() << std::endl;
+    }
+
+    if (options.tracks.isEmpty())
+    {
+        std::cerr << "usage: OtoDesks --soak <track or folder>... [--minutes n] [--decks n] [--rate hz] [--block samples]"
+                     " [--interval ms] [--report file] [--seed n]" << std::endl;
+        return nullptr;
+    }
+
+    const auto minutes = option("--minutes");
+    const auto decks = option("--decks");
+    const auto rate = option("--rate");
+    const auto block = option("--block");
+    const auto interval = option("--interval");
+    const auto reportPath = option("--report");
+    const auto seed = option("--seed");
+
+    if (minutes.isNotEmpty()) options.durationSeconds = juce::jmax(0.1, minutes.getDoubleValue()) * 60.0;
+    if (decks.isNotEmpty()) options.numDecks = decks.getIntValue();
+    if (rate.isNotEmpty()) options.sampleRate = juce::jlimit(8000.0, 384000.0, rate.getDoubleValue());
+    if (block.isNotEmpty()) options.blockSize = juce::jlimit(16, 8192, block.getIntValue());
+    if (interval.isNotEmpty()) options.actionIntervalMs = juce::jlimit(1, 10000, interval.getIntValue());
+    if (reportPath.isNotEmpty()) options.reportFile = juce::File::getCurrentWorkingDirectory().getChildFile(reportPath);
+    options.seed = seed.isNotEmpty() ? seed.getLargeIntValue() : juce::Time::currentTimeMillis();
+
+    return std::make_unique<SoakTest>(options);
+}
@@ -0,0 +1,119 @@
+/*
+  ==============================================================================
+
+    SoakTest.h
+    Created: 17 Oct 2026 9:31:50pm
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "MainComponent.h"
+#include "VirtualAudioDevice.h"
+#include <deque>
+
+// SoakTest class
+// Long-running headless stress test for machines without a sound card. A VirtualAudioDevice drives the
+// app's MainComponent in real time while a timer on the message thread works the deck controls at
+// random: loads, play and stop, seeks, cue points, loops, speed sweeps, keylock, volume and crossfader moves.
+// Every callback that overruns its deadline is reported with the deck state at the time and the
+// actions that led up to it.
+class SoakTest : private juce::Timer,
+    private VirtualAudioDevice::Listener
+{
+public:
+    struct Options {
+        juce::Array<juce::File> tracks;
+        int numDecks = 2;
+        double sampleRate = 44100.0;
+        int blockSize = 512;
+        double durationSeconds = 3600.0;
+        int actionIntervalMs = 40;
+        juce::File reportFile;  // Optional copy of the report
+        juce::int64 seed = 0;
+    };
+
+    // Constructor: builds the decks but doesn't start anything yet
+    explicit SoakTest(const Options& options);
+
+    // Destructor: stops the device before the decks it drives
+    ~SoakTest() override;
+
+    // Starts the device and the stress actions. onFinished is called on the message thread with the
+    // process exit code (0 if no callback overran) once the duration has passed
+    void start(std::function<void(int)> onFinished);
+
+    // Handles "--soak <track or folder>... [--minutes n] [--decks n] [--rate hz] [--block samples]
+    // [--interval ms] [--report file] [--seed n]"; prints the usage and returns nullptr if it can't
+    static std::unique_ptr<SoakTest> createFromCommandLine(const juce::StringArray& arguments);
+
+private:
+    // A callback that overran, captured on the device thread
+    struct Overrun {
+        VirtualAudioDevice::BlockTiming timing;
+        AudioProfiler::CallbackTiming deckTiming;
+        std::array<DeckSnapshot, DeckMixer::maxDecks> decks;
+    };
+
+    // A stress action, kept so overruns can be matched with what preceded them
+    struct Action {
+        juce::int64 ticks = 0;
+        juce::String description;
+    };
+
+    // Performs the next action, keeps the speed sweeps moving and reports overruns (message thread)
+    void timerCallback() override;
+
+    // Records overruns for the message thread to report (device thread)
+    void blockRendered(const VirtualAudioDevice::BlockTiming& timing) override;
+
+    // Picks a deck and a control at random and operates it the way a user would
+    void performRandomAction();
+    void logAction(const juce::String& description);
+
+    // Writes the overruns the device thread has queued
+    void reportOverruns();
+    void reportOverrun(const Overrun& overrun);
+
+    // Stops the device and writes the final summary
+    void finish();
+
+    // Writes a line to stdout and the report file
+    void writeLine(const juce::String& line);
+
+    // Time since start() as [hh:mm:ss.mmm]
+    juce::String formatElapsed(juce::int64 ticks) const;
+
+    Options options;
+    juce::Random random;
+
+    // Declared before the device, so the device (which calls into it) is destroyed first
+    std::unique_ptr<MainComponent> mainComponent;
+    std::unique_ptr<VirtualAudioDevice> device;
+
+    std::function<void(int)> onFinished;
+    std::unique_ptr<juce::FileOutputStream> report;
+    juce::int64 startTicks = 0;
+    juce::int64 lastProgressTicks = 0;
+
+    // Overruns waiting to be reported, filled by the device thread
+    juce::AbstractFifo overrunFifo{ 256 };
+    std::vector<Overrun> overruns = std::vector<Overrun>(256);
+
+    // Counters written by the device thread
+    std::atomic<juce::int64> blocksRendered{ 0 };
+    std::atomic<juce::int64> numOverruns{ 0 };
+    std::atomic<juce::int64> unreportedOverruns{ 0 };
+    std::atomic<float> worstCallbackMicros{ 0.0f };
+
+    // Most recent actions, and the decks whose speed knob is being swept
+    std::deque<Action> recentActions;
+    juce::int64 actionsPerformed = 0;
+    std::array<bool, DeckMixer::maxDecks> sweeping{};
+    std::array<double, DeckMixer::maxDecks> sweepPhase{};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SoakTest)
+};
@@ -0,0 +1,290 @@
+/*
+  ==============================================================================
+
+    SpectralWaveform.cpp
+    Created: 18 Oct 2026 1:04:37am
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#include "SpectralWaveform.h"
+
+namespace {
+    constexpr int fftSize = SpectralWaveform::samplesPerColumn;
+    constexpr int halfSize = fftSize / 2;
+
+    // Converts band energy relative to full scale to an 8-bit level
+    juce::uint8 toLevel(float energy, float fullScale) {
+        const float db = 10.0f * std::log10(energy / fullScale + 1.0e-12f);
+        return (juce::uint8)juce::jlimit(0, 255, juce::roundToInt(255.0f * (1.0f + db / SpectralWaveform::dynamicRangeDb)));
+    }
+
+    // Converts an 8-bit level back to a linear amplitude
+    float toAmplitude(juce::uint8 level) {
+        if (level == 0)
+            return 0.0f;
+
+        return std::pow(10.0f, (level / 255.0f - 1.0f) * SpectralWaveform::dynamicRangeDb / 20.0f);
+    }
+}
+
+// Builds the window, twiddle and bit-reversal tables once, so a frame only does arithmetic
+SpectralWaveform::SpectralWaveform()
+    : window((size_t)fftSize), twiddles((size_t)fftSize), bitReversed((size_t)halfSize),
+      frame((size_t)fftSize), spectrum((size_t)fftSize) {
+    float sumOfSquares = 0.0f;
+
+    for (int n = 0; n < fftSize; ++n) {
+        window[(size_t)n] = 0.5f - 0.5f * std::cos(juce::MathConstants<float>::twoPi * n / fftSize);
+        sumOfSquares += window[(size_t)n] * window[(size_t)n];
+    }
+
+    // A sine of amplitude 1 leaves a quarter of fftSize times the window's energy in one half of the spectrum
+    fullScalePower = fftSize * sumOfSquares / 4.0f;
+
+    for (int k = 0; k < halfSize; ++k) {
+        const double angle = juce::MathConstants<double>::twoPi * k / fftSize;
+        twiddles[(size_t)(k * 2)] = (float)std::cos(angle);
+        twiddles[(size_t)(k * 2 + 1)] = (float)std::sin(angle);
+    }
+
+    for (int i = 0; i < halfSize; ++i) {
+        int reversed = 0;
+        for (int bit = 0; bit < fftOrder - 1; ++bit)
+            if ((i >> bit) & 1)
+                reversed |= 1 << (fftOrder - 2 - bit);
+
+        bitReversed[(size_t)i] = reversed;
+    }
+}
+
+// Returns the latest complete analysis
+std::shared_ptr<const SpectralWaveform::Columns> SpectralWaveform::getColumns() const {
+    const juce::ScopedLock sl(publishLock);
+    return published;
+}
+
+// Drops the current analysis
+void SpectralWaveform::clear() {
+    publish(nullptr);
+}
+
+// Starts a new analysis sized for the whole track and places the band edges for its sample rate
+void SpectralWaveform::decodeStarted(int numChannels, double sampleRate, juce::int64 lengthInSamples) {
+    juce::ignoreUnused(numChannels);
+
+    building = std::make_unique<Columns>();
+    building->sampleRate = sampleRate;
+    building->lengthInSamples = lengthInSamples;
+    building->columns.reserve((size_t)(lengthInSamples / samplesPerColumn + 1));
+
+    lowMidBin = juce::jlimit(1, halfSize, (int)std::ceil(lowMidHz * fftSize / sampleRate));
+    midHighBin = juce::jlimit(lowMidBin, halfSize, (int)std::ceil(midHighHz * fftSize / sampleRate));
+
+    samplesInFrame = 0;
+    framePeak = 0.0f;
+}
+
+// Downmixes the block into the frame, analysing it each time it fills
+void SpectralWaveform::decodeBlock(const juce::AudioBuffer<float>& buffer, juce::int64 startSample, int numSamples) {
+    juce::ignoreUnused(startSample);
+
+    if (building == nullptr)
+        return;
+
+    const int numChannels = buffer.getNumChannels();
+    const float channelGain = 1.0f / (float)juce::jmax(1, numChannels);
+    int i = 0;
+
+    while (i < numSamples) {
+        const int count = juce::jmin(fftSize - samplesInFrame, numSamples - i);
+        float* destination = frame.data() + samplesInFrame;
+
+        for (int channel = 0; channel < numChannels; ++channel) {
+            const float* source = buffer.getReadPointer(channel, i);
+
+            if (channel == 0)
+                juce::FloatVectorOperations::copyWithMultiply(destination, source, channelGain, count);
+            else
+                juce::FloatVectorOperations::addWithMultiply(destination, source, channelGain, count);
+
+            const auto range = juce::FloatVectorOperations::findMinAndMax(source, count);
+            framePeak = juce::jmax(framePeak, -range.getStart(), range.getEnd());
+        }
+
+        i += count;
+        samplesInFrame += count;
+
+        if (samplesInFrame == fftSize)
+            analyseFrame(fftSize);
+    }
+}
+
+// Analyses the last partial frame and publishes the result
+void SpectralWaveform::decodeFinished(bool completed) {
+    if (building == nullptr)
+        return;
+
+    if (completed) {
+        if (samplesInFrame > 0)
+            analyseFrame(samplesInFrame);
+
+        buildColours(*building);
+        publish(std::shared_ptr<const Columns>(building.release()));
+    }
+
+    building.reset();
+}
+
+// Names the analysis' section in the track cache
+juce::String SpectralWaveform::getCacheSectionName() const {
+    return "spectrum";
+}
+
+// Writes the columns as they are, four bytes each
+void SpectralWaveform::saveToCache(juce::OutputStream& output) {
+    const auto analysis = getColumns();
+    if (analysis == nullptr)
+        return;
+
+    output.writeDouble(analysis->sampleRate);
+    output.writeInt64(analysis->lengthInSamples);
+    output.writeInt(samplesPerColumn);
+    output.writeInt(analysis->getNumColumns());
+    output.write(analysis->columns.data(), analysis->columns.size() * sizeof(Column));
+}
+
+// Reads the columns back and works out their colours again
+bool SpectralWaveform::loadFromCache(juce::InputStream& input) {
+    auto analysis = std::make_unique<Columns>();
+    analysis->sampleRate = input.readDouble();
+    analysis->lengthInSamples = input.readInt64();
+    const int columnSamples = input.readInt();
+    const int numColumns = input.readInt();
+
+    if (analysis->sampleRate <= 0.0 || columnSamples != samplesPerColumn || numColumns < 0
+        || input.getNumBytesRemaining() < (juce::int64)numColumns * (juce::int64)sizeof(Column))
+        return false;
+
+    analysis->columns.resize((size_t)numColumns);
+    input.read(analysis->columns.data(), numColumns * (int)sizeof(Column));
+
+    buildColours(*analysis);
+    publish(std::shared_ptr<const Columns>(analysis.release()));
+    return true;
+}
+
+// A real frame of fftSize samples is transformed as fftSize / 2 complex ones (even samples real,
+// odd ones imaginary) and the two interleaved halves separated afterwards, halving the work
+void SpectralWaveform::analyseFrame(int numSamples) {
+    if (numSamples < fftSize)
+        std::fill(frame.begin() + numSamples, frame.end(), 0.0f);
+
+    juce::FloatVectorOperations::multiply(spectrum.data(), frame.data(), window.data(), fftSize);
+    transformHalf(spectrum.data());
+
+    const float* z = spectrum.data();
+    float low = 0.0f, mid = 0.0f, high = 0.0f;
+
+    // Bin halfSize (Nyquist) comes from bin 0 of the half-size transform; DC is left out
+    const float nyquist = z[0] - z[1];
+    high += nyquist * nyquist;
+
+    for (int k = 1; k < halfSize; ++k) {
+        const float ar = z[k * 2], ai = z[k * 2 + 1];
+        const float br = z[(halfSize - k) * 2], bi = -z[(halfSize - k) * 2 + 1];
+
+        const float evenRe = 0.5f * (ar + br), evenIm = 0.5f * (ai + bi);
+        const float oddRe = 0.5f * (ai - bi), oddIm = -0.5f * (ar - br);
+
+        const float c = twiddles[(size_t)(k * 2)], s = twiddles[(size_t)(k * 2 + 1)];
+        const float re = evenRe + c * oddRe + s * oddIm;
+        const float im = evenIm + c * oddIm - s * oddRe;
+        const float power = re * re + im * im;
+
+        if (k < lowMidBin)
+            low += power;
+        else if (k < midHighBin)
+            mid += power;
+        else
+            high += power;
+    }
+
+    Column column;
+    column.peak = (juce::uint8)juce::jlimit(0, 255, (int)std::ceil(framePeak * 255.0f));
+    column.low = toLevel(low, fullScalePower);
+    column.mid = toLevel(mid, fullScalePower);
+    column.high = toLevel(high, fullScalePower);
+    building->columns.push_back(column);
+
+    samplesInFrame = 0;
+    framePeak = 0.0f;
+}
+
+// Iterative radix-2 decimation in time; the half-size transform's twiddles are every other one of the full size's
+void SpectralWaveform::transformHalf(float* data) const {
+    for (int i = 0; i < halfSize; ++i) {
+        const int j = bitReversed[(size_t)i];
+        if (i < j) {
+            std::swap(data[i * 2], data[j * 2]);
+            std::swap(data[i * 2 + 1], data[j * 2 + 1]);
+        }
+    }
+
+    for (int size = 2; size <= halfSize; size *= 2) {
+        const int half = size / 2;
+        const int step = fftSize / size;
+
+        for (int start = 0; start < halfSize; start += size) {
+            for (int j = 0; j < half; ++j) {
+                const float c = twiddles[(size_t)(j * step * 2)], s = twiddles[(size_t)(j * step * 2 + 1)];
+                float* a = data + (start + j) * 2;
+                float* b = data + (start + j + half) * 2;
+
+                // b times e^(-i angle)
+                const float tr = b[0] * c + b[1] * s;
+                const float ti = b[1] * c - b[0] * s;
+
+                b[0] = a[0] - tr;
+                b[1] = a[1] - ti;
+                a[0] += tr;
+                a[1] += ti;
+            }
+        }
+    }
+}
+
+// Low drives red, mid green and high blue, scaled so the strongest band is at full brightness
+void SpectralWaveform::buildColours(Columns& analysis) {
+    analysis.colours.resize(analysis.columns.size());
+
+    for (size_t i = 0; i < analysis.columns.size(); ++i) {
+        const auto& column = analysis.columns[i];
+        const float low = toAmplitude(column.low);
+        const float mid = toAmplitude(column.mid);
+        const float high = toAmplitude(column.high);
+        const float strongest = juce::jmax(low, mid, high);
+
+        if (strongest <= 0.0f) {
+            analysis.colours[i] = juce::Colours::grey.getARGB();
+            continue;
+        }
+
+        auto channel = [strongest](float amplitude) {
+            return (juce::uint8)juce::roundToInt(255.0f * amplitude / strongest);
+        };
+
+        analysis.colours[i] = juce::Colour(channel(low), channel(mid), channel(high)).getARGB();
+    }
+}
+
+// Swaps the pointer under the lock; listeners hear about it on the message thread
+void SpectralWaveform::publish(std::shared_ptr<const Columns> newColumns) {
+    {
+        const juce::ScopedLock sl(publishLock);
+        published = std::move(newColumns);
+    }
+
+    sendChangeMessage();
+}
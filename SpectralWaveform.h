@@ -0,0 +1,107 @@
+/*
+  ==============================================================================
+
+    SpectralWaveform.h
+    Created: 18 Oct 2026 1:04:37am
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "TrackDecoder.h"
+
+// Low, mid and high band energy of a track, column by column, for a frequency-coloured overview.
+//
+// Built during the deck's decode pass on the analysis thread: every samplesPerColumn samples of
+// the mono downmix go through one windowed FFT, and the column keeps its peak level and the
+// energy below lowMidHz, between the two edges and above midHighHz, 8 bits each. The colour of
+// every column is worked out once when the analysis is published, so drawing only looks it up.
+//
+// Published as an immutable snapshot the same way as WaveformPyramid; a change message goes
+// out whenever a new one (or none) is published.
+class SpectralWaveform : public TrackDecodeConsumer,
+                         public juce::ChangeBroadcaster {
+public:
+
+    // One analysed column; the peak is linear, the bands on a dB scale from -dynamicRangeDb to 0 dB
+    struct Column {
+        juce::uint8 peak = 0;
+        juce::uint8 low = 0;
+        juce::uint8 mid = 0;
+        juce::uint8 high = 0;
+    };
+
+    // A complete analysis
+    struct Columns {
+        double sampleRate = 0.0;
+        juce::int64 lengthInSamples = 0;
+        std::vector<Column> columns;
+        std::vector<juce::uint32> colours;  // ARGB, one per column
+
+        // Returns the number of columns
+        int getNumColumns() const { return (int)columns.size(); }
+    };
+
+    // Samples per column, which is also the FFT size
+    static constexpr int fftOrder = 10;
+    static constexpr int samplesPerColumn = 1 << fftOrder;
+
+    // Band edges and the range of the 8-bit band levels
+    static constexpr double lowMidHz = 250.0;
+    static constexpr double midHighHz = 4000.0;
+    static constexpr float dynamicRangeDb = 60.0f;
+
+    // Constructor
+    SpectralWaveform();
+
+    // Returns the latest complete analysis, or nullptr if there is none (any thread)
+    std::shared_ptr<const Columns> getColumns() const;
+
+    // Drops the current analysis, e.g. before another track is loaded (any thread)
+    void clear();
+
+    // TrackDecodeConsumer: one FFT per column as the blocks arrive
+    void decodeStarted(int numChannels, double sampleRate, juce::int64 lengthInSamples) override;
+    void decodeBlock(const juce::AudioBuffer<float>& buffer, juce::int64 startSample, int numSamples) override;
+    void decodeFinished(bool completed) override;
+
+    // TrackDecodeConsumer: the columns are cached as they are, the colours rebuilt on load
+    juce::String getCacheSectionName() const override;
+    void saveToCache(juce::OutputStream& output) override;
+    bool loadFromCache(juce::InputStream& input) override;
+
+private:
+    // Windows and transforms the filled frame, then appends its column
+    void analyseFrame(int numSamples);
+
+    // In-place complex FFT of fftSize / 2 points, held as interleaved real and imaginary parts
+    void transformHalf(float* data) const;
+
+    // Works out the colour of every column
+    static void buildColours(Columns& analysis);
+
+    // Swaps in a new analysis and tells listeners
+    void publish(std::shared_ptr<const Columns> newColumns);
+
+    // Tables shared by every frame
+    std::vector<float> window;
+    std::vector<float> twiddles;  // cos and sin of each step of the full-size transform
+    std::vector<int> bitReversed;
+    float fullScalePower = 1.0f;  // Band energy of a full-scale sine
+
+    // Analysis under construction (decoding thread only)
+    std::unique_ptr<Columns> building;
+    std::vector<float> frame;
+    std::vector<float> spectrum;
+    int samplesInFrame = 0;
+    float framePeak = 0.0f;
+    int lowMidBin = 0, midHighBin = 0;
+
+    // Latest complete analysis; the lock only covers swapping the pointer
+    juce::CriticalSection publishLock;
+    std::shared_ptr<const Columns> published;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectralWaveform)
+};
@@ -0,0 +1,229 @@
+/*
+  ==============================================================================
+
+    TimeStretchAudioSource.cpp
+    Created: 17 Oct 2026 1:58:07pm
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#include "TimeStretchAudioSource.h"
+#include "VectorOps.h"
+
+// Constructor for TimeStretchAudioSource
+TimeStretchAudioSource::TimeStretchAudioSource(juce::AudioSource* inputSource, bool deleteInputWhenDeleted, int channels)
+    : input(inputSource, deleteInputWhenDeleted), numChannels(juce::jmax(1, channels)) {
+    jassert(inputSource != nullptr);
+}
+
+// Destructor for TimeStretchAudioSource
+TimeStretchAudioSource::~TimeStretchAudioSource() {
+
+}
+
+// Sets the stretch ratio, clamped to the supported range
+void TimeStretchAudioSource::setStretchRatio(double newRatio) {
+    ratio = juce::jlimit(minRatio, maxRatio, newRatio);
+}
+
+// Returns the current stretch ratio
+double TimeStretchAudioSource::getStretchRatio() const {
+    return ratio;
+}
+
+// Clears all state so the next block starts cleanly from the input's current position
+void TimeStretchAudioSource::reset() {
+    inputBuffer.clear();
+    overlapTail.clear();
+    outputBuffer.clear();
+
+    // The search window needs searchRadius samples before the first frame, so start with that much silence
+    inputFilled = searchRadius;
+    analysisPosition = searchRadius;
+    hasTail = false;
+    outputReadPosition = hopSize;
+}
+
+// Sizes the frames for the sample rate and allocates everything the audio thread will need
+void TimeStretchAudioSource::prepareToPlay(int samplesPerBlockExpected, double sampleRate) {
+    input->prepareToPlay(samplesPerBlockExpected, sampleRate);
+
+    // 20 ms hops (40 ms frames) and a +/-7.5 ms search suit most music
+    hopSize = juce::jmax(64, juce::roundToInt(sampleRate * 0.020));
+    searchRadius = juce::jmax(16, juce::roundToInt(sampleRate * 0.0075));
+
+    const int inputCapacity = 2 * searchRadius + 2 * hopSize + 16;
+    inputBuffer.setSize(numChannels, inputCapacity);
+    overlapTail.setSize(numChannels, hopSize);
+    outputBuffer.setSize(numChannels, hopSize);
+
+    fadeIn.resize((size_t)hopSize);
+    fadeOut.resize((size_t)hopSize);
+    for (int i = 0; i < hopSize; ++i) {
+        const float phase = juce::MathConstants<float>::pi * ((float)i + 0.5f) / (float)hopSize;
+        fadeIn[(size_t)i] = 0.5f - 0.5f * std::cos(phase);
+        fadeOut[(size_t)i] = 1.0f - fadeIn[(size_t)i];
+    }
+
+    monoRegion.resize((size_t)(2 * searchRadius + hopSize));
+    monoTail.resize((size_t)hopSize);
+    energyPrefix.resize(monoRegion.size() + 1);
+
+    reset();
+}
+
+// Releases the input's resources
+void TimeStretchAudioSource::releaseResources() {
+    input->releaseResources();
+}
+
+// Hands out synthesised output, producing new hops whenever the current one runs out
+void TimeStretchAudioSource::getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill) {
+    if (hopSize == 0) {
+        // Not prepared yet
+        bufferToFill.clearActiveBufferRegion();
+        return;
+    }
+
+    int done = 0;
+
+    while (done < bufferToFill.numSamples) {
+        if (outputReadPosition >= hopSize)
+            produceHop();
+
+        const int numThisTime = juce::jmin(bufferToFill.numSamples - done, hopSize - outputReadPosition);
+
+        for (int channel = 0; channel < bufferToFill.buffer->getNumChannels(); ++channel)
+            bufferToFill.buffer->copyFrom(channel, bufferToFill.startSample + done,
+                outputBuffer, juce::jmin(channel, numChannels - 1), outputReadPosition, numThisTime);
+
+        outputReadPosition += numThisTime;
+        done += numThisTime;
+    }
+}
+
+// One WSOLA step: pick the best-matching segment, crossfade it in and keep its continuation
+void TimeStretchAudioSource::produceHop() {
+    const int nominal = (int)analysisPosition;
+    fillInput(nominal + searchRadius + 2 * hopSize);
+
+    const int segment = hasTail ? findBestSegment(nominal) : nominal;
+
+    for (int channel = 0; channel < numChannels; ++channel) {
+        auto* out = outputBuffer.getWritePointer(channel);
+        const auto* in = inputBuffer.getReadPointer(channel, segment);
+
+        if (hasTail) {
+            juce::FloatVectorOperations::multiply(out, overlapTail.getReadPointer(channel), fadeOut.data(), hopSize);
+            juce::FloatVectorOperations::addWithMultiply(out, in, fadeIn.data(), hopSize);
+        }
+        else {
+            juce::FloatVectorOperations::copy(out, in, hopSize);
+        }
+
+        juce::FloatVectorOperations::copy(overlapTail.getWritePointer(channel), in + hopSize, hopSize);
+    }
+
+    // The continuation of this segment is the template the next search has to match
+    juce::FloatVectorOperations::copy(monoTail.data(), overlapTail.getReadPointer(0), hopSize);
+    for (int channel = 1; channel < numChannels; ++channel)
+        juce::FloatVectorOperations::add(monoTail.data(), overlapTail.getReadPointer(channel), hopSize);
+
+    hasTail = true;
+    outputReadPosition = 0;
+    analysisPosition += hopSize * ratio;
+
+    compactInput();
+}
+
+// Pulls exactly the missing samples from the input
+void TimeStretchAudioSource::fillInput(int numRequired) {
+    jassert(numRequired <= inputBuffer.getNumSamples());
+
+    if (inputFilled >= numRequired)
+        return;
+
+    juce::AudioSourceChannelInfo info(&inputBuffer, inputFilled, numRequired - inputFilled);
+    input->getNextAudioBlock(info);
+    inputFilled = numRequired;
+}
+
+// Coarse-to-fine search for the offset with the highest normalised correlation to the template
+int TimeStretchAudioSource::findBestSegment(int nominalPosition) {
+    const int regionStart = nominalPosition - searchRadius;
+    const int regionLength = (int)monoRegion.size();
+    auto* region = monoRegion.data();
+
+    juce::FloatVectorOperations::copy(region, inputBuffer.getReadPointer(0, regionStart), regionLength);
+    for (int channel = 1; channel < numChannels; ++channel)
+        juce::FloatVectorOperations::add(region, inputBuffer.getReadPointer(channel, regionStart), regionLength);
+
+    energyPrefix[0] = 0.0;
+    for (int i = 0; i < regionLength; ++i)
+        energyPrefix[(size_t)i + 1] = energyPrefix[(size_t)i] + (double)region[i] * (double)region[i];
+
+    auto score = [this, region](int offset) {
+        const double correlation = VectorOps::dotProduct(region + offset, monoTail.data(), hopSize);
+        const double energy = energyPrefix[(size_t)(offset + hopSize)] - energyPrefix[(size_t)offset];
+        return correlation / std::sqrt(energy + 1.0e-9);
+    };
+
+    const int lastOffset = 2 * searchRadius;
+
+    // Start from the nominal position so silence and ties leave the timing untouched
+    int bestOffset = searchRadius;
+    double bestScore = score(bestOffset);
+
+    for (int offset = 0; offset <= lastOffset; offset += coarseSearchStep) {
+        const double candidate = score(offset);
+        if (candidate > bestScore) {
+            bestScore = candidate;
+            bestOffset = offset;
+        }
+    }
+
+    const int coarseBest = bestOffset;
+    const int fineStart = juce::jmax(0, coarseBest - coarseSearchStep + 1);
+    const int fineEnd = juce::jmin(lastOffset, coarseBest + coarseSearchStep - 1);
+
+    for (int offset = fineStart; offset <= fineEnd; ++offset) {
+        const double candidate = score(offset);
+        if (candidate > bestScore) {
+            bestScore = candidate;
+            bestOffset = offset;
+        }
+    }
+
+    return regionStart + bestOffset;
+}
+
+// Shifts the input so the next search window starts at index 0
+void TimeStretchAudioSource::compactInput() {
+    const int shift = (int)analysisPosition - searchRadius;
+    if (shift <= 0)
+        return;
+
+    int remaining = inputFilled - shift;
+
+    if (remaining > 0) {
+        for (int channel = 0; channel < numChannels; ++channel) {
+            auto* data = inputBuffer.getWritePointer(channel);
+            std::memmove(data, data + shift, (size_t)remaining * sizeof(float));
+        }
+    }
+    else {
+        // At high ratios the next frame starts beyond what's been read, so read through the gap
+        int toSkip = -remaining;
+        while (toSkip > 0) {
+            const int numThisTime = juce::jmin(toSkip, inputBuffer.getNumSamples());
+            juce::AudioSourceChannelInfo info(&inputBuffer, 0, numThisTime);
+            input->getNextAudioBlock(info);
+            toSkip -= numThisTime;
+        }
+        remaining = 0;
+    }
+
+    inputFilled = remaining;
+    analysisPosition -= shift;
+}
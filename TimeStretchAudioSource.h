@@ -0,0 +1,97 @@
+/*
+  ==============================================================================
+
+    TimeStretchAudioSource.h
+    Created: 17 Oct 2026 1:58:07pm
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// Changes the tempo of its input without changing the pitch (keylock), using WSOLA.
+//
+// Every hop of output crossfades the tail of the previous frame with the input segment that
+// best continues it, found by a normalised cross-correlation search around the nominal
+// analysis position. The search radius and step are fixed when the source is prepared, so
+// the work done per hop (and therefore per block) doesn't depend on the audio content.
+class TimeStretchAudioSource : public juce::AudioSource {
+public:
+
+    // Constructor: reads from inputSource, optionally taking ownership of it
+    TimeStretchAudioSource(juce::AudioSource* inputSource, bool deleteInputWhenDeleted, int numChannels = 2);
+
+    // Destructor
+    ~TimeStretchAudioSource() override;
+
+    // Sets how many input samples are consumed per output sample (audio thread only)
+    void setStretchRatio(double newRatio);
+
+    // Returns the current stretch ratio
+    double getStretchRatio() const;
+
+    // Drops buffered input and output, e.g. after the input has been repositioned (audio thread only)
+    void reset();
+
+    // Prepares the source and allocates all working buffers
+    void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
+
+    // Releases the input's resources
+    void releaseResources() override;
+
+    // Renders the next block of stretched audio
+    void getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill) override;
+
+    // Range of ratios the stretcher supports; beyond this keylock stops being useful
+    static constexpr double minRatio = 0.25;
+    static constexpr double maxRatio = 4.0;
+
+private:
+    // Synthesises the next hop of output into outputBuffer
+    void produceHop();
+
+    // Reads from the input until inputBuffer holds numRequired samples
+    void fillInput(int numRequired);
+
+    // Returns the start of the input segment that best continues the last frame
+    int findBestSegment(int nominalPosition);
+
+    // Discards input that no future search can reach
+    void compactInput();
+
+    // The source that's being stretched
+    juce::OptionalScopedPointer<juce::AudioSource> input;
+    const int numChannels;
+
+    // Input consumed per output sample
+    double ratio = 1.0;
+
+    // Frame geometry, fixed by prepareToPlay: frames are 2 * hopSize long with 50% overlap
+    int hopSize = 0;
+    int searchRadius = 0;
+    static constexpr int coarseSearchStep = 4;
+
+    // Input read ahead of the analysis position, compacted after every hop
+    juce::AudioBuffer<float> inputBuffer;
+    int inputFilled = 0;
+    double analysisPosition = 0.0;
+
+    // Second half of the last frame, which fades out during the next hop
+    juce::AudioBuffer<float> overlapTail;
+    bool hasTail = false;
+
+    // One hop of synthesised output and how much of it has been handed out
+    juce::AudioBuffer<float> outputBuffer;
+    int outputReadPosition = 0;
+
+    // Complementary raised-cosine crossfade windows
+    std::vector<float> fadeIn, fadeOut;
+
+    // Channel-summed search region and template, plus running energy for normalisation
+    std::vector<float> monoRegion, monoTail;
+    std::vector<double> energyPrefix;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TimeStretchAudioSource)
+};
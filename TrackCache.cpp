@@ -0,0 +1,213 @@
+/*
+  ==============================================================================
+
+    TrackCache.cpp
+    Created: 17 Oct 2026 5:48:19pm
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#include "TrackCache.h"
+
+namespace {
+    // "OTC1" at the start of every entry file
+    constexpr int entryMagic = 0x4f544331;
+    constexpr int entryVersion = 1;
+    constexpr int maxSections = 64;
+
+    // Bytes hashed from each of the start, middle and end of an audio file
+    constexpr int hashChunkSize = 64 * 1024;
+
+    const char* const entryExtension = ".otc";
+}
+
+// Returns true if the entry holds a section with this name
+bool TrackCache::Entry::hasSection(const juce::String& name) const {
+    for (auto& section : sections)
+        if (section.name == name)
+            return true;
+
+    return false;
+}
+
+// Returns a stream reading the section in place from the mapped file
+std::unique_ptr<juce::InputStream> TrackCache::Entry::createSectionStream(const juce::String& name) const {
+    for (auto& section : sections)
+        if (section.name == name)
+            return std::make_unique<juce::MemoryInputStream>(static_cast<const char*>(mappedFile->getData()) + section.offset,
+                                                             section.size, false);
+
+    return nullptr;
+}
+
+// Constructor
+TrackCache::TrackCache(const juce::File& cacheDirectory, juce::int64 maxSize)
+    : directory(cacheDirectory), maxSizeBytes(maxSize)
+{
+}
+
+// Returns the per-user cache directory the app uses
+juce::File TrackCache::getDefaultDirectory() {
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+        .getChildFile("OtoDesks")
+        .getChildFile("TrackCache");
+}
+
+// Hashes three 64 KiB chunks with FNV-1a rather than the whole file, so the key of a long
+// track costs a few hundred microseconds instead of a full read
+juce::String TrackCache::makeKey(const juce::File& audioFile) {
+    juce::FileInputStream input(audioFile);
+    if (!input.openedOk())
+        return {};
+
+    const juce::int64 size = input.getTotalLength();
+    const juce::int64 lastChunkStart = juce::jmax((juce::int64)0, size - hashChunkSize);
+    const juce::int64 chunkStarts[] = { 0, lastChunkStart / 2, lastChunkStart };
+
+    juce::HeapBlock<juce::uint8> chunk(hashChunkSize);
+    juce::uint64 hash = 14695981039346656037ull;
+
+    for (auto start : chunkStarts) {
+        input.setPosition(start);
+        const int numRead = input.read(chunk.get(), hashChunkSize);
+
+        for (int i = 0; i < numRead; ++i)
+            hash = (hash ^ chunk[i]) * 1099511628211ull;
+    }
+
+    return juce::String::toHexString((juce::int64)hash)
+        + "-" + juce::String::toHexString(size)
+        + "-" + juce::String::toHexString(audioFile.getLastModificationTime().toMilliseconds());
+}
+
+// Maps the entry file and indexes its sections without copying any of them
+std::unique_ptr<TrackCache::Entry> TrackCache::open(const juce::String& key) {
+    const juce::File file = getEntryFile(key);
+    if (!file.existsAsFile())
+        return nullptr;
+
+    auto entry = std::make_unique<Entry>();
+    entry->mappedFile = std::make_unique<juce::MemoryMappedFile>(file, juce::MemoryMappedFile::readOnly);
+
+    const void* data = entry->mappedFile->getData();
+    const size_t totalSize = entry->mappedFile->getSize();
+    bool valid = data != nullptr && totalSize >= 3 * sizeof(int);
+
+    if (valid) {
+        juce::MemoryInputStream header(data, totalSize, false);
+        valid = header.readInt() == entryMagic && header.readInt() == entryVersion;
+
+        const int numSections = valid ? header.readInt() : 0;
+        valid = valid && numSections >= 0 && numSections <= maxSections;
+
+        for (int i = 0; valid && i < numSections; ++i) {
+            Entry::Section section;
+            section.name = header.readString();
+            const juce::int64 sectionSize = header.readInt64();
+
+            valid = !header.isExhausted() && sectionSize >= 0;
+            section.size = (size_t)sectionSize;
+            entry->sections.push_back(section);
+        }
+
+        // The section data follows the header back to back
+        size_t offset = (size_t)header.getPosition();
+        for (auto& section : entry->sections) {
+            section.offset = offset;
+            offset += section.size;
+            valid = valid && offset <= totalSize;
+        }
+    }
+
+    if (!valid) {
+        juce::Logger::outputDebugString("TrackCache: discarding unreadable entry " + file.getFileName() + "\n");
+        entry.reset();
+
+        const juce::ScopedLock sl(writeLock);
+        file.deleteFile();
+        return nullptr;
+    }
+
+    // The modification time doubles as the last-used time for trimming
+    file.setLastModificationTime(juce::Time::getCurrentTime());
+    return entry;
+}
+
+// Writes the entry to a temporary file and swaps it in, so readers never see half an entry
+bool TrackCache::store(const juce::String& key, const std::vector<SectionData>& sections) {
+    const juce::ScopedLock sl(writeLock);
+
+    if (!directory.createDirectory().wasOk()) {
+        juce::Logger::outputDebugString("TrackCache: could not create " + directory.getFullPathName() + "\n");
+        return false;
+    }
+
+    const juce::File file = getEntryFile(key);
+    juce::TemporaryFile temporary(file);
+
+    {
+        juce::FileOutputStream output(temporary.getFile());
+        if (!output.openedOk()) {
+            juce::Logger::outputDebugString("TrackCache: could not write " + temporary.getFile().getFullPathName() + "\n");
+            return false;
+        }
+
+        output.writeInt(entryMagic);
+        output.writeInt(entryVersion);
+        output.writeInt((int)sections.size());
+
+        for (auto& section : sections) {
+            output.writeString(section.name);
+            output.writeInt64((juce::int64)section.data.getSize());
+        }
+
+        for (auto& section : sections)
+            output.write(section.data.getData(), section.data.getSize());
+
+        output.flush();
+    }
+
+    if (!temporary.overwriteTargetFileWithTemporary()) {
+        juce::Logger::outputDebugString("TrackCache: could not replace " + file.getFileName() + "\n");
+        return false;
+    }
+
+    trim();
+    return true;
+}
+
+// Returns the file holding the entry for a key
+juce::File TrackCache::getEntryFile(const juce::String& key) const {
+    return directory.getChildFile(key + entryExtension);
+}
+
+// Deletes the least recently used entries until the cache fits its size limit (writeLock held)
+void TrackCache::trim() {
+    struct CachedFile {
+        juce::File file;
+        juce::int64 size;
+        juce::Time lastUsed;
+    };
+
+    std::vector<CachedFile> files;
+    juce::int64 totalSize = 0;
+
+    for (const auto& entry : juce::RangedDirectoryIterator(directory, false, juce::String("*") + entryExtension, juce::File::findFiles)) {
+        files.push_back({ entry.getFile(), entry.getFileSize(), entry.getModificationTime() });
+        totalSize += entry.getFileSize();
+    }
+
+    if (totalSize <= maxSizeBytes)
+        return;
+
+    std::sort(files.begin(), files.end(), [](const CachedFile& a, const CachedFile& b) { return a.lastUsed < b.lastUsed; });
+
+    for (auto& cached : files) {
+        if (totalSize <= maxSizeBytes)
+            break;
+
+        if (cached.file.deleteFile())
+            totalSize -= cached.size;
+    }
+}
@@ -0,0 +1,84 @@
+/*
+  ==============================================================================
+
+    TrackCache.h
+    Created: 17 Oct 2026 5:48:19pm
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// Persistent on-disk cache of per-track results (waveform thumbnail, beat grid, ...), so a
+// track that has been decoded once never needs decoding again just to be displayed.
+//
+// Each track has one entry file holding named binary sections. Entries are keyed by a hash of
+// the first, middle and last 64 KiB of the file together with its size and modification time,
+// which is cheap to compute and changes whenever the audio does. Entries are memory-mapped
+// when opened and the least recently used ones are deleted once the cache outgrows its limit.
+// All methods can be called from any thread.
+class TrackCache {
+public:
+
+    // A cache entry mapped into memory. Section streams read straight from the mapping and
+    // must not outlive the entry.
+    class Entry {
+    public:
+        // Returns true if the entry holds a section with this name
+        bool hasSection(const juce::String& name) const;
+
+        // Returns a stream over a section, or nullptr if the entry doesn't hold it
+        std::unique_ptr<juce::InputStream> createSectionStream(const juce::String& name) const;
+
+    private:
+        friend class TrackCache;
+
+        struct Section {
+            juce::String name;
+            size_t offset = 0;
+            size_t size = 0;
+        };
+
+        std::unique_ptr<juce::MemoryMappedFile> mappedFile;
+        std::vector<Section> sections;
+    };
+
+    // A named block of data to store in an entry
+    struct SectionData {
+        juce::String name;
+        juce::MemoryBlock data;
+    };
+
+    // Constructor: keeps entries in directory, trimming them to maxSizeBytes in total
+    explicit TrackCache(const juce::File& directory, juce::int64 maxSizeBytes = 256 * 1024 * 1024);
+
+    // Returns the per-user cache directory the app uses
+    static juce::File getDefaultDirectory();
+
+    // Returns the key of a local audio file, or an empty string if it can't be read
+    static juce::String makeKey(const juce::File& audioFile);
+
+    // Maps the entry for a key, or returns nullptr if there is no valid one. Marks the entry
+    // as recently used.
+    std::unique_ptr<Entry> open(const juce::String& key);
+
+    // Writes (or replaces) the entry for a key, then trims the cache to its size limit
+    bool store(const juce::String& key, const std::vector<SectionData>& sections);
+
+private:
+    // Returns the file holding the entry for a key
+    juce::File getEntryFile(const juce::String& key) const;
+
+    // Deletes the least recently used entries until the cache fits its size limit
+    void trim();
+
+    const juce::File directory;
+    const juce::int64 maxSizeBytes;
+
+    // Serialises writes and trimming between the decks' analysis threads
+    juce::CriticalSection writeLock;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TrackCache)
+};
@@ -0,0 +1,93 @@
+/*
+  ==============================================================================
+
+    TrackDecoder.cpp
+    Created: 17 Oct 2026 5:06:42pm
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#include "TrackDecoder.h"
+
+// Adds a consumer to the pass
+void TrackDecoder::addConsumer(TrackDecodeConsumer* consumer) {
+    if (consumer != nullptr)
+        consumers.push_back(consumer);
+}
+
+// Reads the track block by block into one buffer that every consumer sees in turn
+bool TrackDecoder::run(juce::AudioFormatReader& reader, const std::function<bool()>& shouldCancel) {
+    const int numChannels = (int)reader.numChannels;
+    const juce::int64 length = reader.lengthInSamples;
+
+    for (auto* consumer : consumers)
+        consumer->decodeStarted(numChannels, reader.sampleRate, length);
+
+    juce::AudioBuffer<float> buffer(juce::jmax(1, numChannels), blockSize);
+    bool completed = numChannels > 0 && reader.sampleRate > 0.0;
+
+    for (juce::int64 position = 0; completed && position < length; position += blockSize) {
+        if (shouldCancel && shouldCancel()) {
+            completed = false;
+            break;
+        }
+
+        const int numSamples = (int)juce::jmin((juce::int64)blockSize, length - position);
+
+        reader.read(&buffer, 0, numSamples, position, true, true);
+
+        for (auto* consumer : consumers)
+            consumer->decodeBlock(buffer, position, numSamples);
+    }
+
+    for (auto* consumer : consumers)
+        consumer->decodeFinished(completed);
+
+    return completed;
+}
+
+// Checks that every consumer has a section before restoring any, so a partial hit never leaves
+// some consumers filled from the cache and the rest empty
+bool TrackDecoder::restoreFromCache(const TrackCache::Entry& entry) {
+    if (consumers.empty())
+        return false;
+
+    for (auto* consumer : consumers) {
+        const juce::String name = consumer->getCacheSectionName();
+        if (name.isEmpty() || !entry.hasSection(name))
+            return false;
+    }
+
+    for (auto* consumer : consumers) {
+        auto input = entry.createSectionStream(consumer->getCacheSectionName());
+        if (input == nullptr || !consumer->loadFromCache(*input)) {
+            juce::Logger::outputDebugString("TrackDecoder: cached " + consumer->getCacheSectionName() + " is unusable\n");
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Collects a section from every cached consumer and writes them as one entry
+void TrackDecoder::saveToCache(TrackCache& cache, const juce::String& key) {
+    std::vector<TrackCache::SectionData> sections;
+
+    for (auto* consumer : consumers) {
+        const juce::String name = consumer->getCacheSectionName();
+        if (name.isEmpty())
+            continue;
+
+        TrackCache::SectionData section;
+        section.name = name;
+        {
+            juce::MemoryOutputStream output(section.data, false);
+            consumer->saveToCache(output);
+        }
+        sections.push_back(std::move(section));
+    }
+
+    if (!sections.empty())
+        cache.store(key, sections);
+}
@@ -0,0 +1,69 @@
+/*
+  ==============================================================================
+
+    TrackDecoder.h
+    Created: 17 Oct 2026 5:06:42pm
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "TrackCache.h"
+
+// Receives the audio of a TrackDecoder pass. All calls arrive on the decoding thread.
+class TrackDecodeConsumer {
+public:
+    virtual ~TrackDecodeConsumer() = default;
+
+    // Called once before the first block
+    virtual void decodeStarted(int numChannels, double sampleRate, juce::int64 lengthInSamples) = 0;
+
+    // Called with each decoded block, in order from the start of the track
+    virtual void decodeBlock(const juce::AudioBuffer<float>& buffer, juce::int64 startSample, int numSamples) = 0;
+
+    // Called once after the last block, with completed false if the pass was cancelled
+    virtual void decodeFinished(bool completed) { juce::ignoreUnused(completed); }
+
+    // Name of this consumer's section in the track cache, or empty if its result isn't cached
+    virtual juce::String getCacheSectionName() const { return {}; }
+
+    // Writes the result of a completed pass to be cached
+    virtual void saveToCache(juce::OutputStream& output) { juce::ignoreUnused(output); }
+
+    // Restores a cached result in place of a decode pass; returns false if the data is unusable
+    virtual bool loadFromCache(juce::InputStream& input) { juce::ignoreUnused(input); return false; }
+};
+
+// Decodes a track once from start to end and hands every block to each of its consumers, so the
+// waveform, the beat analysis and any other per-track analysis share a single read of the file.
+// When every consumer's result is in the track cache, the pass can be skipped altogether.
+class TrackDecoder {
+public:
+
+    // Constructor
+    TrackDecoder() = default;
+
+    // Adds a consumer; it must outlive the decoder
+    void addConsumer(TrackDecodeConsumer* consumer);
+
+    // Decodes the whole track from reader. shouldCancel is polled between blocks; returns false
+    // if it ever returned true.
+    bool run(juce::AudioFormatReader& reader, const std::function<bool()>& shouldCancel);
+
+    // Restores every consumer from a cache entry. Returns false, leaving a decode pass to do the
+    // work, if any consumer isn't cached or its section is missing or unusable.
+    bool restoreFromCache(const TrackCache::Entry& entry);
+
+    // Stores the results of a completed pass under key, one section per cached consumer
+    void saveToCache(TrackCache& cache, const juce::String& key);
+
+    // Samples decoded per read
+    static constexpr int blockSize = 16384;
+
+private:
+    std::vector<TrackDecodeConsumer*> consumers;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TrackDecoder)
+};
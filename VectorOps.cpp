@@ -0,0 +1,91 @@
+/*
+  ==============================================================================
+
+    VectorOps.cpp
+    Created: 17 Oct 2026 1:26:51pm
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#include "VectorOps.h"
+
+namespace VectorOps {
+
+    // Four-lane multiply-accumulate with two independent accumulators to hide latency
+    float dotProduct(const float* a, const float* b, int num) noexcept {
+        int i = 0;
+        float result = 0.0f;
+
+       #if OTODESKS_VECTOR_SSE
+        __m128 acc0 = _mm_setzero_ps();
+        __m128 acc1 = _mm_setzero_ps();
+
+        for (; i + 8 <= num; i += 8) {
+            acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+            acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+        }
+
+        alignas(16) float lanes[4];
+        _mm_store_ps(lanes, _mm_add_ps(acc0, acc1));
+        result = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+       #elif OTODESKS_VECTOR_NEON
+        float32x4_t acc0 = vdupq_n_f32(0.0f);
+        float32x4_t acc1 = vdupq_n_f32(0.0f);
+
+        for (; i + 8 <= num; i += 8) {
+            acc0 = vmlaq_f32(acc0, vld1q_f32(a + i), vld1q_f32(b + i));
+            acc1 = vmlaq_f32(acc1, vld1q_f32(a + i + 4), vld1q_f32(b + i + 4));
+        }
+
+        const float32x4_t sum = vaddq_f32(acc0, acc1);
+        result = (vgetq_lane_f32(sum, 0) + vgetq_lane_f32(sum, 1)) + (vgetq_lane_f32(sum, 2) + vgetq_lane_f32(sum, 3));
+       #endif
+
+        for (; i < num; ++i)
+            result += a[i] * b[i];
+
+        return result;
+    }
+
+    // Energy of a block, used to normalise correlations
+    float sumOfSquares(const float* a, int num) noexcept {
+        return dotProduct(a, a, num);
+    }
+
+    // Mixes one channel into another; a steady gain goes straight to JUCE's own kernel
+    void addWithRamp(float* dest, const float* src, float startGain, float endGain, int num) noexcept {
+        if (num <= 0)
+            return;
+
+        if (startGain == endGain) {
+            juce::FloatVectorOperations::addWithMultiply(dest, src, startGain, num);
+            return;
+        }
+
+        int i = 0;
+        const float step = (endGain - startGain) / (float)num;
+
+       #if OTODESKS_VECTOR_SSE
+        __m128 gain = _mm_setr_ps(startGain, startGain + step, startGain + 2.0f * step, startGain + 3.0f * step);
+        const __m128 gainStep = _mm_set1_ps(4.0f * step);
+
+        for (; i + 4 <= num; i += 4) {
+            _mm_storeu_ps(dest + i, _mm_add_ps(_mm_loadu_ps(dest + i), _mm_mul_ps(_mm_loadu_ps(src + i), gain)));
+            gain = _mm_add_ps(gain, gainStep);
+        }
+       #elif OTODESKS_VECTOR_NEON
+        const float firstGains[4] = { startGain, startGain + step, startGain + 2.0f * step, startGain + 3.0f * step };
+        float32x4_t gain = vld1q_f32(firstGains);
+        const float32x4_t gainStep = vdupq_n_f32(4.0f * step);
+
+        for (; i + 4 <= num; i += 4) {
+            vst1q_f32(dest + i, vmlaq_f32(vld1q_f32(dest + i), vld1q_f32(src + i), gain));
+            gain = vaddq_f32(gain, gainStep);
+        }
+       #endif
+
+        for (; i < num; ++i)
+            dest[i] += src[i] * (startGain + step * (float)i);
+    }
+}
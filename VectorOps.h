@@ -0,0 +1,114 @@
+/*
+  ==============================================================================
+
+    VectorOps.h
+    Created: 17 Oct 2026 1:26:51pm
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// Instruction set used by the SIMD kernels; anything else falls back to scalar loops
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+ #include <xmmintrin.h>
+ #define OTODESKS_VECTOR_SSE 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+ #include <arm_neon.h>
+ #define OTODESKS_VECTOR_NEON 1
+#endif
+
+// Small SIMD kernels used by the DSP code that juce::FloatVectorOperations doesn't cover.
+// Pointers don't need to be aligned.
+namespace VectorOps {
+
+    // Returns the sum of a[i] * b[i] for i in 0..num-1
+    float dotProduct(const float* a, const float* b, int num) noexcept;
+
+    // Returns the sum of a[i] * a[i] for i in 0..num-1
+    float sumOfSquares(const float* a, int num) noexcept;
+
+    // Adds src[i] * gain to dest[i], with the gain moving linearly from startGain towards endGain over the block
+    void addWithRamp(float* dest, const float* src, float startGain, float endGain, int num) noexcept;
+}
+
+// Four-lane helpers for kernels that keep their state in registers from one sample to the next, such as
+// biquads run side by side on separate channels or filters. Loads and stores need 16-byte aligned pointers.
+namespace VectorOps::lanes {
+   #if OTODESKS_VECTOR_SSE
+    using Lanes = __m128;
+    inline Lanes load(const float* p) noexcept { return _mm_load_ps(p); }
+    inline void store(float* p, Lanes v) noexcept { _mm_store_ps(p, v); }
+    inline Lanes set(float a, float b, float c, float d) noexcept { return _mm_setr_ps(a, b, c, d); }
+    inline Lanes splat(float a) noexcept { return _mm_set1_ps(a); }
+    inline Lanes add(Lanes a, Lanes b) noexcept { return _mm_add_ps(a, b); }
+    inline Lanes sub(Lanes a, Lanes b) noexcept { return _mm_sub_ps(a, b); }
+    inline Lanes mul(Lanes a, Lanes b) noexcept { return _mm_mul_ps(a, b); }
+    inline Lanes min(Lanes a, Lanes b) noexcept { return _mm_min_ps(a, b); }
+    inline Lanes max(Lanes a, Lanes b) noexcept { return _mm_max_ps(a, b); }
+    inline Lanes foldHalves(Lanes v) noexcept { return _mm_add_ps(v, _mm_movehl_ps(v, v)); }  // Lanes 0,1 += lanes 2,3
+    inline Lanes upperHalves(Lanes v) noexcept { return _mm_movehl_ps(v, v); }  // Lanes 2,3 copied to 0,1
+    inline Lanes lowerHalves(Lanes a, Lanes b) noexcept { return _mm_movelh_ps(a, b); }  // Lanes 0,1 of a then lanes 0,1 of b
+    inline float lane0(Lanes v) noexcept { return _mm_cvtss_f32(v); }
+    inline float lane1(Lanes v) noexcept { return _mm_cvtss_f32(_mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1))); }
+   #elif OTODESKS_VECTOR_NEON
+    using Lanes = float32x4_t;
+    inline Lanes load(const float* p) noexcept { return vld1q_f32(p); }
+    inline void store(float* p, Lanes v) noexcept { vst1q_f32(p, v); }
+    inline Lanes set(float a, float b, float c, float d) noexcept { const float values[4] = { a, b, c, d }; return vld1q_f32(values); }
+    inline Lanes splat(float a) noexcept { return vdupq_n_f32(a); }
+    inline Lanes add(Lanes a, Lanes b) noexcept { return vaddq_f32(a, b); }
+    inline Lanes sub(Lanes a, Lanes b) noexcept { return vsubq_f32(a, b); }
+    inline Lanes mul(Lanes a, Lanes b) noexcept { return vmulq_f32(a, b); }
+    inline Lanes min(Lanes a, Lanes b) noexcept { return vminq_f32(a, b); }
+    inline Lanes max(Lanes a, Lanes b) noexcept { return vmaxq_f32(a, b); }
+    inline Lanes foldHalves(Lanes v) noexcept { return vcombine_f32(vadd_f32(vget_low_f32(v), vget_high_f32(v)), vget_high_f32(v)); }
+    inline Lanes upperHalves(Lanes v) noexcept { return vcombine_f32(vget_high_f32(v), vget_high_f32(v)); }
+    inline Lanes lowerHalves(Lanes a, Lanes b) noexcept { return vcombine_f32(vget_low_f32(a), vget_low_f32(b)); }
+    inline float lane0(Lanes v) noexcept { return vgetq_lane_f32(v, 0); }
+    inline float lane1(Lanes v) noexcept { return vgetq_lane_f32(v, 1); }
+   #else
+    struct Lanes { float v[4]; };
+    inline Lanes load(const float* p) noexcept { return { { p[0], p[1], p[2], p[3] } }; }
+    inline void store(float* p, Lanes a) noexcept { for (int i = 0; i < 4; ++i) p[i] = a.v[i]; }
+    inline Lanes set(float a, float b, float c, float d) noexcept { return { { a, b, c, d } }; }
+    inline Lanes splat(float a) noexcept { return { { a, a, a, a } }; }
+    inline Lanes add(Lanes a, Lanes b) noexcept { for (int i = 0; i < 4; ++i) a.v[i] += b.v[i]; return a; }
+    inline Lanes sub(Lanes a, Lanes b) noexcept { for (int i = 0; i < 4; ++i) a.v[i] -= b.v[i]; return a; }
+    inline Lanes mul(Lanes a, Lanes b) noexcept { for (int i = 0; i < 4; ++i) a.v[i] *= b.v[i]; return a; }
+    inline Lanes min(Lanes a, Lanes b) noexcept { for (int i = 0; i < 4; ++i) a.v[i] = b.v[i] < a.v[i] ? b.v[i] : a.v[i]; return a; }
+    inline Lanes max(Lanes a, Lanes b) noexcept { for (int i = 0; i < 4; ++i) a.v[i] = b.v[i] > a.v[i] ? b.v[i] : a.v[i]; return a; }
+    inline Lanes foldHalves(Lanes a) noexcept { return { { a.v[0] + a.v[2], a.v[1] + a.v[3], a.v[2], a.v[3] } }; }
+    inline Lanes upperHalves(Lanes a) noexcept { return { { a.v[2], a.v[3], a.v[2], a.v[3] } }; }
+    inline Lanes lowerHalves(Lanes a, Lanes b) noexcept { return { { a.v[0], a.v[1], b.v[0], b.v[1] } }; }
+    inline float lane0(Lanes a) noexcept { return a.v[0]; }
+    inline float lane1(Lanes a) noexcept { return a.v[1]; }
+   #endif
+
+    // Four biquads' coefficients and state loaded into registers for the length of a block; Biquad is any
+    // struct holding aligned b0, b1, b2, a1, a2, s1 and s2 arrays of four, one entry per lane
+    struct BiquadRegisters {
+        Lanes b0, b1, b2, a1, a2, s1, s2;
+
+        template <typename Biquad>
+        explicit BiquadRegisters(const Biquad& biquad) noexcept
+            : b0(load(biquad.b0)), b1(load(biquad.b1)), b2(load(biquad.b2)), a1(load(biquad.a1)), a2(load(biquad.a2)),
+              s1(load(biquad.s1)), s2(load(biquad.s2)) {}
+
+        template <typename Biquad>
+        void saveState(Biquad& biquad) const noexcept {
+            store(biquad.s1, s1);
+            store(biquad.s2, s2);
+        }
+
+        // Transposed direct form II, one sample on every lane
+        Lanes process(Lanes x) noexcept {
+            const Lanes y = add(mul(b0, x), s1);
+            s1 = add(sub(mul(b1, x), mul(a1, y)), s2);
+            s2 = sub(mul(b2, x), mul(a2, y));
+            return y;
+        }
+    };
+}
@@ -0,0 +1,118 @@
+/*
+  ==============================================================================
+
+    VirtualAudioDevice.cpp
+    Created: 17 Oct 2026 9:14:27pm
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#include "VirtualAudioDevice.h"
+#include <thread>
+
+namespace {
+    // Blocks the device may fall behind by before it skips ahead instead of calling back in a burst
+    constexpr int maxBlocksBehind = 4;
+
+    // Below this the thread stops sleeping and spins, since a sleep can overshoot by about a millisecond
+    constexpr double spinThresholdMs = 2.0;
+}
+
+// Constructor for VirtualAudioDevice
+VirtualAudioDevice::VirtualAudioDevice(juce::AudioSource& sourceToPlay, double rate, int samplesPerBlock, int channels)
+    : juce::Thread("Virtual audio device"), source(sourceToPlay), sampleRate(rate),
+      blockSize(juce::jmax(16, samplesPerBlock)), numChannels(juce::jmax(1, channels)) {
+
+}
+
+// Destructor for VirtualAudioDevice
+VirtualAudioDevice::~VirtualAudioDevice() {
+    stop();
+}
+
+void VirtualAudioDevice::setListener(Listener* newListener) {
+    jassert(!running);
+    listener = newListener;
+}
+
+// Prepares the source, then starts the device thread with real-time priority where it is allowed
+void VirtualAudioDevice::start() {
+    if (running)
+        return;
+
+    source.prepareToPlay(blockSize, sampleRate);
+    running = true;
+
+    if (!startRealtimeThread(juce::Thread::RealtimeOptions{}.withApproximateAudioProcessingTime(blockSize, sampleRate)))
+        startThread(juce::Thread::Priority::highest);
+}
+
+void VirtualAudioDevice::stop() {
+    if (!running)
+        return;
+
+    signalThreadShouldExit();
+    notify();
+    stopThread(2000);
+
+    source.releaseResources();
+    running = false;
+}
+
+void VirtualAudioDevice::run() {
+    juce::AudioBuffer<float> buffer(numChannels, blockSize);
+    juce::AudioSourceChannelInfo info(&buffer, 0, blockSize);
+
+    const double ticksPerBlock = (double)juce::Time::getHighResolutionTicksPerSecond() * blockSize / sampleRate;
+    const float budgetMicros = (float)(blockSize * 1.0e6 / sampleRate);
+
+    const juce::int64 startTicks = juce::Time::getHighResolutionTicks();
+    juce::int64 blockIndex = 0;
+
+    while (!threadShouldExit()) {
+        // Computed from the start rather than accumulated, so rounding never drifts the clock
+        const juce::int64 dueTicks = startTicks + (juce::int64)((double)blockIndex * ticksPerBlock);
+        if (!waitUntil(dueTicks))
+            break;
+
+        const juce::int64 wokeTicks = juce::Time::getHighResolutionTicks();
+        source.getNextAudioBlock(info);
+        const juce::int64 doneTicks = juce::Time::getHighResolutionTicks();
+
+        BlockTiming timing;
+        timing.blockIndex = blockIndex;
+        timing.dueTicks = dueTicks;
+        timing.wakeLateMicros = (float)(juce::Time::highResolutionTicksToSeconds(wokeTicks - dueTicks) * 1.0e6);
+        timing.callbackMicros = (float)(juce::Time::highResolutionTicksToSeconds(doneTicks - wokeTicks) * 1.0e6);
+        timing.budgetMicros = budgetMicros;
+
+        if (listener != nullptr)
+            listener->blockRendered(timing);
+
+        ++blockIndex;
+
+        // After a long stall, drop the blocks that are already lost, as a real device would
+        const auto blocksBehind = (juce::int64)((double)(juce::Time::getHighResolutionTicks() - startTicks) / ticksPerBlock) - blockIndex;
+        if (blocksBehind > maxBlocksBehind) {
+            skippedBlocks += blocksBehind;
+            blockIndex += blocksBehind;
+        }
+    }
+}
+
+bool VirtualAudioDevice::waitUntil(juce::int64 dueTicks) {
+    for (;;) {
+        if (threadShouldExit())
+            return false;
+
+        const double remainingMs = juce::Time::highResolutionTicksToSeconds(dueTicks - juce::Time::getHighResolutionTicks()) * 1000.0;
+        if (remainingMs <= 0.0)
+            return true;
+
+        if (remainingMs > spinThresholdMs)
+            wait((int)(remainingMs - spinThresholdMs * 0.5));
+        else
+            std::this_thread::yield();
+    }
+}
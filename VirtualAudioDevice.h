@@ -0,0 +1,78 @@
+/*
+  ==============================================================================
+
+    VirtualAudioDevice.h
+    Created: 17 Oct 2026 9:14:27pm
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// VirtualAudioDevice class
+// Stands in for a sound card on machines that have none. A real-time thread asks the source for one
+// block every block period, paced against the clock the way a device would, and reports how long each
+// callback took against its deadline.
+class VirtualAudioDevice : private juce::Thread {
+public:
+    // Timing of one block. The device asks for a block when it is due and needs it one block period later
+    struct BlockTiming {
+        juce::int64 blockIndex = 0;
+        juce::int64 dueTicks = 0;  // High-resolution ticks at which the block was asked for
+        float wakeLateMicros = 0.0f;  // How late the device thread woke up for the block
+        float callbackMicros = 0.0f;
+        float budgetMicros = 0.0f;
+
+        // True if the block was finished after the device needed it
+        bool missedDeadline() const noexcept { return wakeLateMicros + callbackMicros > budgetMicros; }
+    };
+
+    // Receives the timing of every block on the device thread, straight after the source has rendered it
+    class Listener {
+    public:
+        virtual ~Listener() = default;
+        virtual void blockRendered(const BlockTiming& timing) = 0;
+    };
+
+    // Constructor: source must outlive the device
+    VirtualAudioDevice(juce::AudioSource& source, double sampleRate, int blockSize, int numChannels = 2);
+
+    // Destructor: stops the device if it is running
+    ~VirtualAudioDevice() override;
+
+    // Sets the listener told about every block; call before start()
+    void setListener(Listener* newListener);
+
+    // Prepares the source and starts asking it for blocks
+    void start();
+
+    // Stops the device thread, then releases the source
+    void stop();
+
+    // Blocks the device gave up on after falling too far behind, e.g. when the process was stalled
+    juce::int64 getNumSkippedBlocks() const noexcept { return skippedBlocks.load(); }
+
+    double getSampleRate() const noexcept { return sampleRate; }
+    int getBlockSize() const noexcept { return blockSize; }
+
+private:
+    // Paces the callbacks (device thread)
+    void run() override;
+
+    // Sleeps, then spins, until the given tick; returns false if the thread should exit
+    bool waitUntil(juce::int64 dueTicks);
+
+    juce::AudioSource& source;
+    const double sampleRate;
+    const int blockSize;
+    const int numChannels;
+
+    Listener* listener = nullptr;
+    bool running = false;
+    std::atomic<juce::int64> skippedBlocks{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(VirtualAudioDevice)
+};
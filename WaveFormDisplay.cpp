@@ -1,116 +1,245 @@
-/*
-  ==============================================================================
-
-    WaveFormDisplay.cpp
-    Created: 21 Feb 2025 2:56:36pm
-    Author:  LAPTOP WORLD
-
-  ==============================================================================
-*/
-
-#include <JuceHeader.h>
-#include "WaveFormDisplay.h"
-
-//==============================================================================
-WaveFormDisplay::WaveFormDisplay(juce::AudioFormatManager& formatManagerToUse,
-	juce::AudioThumbnailCache& cacheToUse)
-	:audionail(1000, formatManagerToUse, cacheToUse), 
-    isloaded(false)
-{
-    // In your constructor, you should add any child components, and
-    // initialise any special settings that your component needs.
-    audionail.addChangeListener(this);
-
-}
-
-WaveFormDisplay::~WaveFormDisplay()
-{
-}
-
-void WaveFormDisplay::paint(juce::Graphics& g)
-{
-    g.fillAll(juce::Colours::black);  // Background
-    g.setColour(juce::Colours::grey);
-    g.drawRect(getLocalBounds(), 1);
-
-
-    if (isloaded) {
-        audionail.drawChannel(g, getLocalBounds(), 0, audionail.getTotalLength(), 0, 1.0f);
-
-
-        for (size_t i = 0; i < cuePoints.size(); ++i) {
-            float xPos = getWidth() * (cuePoints[i] / audionail.getTotalLength());
-
-            if (i == currentCueIndex) {
-                g.setColour(juce::Colours::red);  // Highlight active cue
-                g.fillEllipse(xPos - 6, getHeight() - 12, 12, 12);
-            }
-            else {
-                g.setColour(juce::Colours::yellow);
-                g.fillEllipse(xPos - 5, getHeight() - 10, 10, 10);
-            }
-        }
-    }
-    else {
-        g.setFont(juce::Font(22.0f));
-        g.drawText("File Not Loaded Yet", getLocalBounds(), juce::Justification::centred, true);
-    }
-}
-
-void WaveFormDisplay::resized()
-{
-    // This method is where you should set the bounds of any child
-    // components that your component contains..
-
-}
-
-void WaveFormDisplay::loadURL(juce::URL& audioURL) {
-	audionail.clear();
-	isloaded = audionail.setSource(new juce::URLInputSource(audioURL));
-	if (isloaded) {
-		juce::Logger::outputDebugString("WaveFormDisplay::loadURL: Audio Loaded");
-	}
-    else {
-		juce::Logger::outputDebugString("WaveFormDisplay::loadURL: Audio Not Loaded");
-	}
-}
-
-void WaveFormDisplay::changeListenerCallback(juce::ChangeBroadcaster* source) {
-	juce::Logger::outputDebugString("WaveFormDisplay::changeListenerCallback]\n");
-	repaint();
-}
-
-
-void WaveFormDisplay::addCuePoint(double position) {
-    cuePoints.push_back(position);
-    repaint();
-}
-
-void WaveFormDisplay::clearCuePoints() {
-    cuePoints.clear();
-    repaint();
-}
-
-double WaveFormDisplay::getTrackLength()
-{
-    return audionail.getTotalLength();
-}
-
-double WaveFormDisplay::getPositionRelative()
-{
-    if (audionail.getTotalLength() > 0 && position >= 0.0)
-        return position / audionail.getTotalLength();
-    else
-        return 0.0;
-}
-
-
-void WaveFormDisplay::setPositionRelative(double pos)
-{
-    if (pos >= 0.0 && pos <= 1.0 && audionail.getTotalLength() > 0)
-    {
-        position = pos * audionail.getTotalLength();  // Update position
-        repaint();  // Redraw waveform
-    }
-}
-
+/*
+  ==============================================================================
+
+    WaveFormDisplay.cpp
+    Created: 21 Feb 2025 2:56:36pm
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "WaveFormDisplay.h"
+
+//==============================================================================
+WaveFormDisplay::WaveFormDisplay(juce::AudioFormatManager& formatManagerToUse,
+	juce::AudioThumbnailCache& cacheToUse)
+	:audionail(thumbnailResolution, formatManagerToUse, cacheToUse)
+{
+    // In your constructor, you should add any child components, and
+    // initialise any special settings that your component needs.
+    audionail.addChangeListener(this);
+    spectrum.addChangeListener(this);
+
+}
+
+WaveFormDisplay::~WaveFormDisplay()
+{
+    spectrum.removeChangeListener(this);
+}
+
+void WaveFormDisplay::paint(juce::Graphics& g)
+{
+    if (!waveformLayerValid)
+        renderWaveformLayer();
+
+    // Only the playhead changes from frame to frame; the rest comes from the cached layer
+    g.drawImageAt(waveformLayer, 0, 0);
+
+    int playheadX = getPlayheadX(playhead);
+    if (playheadX >= 0) {
+        g.setColour(juce::Colours::red);
+        g.drawVerticalLine(playheadX, 0.0f, static_cast<float>(getHeight()));
+    }
+}
+
+void WaveFormDisplay::renderWaveformLayer()
+{
+    waveformLayer = juce::Image(juce::Image::RGB, juce::jmax(1, getWidth()), juce::jmax(1, getHeight()), true);
+    waveformLayerValid = true;
+
+    juce::Graphics g(waveformLayer);
+    g.fillAll(juce::Colours::black);  // Background
+    g.setColour(juce::Colours::grey);
+    g.drawRect(getLocalBounds(), 1);
+
+
+    if (audionail.getTotalLength() > 0.0) {
+        if (!drawSpectrum(g))
+            audionail.drawChannel(g, getLocalBounds(), 0, audionail.getTotalLength(), 0, 1.0f);
+        drawBeatGrid(g);
+
+        for (size_t i = 0; i < cuePoints.size(); ++i) {
+            float xPos = getWidth() * (cuePoints[i] / audionail.getTotalLength());
+
+            if (i == currentCueIndex) {
+                g.setColour(juce::Colours::red);  // Highlight active cue
+                g.fillEllipse(xPos - 6, getHeight() - 12, 12, 12);
+            }
+            else {
+                g.setColour(juce::Colours::yellow);
+                g.fillEllipse(xPos - 5, getHeight() - 10, 10, 10);
+            }
+        }
+    }
+    else {
+        g.setFont(juce::Font(22.0f));
+        g.drawText("File Not Loaded Yet", getLocalBounds(), juce::Justification::centred, true);
+    }
+}
+
+// Each pixel column takes the highest peak of the analysed columns under it, coloured like the loudest of them
+bool WaveFormDisplay::drawSpectrum(juce::Graphics& g)
+{
+    const auto analysis = spectrum.getColumns();
+    if (analysis == nullptr || analysis->getNumColumns() == 0 || analysis->lengthInSamples <= 0)
+        return false;
+
+    const int width = getWidth();
+    const float centre = getHeight() * 0.5f;
+    const double columnsPerPixel = (double)analysis->lengthInSamples / SpectralWaveform::samplesPerColumn / juce::jmax(1, width);
+    const int numColumns = analysis->getNumColumns();
+
+    for (int x = 0; x < width; ++x) {
+        const int first = juce::jmin(numColumns - 1, (int)(x * columnsPerPixel));
+        const int last = juce::jlimit(first + 1, numColumns, (int)((x + 1) * columnsPerPixel));
+
+        int peak = 0, loudest = first, loudestEnergy = -1;
+        for (int column = first; column < last; ++column) {
+            const auto& levels = analysis->columns[(size_t)column];
+            const int energy = levels.low + levels.mid + levels.high;
+            peak = juce::jmax(peak, (int)levels.peak);
+
+            if (energy > loudestEnergy) {
+                loudestEnergy = energy;
+                loudest = column;
+            }
+        }
+
+        const float halfHeight = juce::jmax(0.5f, centre * peak / 255.0f);
+        g.setColour(juce::Colour(analysis->colours[(size_t)loudest]));
+        g.drawVerticalLine(x, centre - halfHeight, centre + halfHeight);
+    }
+
+    return true;
+}
+
+void WaveFormDisplay::invalidateWaveformLayer()
+{
+    waveformLayerValid = false;
+    repaint();
+}
+
+int WaveFormDisplay::getPlayheadX(const DeckSnapshot& snapshot) const
+{
+    if (snapshot.lengthSamples <= 0)
+        return -1;
+
+    return juce::roundToInt(getWidth() * juce::jlimit(0.0, 1.0, snapshot.getPositionRelative()));
+}
+
+void WaveFormDisplay::repaintPlayhead(int x)
+{
+    if (x >= 0)
+        repaint(x - 1, 0, 3, getHeight());
+}
+
+void WaveFormDisplay::resized()
+{
+    // This method is where you should set the bounds of any child
+    // components that your component contains..
+    invalidateWaveformLayer();
+}
+
+void WaveFormDisplay::startNewTrack() {
+	// The thumbnail no longer reads the file itself; the deck's decode pass fills it
+	audionail.clear();
+	spectrum.clear();
+	beatGrid = {};
+	invalidateWaveformLayer();
+}
+
+void WaveFormDisplay::ThumbnailFiller::decodeStarted(int numChannels, double sampleRate, juce::int64 lengthInSamples) {
+	// The thumbnail locks internally and posts its change messages, so it can be filled from this thread
+	thumbnail.reset(numChannels, sampleRate, lengthInSamples);
+}
+
+void WaveFormDisplay::ThumbnailFiller::decodeBlock(const juce::AudioBuffer<float>& buffer, juce::int64 startSample, int numSamples) {
+	thumbnail.addBlock(startSample, buffer, 0, numSamples);
+}
+
+void WaveFormDisplay::ThumbnailFiller::saveToCache(juce::OutputStream& output) {
+	thumbnail.saveTo(output);
+}
+
+bool WaveFormDisplay::ThumbnailFiller::loadFromCache(juce::InputStream& input) {
+	if (!thumbnail.loadFrom(input))
+		return false;
+
+	// Loading doesn't notify listeners the way addBlock does, so ask for the repaint here
+	thumbnail.sendChangeMessage();
+	return true;
+}
+
+void WaveFormDisplay::changeListenerCallback(juce::ChangeBroadcaster* source) {
+	juce::Logger::outputDebugString("WaveFormDisplay::changeListenerCallback]\n");
+	invalidateWaveformLayer();
+}
+
+
+void WaveFormDisplay::addCuePoint(double position) {
+    cuePoints.push_back(position);
+    invalidateWaveformLayer();
+}
+
+void WaveFormDisplay::clearCuePoints() {
+    cuePoints.clear();
+    invalidateWaveformLayer();
+}
+
+double WaveFormDisplay::getTrackLength()
+{
+    return audionail.getTotalLength();
+}
+
+double WaveFormDisplay::getPositionRelative()
+{
+    return playhead.getPositionRelative();
+}
+
+
+void WaveFormDisplay::setPlayhead(const DeckSnapshot& snapshot)
+{
+    int oldX = getPlayheadX(playhead);
+    int newX = getPlayheadX(snapshot);
+    playhead = snapshot;
+
+    // Only the columns the playhead leaves and enters need redrawing
+    if (newX != oldX)
+    {
+        repaintPlayhead(oldX);
+        repaintPlayhead(newX);
+    }
+}
+
+
+
+void WaveFormDisplay::setBeatGrid(const BeatGrid& grid)
+{
+    if (grid.bpm != beatGrid.bpm || grid.firstBeatSeconds != beatGrid.firstBeatSeconds)
+    {
+        beatGrid = grid;
+        invalidateWaveformLayer();
+    }
+}
+
+void WaveFormDisplay::drawBeatGrid(juce::Graphics& g)
+{
+    double length = audionail.getTotalLength();
+    if (!beatGrid.isValid() || length <= 0.0)
+        return;
+
+    // Show every beat while they are at least 4 pixels apart, otherwise every bar, every 4 bars...
+    double pixelsPerBeat = getWidth() * beatGrid.getBeatLengthSeconds() / length;
+    int beatsPerTick = 1;
+    while (beatsPerTick * pixelsPerBeat < 4.0)
+        beatsPerTick *= 4;
+
+    int numBeats = beatGrid.getNumBeats(length);
+    for (int beat = 0; beat < numBeats; beat += beatsPerTick) {
+        float xPos = static_cast<float>(getWidth() * beatGrid.getBeatTime(beat) / length);
+        bool isBarStart = beat % (beatsPerTick * 4) == 0;
+        g.setColour(juce::Colours::white.withAlpha(isBarStart ? 0.5f : 0.2f));
+        g.drawVerticalLine(juce::roundToInt(xPos), 0.0f, static_cast<float>(getHeight()));
+    }
+}
@@ -1,53 +1,93 @@
-/*
-  ==============================================================================
-
-    WaveFormDisplay.h
-    Created: 21 Feb 2025 2:56:36pm
-    Author:  LAPTOP WORLD
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <JuceHeader.h>
-
-//==============================================================================
-/*
-*/
-class WaveFormDisplay  : public juce::Component,
-    public juce::ChangeListener
-{
-public:
-    WaveFormDisplay(juce::AudioFormatManager& formatManagerToUse,
-                    juce::AudioThumbnailCache& cacheToUse);
-    ~WaveFormDisplay() override;
-
-    void paint (juce::Graphics&) override;
-    void resized() override;
-
-    void loadURL(juce::URL& audioURL);
-
-	void changeListenerCallback(juce::ChangeBroadcaster* source) override;
-
-    void addCuePoint(double position);  //  Adds a cue point
-    void clearCuePoints();  //Clears cue points
-    const std::vector<double>& getCuePoints() const { return cuePoints; }  // Public getter
-    int getCurrentCueIndex() const { return currentCueIndex; }
-    void setCurrentCueIndex(int index) { currentCueIndex = index; }
-    double getTrackLength();
-    double getPositionRelative();
-    void setPositionRelative(double pos); 
-
-
-
-
-
-private:
-	juce::AudioThumbnail audionail;
-    bool isloaded;
-    double position = 0.0;
-    std::vector<double> cuePoints;
-    int currentCueIndex = -1;  //  Keeps track of the last jumped cue point
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WaveFormDisplay)
-};
+/*
+  ==============================================================================
+
+    WaveFormDisplay.h
+    Created: 21 Feb 2025 2:56:36pm
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "DeckSnapshot.h"
+#include "BeatGrid.h"
+#include "TrackDecoder.h"
+#include "SpectralWaveform.h"
+
+//==============================================================================
+/*
+*/
+class WaveFormDisplay  : public juce::Component,
+    public juce::ChangeListener
+{
+public:
+    static constexpr int thumbnailResolution = 1000;  // Source samples per thumbnail sample, which the cached thumbnails depend on
+
+    // Builds a thumbnail block by block from a decode pass (runs on the decoding thread). Also used on its
+    // own with a thumbnail that is never drawn, so a pass can write the cache's "thumbnail" section
+    class ThumbnailFiller : public TrackDecodeConsumer {
+    public:
+        explicit ThumbnailFiller(juce::AudioThumbnail& thumbnailToFill) : thumbnail(thumbnailToFill) {}
+        void decodeStarted(int numChannels, double sampleRate, juce::int64 lengthInSamples) override;
+        void decodeBlock(const juce::AudioBuffer<float>& buffer, juce::int64 startSample, int numSamples) override;
+        juce::String getCacheSectionName() const override { return "thumbnail"; }
+        void saveToCache(juce::OutputStream& output) override;
+        bool loadFromCache(juce::InputStream& input) override;
+    private:
+        juce::AudioThumbnail& thumbnail;
+    };
+
+    WaveFormDisplay(juce::AudioFormatManager& formatManagerToUse,
+                    juce::AudioThumbnailCache& cacheToUse);
+    ~WaveFormDisplay() override;
+
+    void paint (juce::Graphics&) override;
+    void resized() override;
+
+    void startNewTrack();  // Clears the waveform before the next track is decoded into it
+    TrackDecodeConsumer* getDecodeConsumer() { return &thumbnailFiller; }  // Fills the waveform from the deck's decode pass
+    TrackDecodeConsumer* getSpectrumConsumer() { return &spectrum; }  // Analyses the waveform's colours in the same pass
+
+	void changeListenerCallback(juce::ChangeBroadcaster* source) override;
+
+    void addCuePoint(double position);  //  Adds a cue point
+    void clearCuePoints();  //Clears cue points
+    const std::vector<double>& getCuePoints() const { return cuePoints; }  // Public getter
+    int getCurrentCueIndex() const { return currentCueIndex; }
+    void setCurrentCueIndex(int index) { currentCueIndex = index; invalidateWaveformLayer(); }
+    double getTrackLength();
+    double getPositionRelative();
+    void setPlayhead(const DeckSnapshot& snapshot);  // Takes the playhead from the deck's published snapshot
+    void setBeatGrid(const BeatGrid& grid);  // Sets the beats drawn over the waveform
+
+
+
+
+
+private:
+	juce::AudioThumbnail audionail;
+
+    // Fills the thumbnail as the deck decodes the track
+    ThumbnailFiller thumbnailFiller{ audionail };
+
+    // Low/mid/high colour of every column, drawn in place of the plain outline once it is ready
+    SpectralWaveform spectrum;
+    bool drawSpectrum(juce::Graphics& g);  // Draws the coloured waveform; false if there is no analysis yet
+
+    DeckSnapshot playhead;
+    BeatGrid beatGrid;
+    void drawBeatGrid(juce::Graphics& g);  // Draws a tick per beat, thinned out when they get too close
+
+    // Everything but the playhead is drawn once into this image and reused until the track, grid, cues or size change
+    juce::Image waveformLayer;
+    bool waveformLayerValid = false;
+    void invalidateWaveformLayer();  // Redraws the cached layer on the next paint
+    void renderWaveformLayer();  // Draws the background, waveform, beat grid and cue points into the cached layer
+    int getPlayheadX(const DeckSnapshot& snapshot) const;  // Column of the playhead, or -1 when nothing is loaded
+    void repaintPlayhead(int x);  // Repaints just the strip around a playhead column
+    std::vector<double> cuePoints;
+    int currentCueIndex = -1;  //  Keeps track of the last jumped cue point
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WaveFormDisplay)
+};
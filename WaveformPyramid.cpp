@@ -0,0 +1,197 @@
+/*
+  ==============================================================================
+
+    WaveformPyramid.cpp
+    Created: 17 Oct 2026 6:31:05pm
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#include "WaveformPyramid.h"
+
+// Walks down from the coarsest level, so wide views read as few bins as possible
+const WaveformPyramid::Level& WaveformPyramid::Levels::chooseLevel(double samplesPerPixel) const {
+    for (auto level = levels.rbegin(); level != levels.rend(); ++level)
+        if (level->samplesPerBin <= samplesPerPixel)
+            return *level;
+
+    return levels.front();
+}
+
+// Returns the latest complete pyramid
+std::shared_ptr<const WaveformPyramid::Levels> WaveformPyramid::getLevels() const {
+    const juce::ScopedLock sl(publishLock);
+    return published;
+}
+
+// Drops the current pyramid
+void WaveformPyramid::clear() {
+    publish(nullptr);
+}
+
+// Starts a new level 0 sized for the whole track, so the pass never reallocates it
+void WaveformPyramid::decodeStarted(int numChannels, double sampleRate, juce::int64 lengthInSamples) {
+    juce::ignoreUnused(numChannels);
+
+    building = std::make_unique<Levels>();
+    building->sampleRate = sampleRate;
+    building->lengthInSamples = lengthInSamples;
+
+    Level base;
+    base.samplesPerBin = baseSamplesPerBin;
+    base.minimum.reserve((size_t)(lengthInSamples / baseSamplesPerBin + 1));
+    base.maximum.reserve((size_t)(lengthInSamples / baseSamplesPerBin + 1));
+    building->levels.push_back(std::move(base));
+
+    samplesInBin = 0;
+}
+
+// Folds the block into level 0, a bin at a time across all channels
+void WaveformPyramid::decodeBlock(const juce::AudioBuffer<float>& buffer, juce::int64 startSample, int numSamples) {
+    juce::ignoreUnused(startSample);
+
+    if (building == nullptr)
+        return;
+
+    auto& base = building->levels.front();
+    int i = 0;
+
+    while (i < numSamples) {
+        const int count = juce::jmin(baseSamplesPerBin - samplesInBin, numSamples - i);
+
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel) {
+            const auto range = juce::FloatVectorOperations::findMinAndMax(buffer.getReadPointer(channel, i), count);
+
+            if (samplesInBin == 0 && channel == 0) {
+                binMinimum = range.getStart();
+                binMaximum = range.getEnd();
+            }
+            else {
+                binMinimum = juce::jmin(binMinimum, range.getStart());
+                binMaximum = juce::jmax(binMaximum, range.getEnd());
+            }
+        }
+
+        i += count;
+        samplesInBin += count;
+
+        if (samplesInBin == baseSamplesPerBin) {
+            base.minimum.push_back(binMinimum);
+            base.maximum.push_back(binMaximum);
+            samplesInBin = 0;
+        }
+    }
+}
+
+// Closes the last partial bin, builds the coarser levels and publishes the result
+void WaveformPyramid::decodeFinished(bool completed) {
+    if (building == nullptr)
+        return;
+
+    if (completed) {
+        auto& base = building->levels.front();
+
+        if (samplesInBin > 0) {
+            base.minimum.push_back(binMinimum);
+            base.maximum.push_back(binMaximum);
+            samplesInBin = 0;
+        }
+
+        buildUpperLevels(*building);
+        publish(std::shared_ptr<const Levels>(building.release()));
+    }
+
+    building.reset();
+}
+
+// Names the pyramid's section in the track cache
+juce::String WaveformPyramid::getCacheSectionName() const {
+    return "pyramid";
+}
+
+// Writes level 0 quantised to 8 bits, rounding outwards so no peak is lost
+void WaveformPyramid::saveToCache(juce::OutputStream& output) {
+    const auto levels = getLevels();
+    if (levels == nullptr)
+        return;
+
+    const auto& base = levels->levels.front();
+    const int numBins = base.getNumBins();
+
+    output.writeDouble(levels->sampleRate);
+    output.writeInt64(levels->lengthInSamples);
+    output.writeInt(numBins);
+
+    std::vector<juce::int8> quantised((size_t)numBins * 2);
+    for (int bin = 0; bin < numBins; ++bin) {
+        quantised[(size_t)bin] = (juce::int8)juce::jlimit(-127, 127, (int)std::floor(base.minimum[(size_t)bin] * 127.0f));
+        quantised[(size_t)(numBins + bin)] = (juce::int8)juce::jlimit(-127, 127, (int)std::ceil(base.maximum[(size_t)bin] * 127.0f));
+    }
+
+    output.write(quantised.data(), quantised.size());
+}
+
+// Reads level 0 back and rebuilds the levels above it
+bool WaveformPyramid::loadFromCache(juce::InputStream& input) {
+    auto levels = std::make_unique<Levels>();
+    levels->sampleRate = input.readDouble();
+    levels->lengthInSamples = input.readInt64();
+    const int numBins = input.readInt();
+
+    if (levels->sampleRate <= 0.0 || numBins < 0 || input.getNumBytesRemaining() < (juce::int64)numBins * 2)
+        return false;
+
+    std::vector<juce::int8> quantised((size_t)numBins * 2);
+    input.read(quantised.data(), (int)quantised.size());
+
+    Level base;
+    base.samplesPerBin = baseSamplesPerBin;
+    base.minimum.resize((size_t)numBins);
+    base.maximum.resize((size_t)numBins);
+
+    for (int bin = 0; bin < numBins; ++bin) {
+        base.minimum[(size_t)bin] = quantised[(size_t)bin] / 127.0f;
+        base.maximum[(size_t)bin] = quantised[(size_t)(numBins + bin)] / 127.0f;
+    }
+
+    levels->levels.push_back(std::move(base));
+    buildUpperLevels(*levels);
+    publish(std::shared_ptr<const Levels>(levels.release()));
+    return true;
+}
+
+// Each level merges neighbouring pairs of the one below, until a single bin covers the track
+void WaveformPyramid::buildUpperLevels(Levels& pyramid) {
+    while (pyramid.levels.back().getNumBins() > 1) {
+        const size_t below = pyramid.levels.size() - 1;
+
+        Level level;
+        level.samplesPerBin = pyramid.levels[below].samplesPerBin * 2;
+
+        const int numBelow = pyramid.levels[below].getNumBins();
+        const int numBins = (numBelow + 1) / 2;
+        level.minimum.resize((size_t)numBins);
+        level.maximum.resize((size_t)numBins);
+
+        const auto& source = pyramid.levels[below];
+        for (int bin = 0; bin < numBins; ++bin) {
+            const size_t first = (size_t)(bin * 2);
+            const size_t second = (size_t)juce::jmin(bin * 2 + 1, numBelow - 1);
+            level.minimum[(size_t)bin] = juce::jmin(source.minimum[first], source.minimum[second]);
+            level.maximum[(size_t)bin] = juce::jmax(source.maximum[first], source.maximum[second]);
+        }
+
+        pyramid.levels.push_back(std::move(level));
+    }
+}
+
+// Swaps the pointer under the lock; listeners hear about it on the message thread
+void WaveformPyramid::publish(std::shared_ptr<const Levels> newLevels) {
+    {
+        const juce::ScopedLock sl(publishLock);
+        published = std::move(newLevels);
+    }
+
+    sendChangeMessage();
+}
@@ -0,0 +1,88 @@
+/*
+  ==============================================================================
+
+    WaveformPyramid.h
+    Created: 17 Oct 2026 6:31:05pm
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "TrackDecoder.h"
+
+// Min/max level-of-detail pyramid of a track's waveform, built once during the deck's decode pass.
+//
+// Level 0 holds the minimum and maximum of every baseSamplesPerBin samples (all channels
+// combined); each level above halves the resolution of the one below. Every level keeps its
+// minimums and maximums in two contiguous arrays, so drawing a view only reads the bins that
+// fall inside it at the level closest to its zoom, whatever the track length.
+//
+// The finished pyramid is published as an immutable snapshot that any thread can hold on to;
+// a change message goes out whenever a new one (or none) is published.
+class WaveformPyramid : public TrackDecodeConsumer,
+                        public juce::ChangeBroadcaster {
+public:
+
+    // One level of the pyramid
+    struct Level {
+        int samplesPerBin = 0;
+        std::vector<float> minimum;
+        std::vector<float> maximum;
+
+        // Returns the number of bins in the level
+        int getNumBins() const { return (int)minimum.size(); }
+    };
+
+    // A complete pyramid
+    struct Levels {
+        double sampleRate = 0.0;
+        juce::int64 lengthInSamples = 0;
+        std::vector<Level> levels;
+
+        // Returns the coarsest level whose bins are no wider than samplesPerPixel
+        const Level& chooseLevel(double samplesPerPixel) const;
+    };
+
+    // Samples per bin of level 0
+    static constexpr int baseSamplesPerBin = 128;
+
+    // Constructor
+    WaveformPyramid() = default;
+
+    // Returns the latest complete pyramid, or nullptr if there is none (any thread)
+    std::shared_ptr<const Levels> getLevels() const;
+
+    // Drops the current pyramid, e.g. before another track is loaded (any thread)
+    void clear();
+
+    // TrackDecodeConsumer: level 0 is built block by block, the rest when the pass completes
+    void decodeStarted(int numChannels, double sampleRate, juce::int64 lengthInSamples) override;
+    void decodeBlock(const juce::AudioBuffer<float>& buffer, juce::int64 startSample, int numSamples) override;
+    void decodeFinished(bool completed) override;
+
+    // TrackDecodeConsumer: level 0 is cached at 8 bits per value, the rest rebuilt on load
+    juce::String getCacheSectionName() const override;
+    void saveToCache(juce::OutputStream& output) override;
+    bool loadFromCache(juce::InputStream& input) override;
+
+private:
+    // Builds every level above level 0 by merging pairs of bins
+    static void buildUpperLevels(Levels& pyramid);
+
+    // Swaps in a new pyramid and tells listeners
+    void publish(std::shared_ptr<const Levels> newLevels);
+
+    // Pyramid under construction (decoding thread only)
+    std::unique_ptr<Levels> building;
+    float binMinimum = 0.0f;
+    float binMaximum = 0.0f;
+    int samplesInBin = 0;
+
+    // Latest complete pyramid; the lock only covers swapping the pointer
+    juce::CriticalSection publishLock;
+    std::shared_ptr<const Levels> published;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WaveformPyramid)
+};
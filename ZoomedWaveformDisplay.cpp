@@ -0,0 +1,137 @@
+/*
+  ==============================================================================
+
+    ZoomedWaveformDisplay.cpp
+    Created: 17 Oct 2026 6:58:47pm
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "ZoomedWaveformDisplay.h"
+
+//==============================================================================
+ZoomedWaveformDisplay::ZoomedWaveformDisplay(WaveformPyramid& pyramidToDraw)
+    : pyramid(pyramidToDraw)
+{
+    pyramid.addChangeListener(this);
+}
+
+ZoomedWaveformDisplay::~ZoomedWaveformDisplay()
+{
+    pyramid.removeChangeListener(this);
+}
+
+void ZoomedWaveformDisplay::paint(juce::Graphics& g)
+{
+    g.fillAll(juce::Colours::black);  // Background
+    g.setColour(juce::Colours::grey);
+    g.drawRect(getLocalBounds(), 1);
+
+    // Hold on to this pyramid for the frame even if a new track publishes another meanwhile
+    auto levels = pyramid.getLevels();
+
+    if (levels != nullptr && levels->sampleRate > 0.0 && getWidth() > 0) {
+        double samplesPerPixel = visibleSeconds * levels->sampleRate / getWidth();
+        double startSample = playhead.positionSamples - 0.5 * getWidth() * samplesPerPixel;
+
+        // Loop region behind the waveform, brighter while the loop is wrapping
+        if (playhead.loopStartSamples >= 0 && playhead.loopEndSamples > playhead.loopStartSamples) {
+            float loopX = (float)((playhead.loopStartSamples - startSample) / samplesPerPixel);
+            float loopWidth = (float)((playhead.loopEndSamples - playhead.loopStartSamples) / samplesPerPixel);
+            g.setColour(juce::Colour::fromRGB(57, 255, 20).withAlpha(playhead.looping ? 0.25f : 0.1f));  // Neon Green
+            g.fillRect(loopX, 0.0f, loopWidth, (float)getHeight());
+        }
+
+        drawWaveform(g, *levels, startSample, samplesPerPixel);
+        drawBeats(g, startSample / levels->sampleRate, samplesPerPixel / levels->sampleRate);
+    }
+
+    // Playhead stays fixed in the centre while the waveform scrolls past it
+    g.setColour(juce::Colours::red);
+    g.drawVerticalLine(getWidth() / 2, 0.0f, static_cast<float>(getHeight()));
+}
+
+void ZoomedWaveformDisplay::mouseWheelMove(const juce::MouseEvent& event, const juce::MouseWheelDetails& wheel)
+{
+    juce::ignoreUnused(event);
+
+    if (wheel.deltaY != 0.0f)
+        setVisibleSeconds(visibleSeconds * (wheel.deltaY > 0.0f ? 0.8 : 1.25));
+}
+
+void ZoomedWaveformDisplay::changeListenerCallback(juce::ChangeBroadcaster* source)
+{
+    juce::ignoreUnused(source);
+    repaint();
+}
+
+void ZoomedWaveformDisplay::setPlayhead(const DeckSnapshot& snapshot)
+{
+    if (snapshot.positionSamples != playhead.positionSamples || snapshot.looping != playhead.looping
+        || snapshot.loopStartSamples != playhead.loopStartSamples || snapshot.loopEndSamples != playhead.loopEndSamples)
+    {
+        playhead = snapshot;
+        repaint();  // Scroll the waveform
+    }
+}
+
+void ZoomedWaveformDisplay::setBeatGrid(const BeatGrid& grid)
+{
+    if (grid.bpm != beatGrid.bpm || grid.firstBeatSeconds != beatGrid.firstBeatSeconds)
+    {
+        beatGrid = grid;
+        repaint();
+    }
+}
+
+void ZoomedWaveformDisplay::setVisibleSeconds(double seconds)
+{
+    visibleSeconds = juce::jlimit(minVisibleSeconds, maxVisibleSeconds, seconds);
+    repaint();
+}
+
+void ZoomedWaveformDisplay::drawWaveform(juce::Graphics& g, const WaveformPyramid::Levels& levels, double startSample, double samplesPerPixel)
+{
+    const auto& level = levels.chooseLevel(samplesPerPixel);
+    int numBins = level.getNumBins();
+    float centreY = getHeight() * 0.5f;
+    float halfHeight = centreY - 1.0f;
+
+    g.setColour(juce::Colour::fromRGB(0, 153, 255));  // Blue
+
+    // The chosen level has at most two bins per column, plus one for the column's ragged edges
+    for (int x = 0; x < getWidth(); ++x) {
+        double columnStart = startSample + x * samplesPerPixel;
+        int firstBin = juce::jmax(0, static_cast<int>(std::floor(columnStart / level.samplesPerBin)));
+        int endBin = juce::jmin(numBins, static_cast<int>(std::ceil((columnStart + samplesPerPixel) / level.samplesPerBin)));
+
+        if (firstBin >= endBin)
+            continue;  // Before the start or past the end of the track
+
+        float low = level.minimum[static_cast<size_t>(firstBin)];
+        float high = level.maximum[static_cast<size_t>(firstBin)];
+        for (int bin = firstBin + 1; bin < endBin; ++bin) {
+            low = juce::jmin(low, level.minimum[static_cast<size_t>(bin)]);
+            high = juce::jmax(high, level.maximum[static_cast<size_t>(bin)]);
+        }
+
+        g.drawVerticalLine(x, centreY - high * halfHeight, centreY - low * halfHeight + 1.0f);
+    }
+}
+
+void ZoomedWaveformDisplay::drawBeats(juce::Graphics& g, double startSeconds, double secondsPerPixel)
+{
+    if (!beatGrid.isValid())
+        return;
+
+    double endSeconds = startSeconds + getWidth() * secondsPerPixel;
+    int beat = juce::jmax(0, static_cast<int>(std::ceil(beatGrid.getBeatPosition(startSeconds))));
+
+    for (double time = beatGrid.getBeatTime(beat); time < endSeconds; time = beatGrid.getBeatTime(++beat)) {
+        float xPos = static_cast<float>((time - startSeconds) / secondsPerPixel);
+        g.setColour(juce::Colours::white.withAlpha(beat % 4 == 0 ? 0.6f : 0.25f));
+        g.drawVerticalLine(juce::roundToInt(xPos), 0.0f, static_cast<float>(getHeight()));
+    }
+}
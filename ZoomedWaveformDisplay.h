@@ -0,0 +1,66 @@
+/*
+  ==============================================================================
+
+    ZoomedWaveformDisplay.h
+    Created: 17 Oct 2026 6:58:47pm
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "WaveformPyramid.h"
+#include "DeckSnapshot.h"
+#include "BeatGrid.h"
+
+// ZoomedWaveformDisplay class
+// Scrolling close-up of the waveform, centred on the playhead, drawn alongside the overview.
+// Each column reads only the pyramid bins under it, so a frame costs the same for any track length.
+class ZoomedWaveformDisplay : public juce::Component,
+    public juce::ChangeListener
+{
+public:
+    // Constructor: draws from pyramidToDraw, which must outlive the display
+    explicit ZoomedWaveformDisplay(WaveformPyramid& pyramidToDraw);
+
+    // Destructor
+    ~ZoomedWaveformDisplay() override;
+
+    // paint: Draws the visible stretch of the track, its beats, the loop and the playhead
+    void paint(juce::Graphics&) override;
+
+    // Zooms in and out with the mouse wheel
+    void mouseWheelMove(const juce::MouseEvent& event, const juce::MouseWheelDetails& wheel) override;
+
+    // Repaints when a new pyramid is published
+    void changeListenerCallback(juce::ChangeBroadcaster* source) override;
+
+    // Takes the playhead from the deck's published snapshot
+    void setPlayhead(const DeckSnapshot& snapshot);
+
+    // Sets the beats drawn over the waveform
+    void setBeatGrid(const BeatGrid& grid);
+
+    // Sets how many seconds of audio the view spans
+    void setVisibleSeconds(double seconds);
+
+    // Zoom range in seconds across the view
+    static constexpr double minVisibleSeconds = 1.0;
+    static constexpr double maxVisibleSeconds = 64.0;
+
+private:
+    // drawWaveform: Draws one min/max line per pixel column from the closest pyramid level
+    void drawWaveform(juce::Graphics& g, const WaveformPyramid::Levels& levels, double startSample, double samplesPerPixel);
+
+    // drawBeats: Draws a tick for every beat in view, brighter every fourth beat
+    void drawBeats(juce::Graphics& g, double startSeconds, double secondsPerPixel);
+
+    WaveformPyramid& pyramid;
+    DeckSnapshot playhead;
+    BeatGrid beatGrid;
+    double visibleSeconds = 8.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ZoomedWaveformDisplay)
+};
@@ -1,105 +1,848 @@
-/*
-  ==============================================================================
-
-    djAudioPlayer.cpp
-    Created: 14 Feb 2025 3:09:14pm
-    Author:  LAPTOP WORLD
-
-  ==============================================================================
-*/
-
-#include "djAudioPlayer.h"
-
-// Constructor for DJAudioPlayer
-DJAudioPlayer::DJAudioPlayer() {
-
-}
-
-// Destructor for DJAudioPlayer
-DJAudioPlayer::~DJAudioPlayer() {
-
-}
-
-// Prepares the audio player to play by registering formats and preparing sources
-void DJAudioPlayer::prepareToPlay(int samplesPerBlockExpected, double sampleRate) {
-    formatManager.registerBasicFormats();
-    transportSource.prepareToPlay(samplesPerBlockExpected, sampleRate);
-    resamplingSource.prepareToPlay(samplesPerBlockExpected, sampleRate);
-}
-
-// Gets the next block of audio to play
-void DJAudioPlayer::getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill) {
-    resamplingSource.getNextAudioBlock(bufferToFill);
-}
-
-// Releases resources used by the audio player
-void DJAudioPlayer::releaseResources() {
-    transportSource.releaseResources();
-    resamplingSource.releaseResources();
-}
-
-// Loads an audio file from a given URL
-void DJAudioPlayer::LoadURL(juce::URL audioURL) {
-    auto* reader = formatManager.createReaderFor(audioURL.createInputStream(false));
-    if (reader != nullptr) {
-        std::unique_ptr<juce::AudioFormatReaderSource> newSource(new juce::AudioFormatReaderSource(reader, true));
-        transportSource.setSource(newSource.get(), 0, nullptr, reader->sampleRate);
-        readerSource.reset(newSource.release());
-    }
-}
-
-// Sets the gain (volume) level for the audio player
-void DJAudioPlayer::setGain(double gain) {
-    if (gain < 0 || gain > 1) {
-        juce::Logger::outputDebugString("DJAudioPlayer::setGain should be between 0 and 1\n");
-    }
-    else {
-        transportSource.setGain(gain);
-    }
-}
-
-// Sets the playback speed of the audio
-void DJAudioPlayer::setspeed(double ratio) {
-    if (ratio <= 0 || ratio > 100) {
-        juce::Logger::outputDebugString("DJAudioPlayer::setSpeed should be between 0 and 100\n");
-    }
-    else {
-        resamplingSource.setResamplingRatio(ratio);
-    }
-}
-
-// Sets the playback position in seconds
-void DJAudioPlayer::setPosition(double posInSecs) {
-    transportSource.setPosition(posInSecs);
-}
-
-// Sets the playback position relative to the track length (0 to 1)
-void DJAudioPlayer::setPositionRelative(double pos) {
-    if (pos < 0 || pos > 1) {
-        juce::Logger::outputDebugString("DJAudioPlayer::setPositionRelative should be between 0 and 1\n");
-    }
-    else {
-        double posInSecs = transportSource.getLengthInSeconds() * pos;
-        setPosition(posInSecs);
-    }
-}
-
-// Starts playback
-void DJAudioPlayer::start() {
-    transportSource.start();
-}
-
-// Stops playback
-void DJAudioPlayer::stop() {
-    transportSource.stop();
-}
-
-// Returns the current playback position in seconds
-double DJAudioPlayer::getPosition() {
-    return transportSource.getCurrentPosition();
-}
-
-// Returns the length of the track in seconds
-double DJAudioPlayer::getLengthInSeconds() {
-    return transportSource.getLengthInSeconds();
-}
+/*
+  ==============================================================================
+
+    djAudioPlayer.cpp
+    Created: 14 Feb 2025 3:09:14pm
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#include "djAudioPlayer.h"
+
+// Constructor for DJAudioPlayer
+DJAudioPlayer::DJAudioPlayer(TrackCache* cache)
+    : trackCache(cache) {
+    // Formats are registered once up front so the loader thread only ever reads the manager
+    formatManager.registerBasicFormats();
+    readAheadThread.startThread();
+
+    // The transport reads the track source for the deck's whole life; tracks come and go beneath it
+    transportSource.setSource(&trackSource);
+}
+
+// Destructor for DJAudioPlayer
+DJAudioPlayer::~DJAudioPlayer() {
+    // Wait for any pending load before tearing down the transport it writes to
+    analysisPool.removeAllJobs(true, 4000);
+    loaderPool.removeAllJobs(true, 4000);
+    stopTimer();
+    transportSource.setSource(nullptr);
+
+    // The tracks' read-ahead buffers belong to the read-ahead thread, so they go first
+    trackSource.setTrack(nullptr);
+    trackSource.setNextTrack(nullptr);
+    trackSource.takeFinishedTrack();
+    readAheadThread.stopThread(2000);
+}
+
+// Prepares the audio player to play by preparing sources
+void DJAudioPlayer::prepareToPlay(int samplesPerBlockExpected, double sampleRate) {
+    deviceSampleRate = sampleRate;
+    transportSource.prepareToPlay(samplesPerBlockExpected, sampleRate);
+    stretchSource.prepareToPlay(samplesPerBlockExpected, sampleRate);
+    resampler.prepareToPlay(samplesPerBlockExpected, sampleRate);
+    eq.prepare(sampleRate);
+    updateRatios();
+}
+
+// Gets the next block of audio to play
+void DJAudioPlayer::getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill) {
+    // Apply everything the UI queued since the last block, so the whole block sees the same parameters
+    commandQueue.drain([this](const DeckCommand& command) { applyCommand(command); });
+
+    // Then what the controller sent, timing each command from the moment its MIDI message arrived
+    controllerQueue.drain([this](const DeckCommand& command) {
+        applyCommand(command);
+
+        const auto latencyMicros = (float)(juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - command.sentTicks) * 1.0e6);
+        controllerLatencyMicros = juce::jmax(controllerLatencyMicros, latencyMicros);
+    });
+
+    // Pick up a newly loaded track, or the queued one if the last block ran into it. A queued track at
+    // another rate starts here rather than mid-block, so the resampler switches ratio on a block boundary
+    trackSource.startNextTrackIfPlayedOut();
+    followPlayingTrack();
+
+    const int generationBefore = trackGeneration;
+    const float autoTrimBefore = autoTrimGain;
+    resampler.getNextAudioBlock(bufferToFill);
+    followPlayingTrack();
+
+    auto* buffer = bufferToFill.buffer;
+    eq.process(buffer->getWritePointer(0, bufferToFill.startSample),
+        buffer->getNumChannels() > 1 ? buffer->getWritePointer(1, bufferToFill.startSample) : nullptr,
+        bufferToFill.numSamples);
+
+    // The auto-trim rides on the volume's ramp, so a change of either never clicks
+    const float targetGain = currentGain * (autoTrimEnabled ? autoTrimGain : 1.0f);
+    const int seam = autoTrimEnabled && trackGeneration != generationBefore ? findSeamInBlock(bufferToFill.numSamples) : 0;
+
+    // Except where the queued track took over inside this block: there the trim steps with the audio
+    if (seam > 0) {
+        buffer->applyGainRamp(bufferToFill.startSample, seam, appliedGain, currentGain * autoTrimBefore);
+        buffer->applyGain(bufferToFill.startSample + seam, bufferToFill.numSamples - seam, targetGain);
+    }
+    else {
+        buffer->applyGainRamp(bufferToFill.startSample, bufferToFill.numSamples, appliedGain, targetGain);
+    }
+    appliedGain = targetGain;
+
+    publishSnapshot(bufferToFill);
+}
+
+// Releases resources used by the audio player
+void DJAudioPlayer::releaseResources() {
+    transportSource.releaseResources();
+    stretchSource.releaseResources();
+    resampler.releaseResources();
+}
+
+// Loads an audio file from a given URL without blocking the calling thread
+void DJAudioPlayer::LoadURL(juce::URL audioURL, std::vector<TrackDecodeConsumer*> extraConsumers) {
+    const int generation = ++loadGeneration;
+    deckGeneration = generation;
+    deckConsumers = extraConsumers;
+    loading = true;
+
+    juce::WeakReference<DJAudioPlayer> weakThis(this);
+
+    loaderPool.addJob([this, weakThis, audioURL, generation]
+        {
+            const bool loaded = openOnLoaderThread(audioURL, generation);
+
+            juce::MessageManager::callAsync([weakThis, loaded, generation]
+                {
+                    auto* player = weakThis.get();
+
+                    // Ignore results from loads that a newer LoadURL call has superseded
+                    if (player == nullptr || generation != player->deckGeneration.load())
+                        return;
+
+                    player->loading = false;
+
+                    if (player->onLoadComplete)
+                        player->onLoadComplete(loaded);
+                });
+        });
+
+    // The previous track's grid no longer applies; the new one arrives when its analysis completes
+    beatGrid = {};
+    loudness = {};
+    startDecodePass(audioURL, generation, extraConsumers);
+}
+
+// Loads and analyses a track synchronously, superseding any load still in flight. The trim goes
+// through the command queue like LoadURL's, so the deck picks it up along with the track
+bool DJAudioPlayer::loadURLNow(juce::URL audioURL) {
+    const int generation = ++loadGeneration;
+    deckGeneration = generation;
+    beatGrid = {};
+    loudness = {};
+
+    if (!openOnLoaderThread(audioURL, generation))
+        return false;
+
+    const DecodeResult result = runDecodePass(audioURL, [] { return false; }, {});
+    beatGrid = result.beatGrid;
+    loudness = result.loudness;
+    sendAutoTrim(generation, loudness);
+    return true;
+}
+
+// The read-ahead buffer is built and filled on this thread, so the audio thread only ever sees a
+// fully primed track. The track keeps the file's rate; the deck's own resampler does the only conversion.
+std::unique_ptr<GaplessTrackSource::Track> DJAudioPlayer::openTrack(const juce::URL& audioURL, int generation) {
+    auto reader = createReaderFor(audioURL);
+
+    if (reader == nullptr) {
+        juce::Logger::outputDebugString("DJAudioPlayer: could not open " + audioURL.toString(false) + "\n");
+        return nullptr;
+    }
+
+    auto track = std::make_unique<GaplessTrackSource::Track>();
+    track->url = audioURL;
+    track->generation = generation;
+    track->sampleRate = reader->sampleRate;
+    track->readerSource = std::make_unique<juce::AudioFormatReaderSource>(reader.release(), true);
+
+    const int bufferSize = readAheadSize.load();
+    if (bufferSize > 0)
+        track->readAhead = std::make_unique<juce::BufferingAudioSource>(track->readerSource.get(), readAheadThread, false, bufferSize, 2);
+
+    trackSource.prepareTrack(*track);
+    return track;
+}
+
+// Opens the track and swaps it in under the track source's lock
+bool DJAudioPlayer::openOnLoaderThread(const juce::URL& audioURL, int generation) {
+    auto track = openTrack(audioURL, generation);
+
+    if (track == nullptr)
+        return false;
+
+    // A newer load has been queued, so don't replace the track the user is about to get
+    if (generation != deckGeneration.load())
+        return false;
+
+    // The track it replaces is freed here, off the audio thread
+    trackSource.setTrack(std::move(track));
+
+    // Decode the audio at the deck's cue points again, this time from the new track
+    cuePrerollCache.setTrack(audioURL, generation);
+    return true;
+}
+
+// Only the results for the deck's current track are kept; a pass overtaken by another load is dropped
+void DJAudioPlayer::startDecodePass(const juce::URL& audioURL, int generation, std::vector<TrackDecodeConsumer*> extraConsumers) {
+    juce::WeakReference<DJAudioPlayer> weakThis(this);
+
+    analysisPool.addJob([this, weakThis, audioURL, generation, extraConsumers]
+        {
+            const DecodeResult result = runDecodePass(audioURL, [this, generation] { return generation != deckGeneration.load(); }, extraConsumers);
+
+            juce::MessageManager::callAsync([weakThis, result, generation]
+                {
+                    auto* player = weakThis.get();
+
+                    if (player != nullptr && generation == player->deckGeneration.load()) {
+                        player->beatGrid = result.beatGrid;
+                        player->loudness = result.loudness;
+                        player->sendAutoTrim(generation, result.loudness);
+                    }
+                });
+        });
+}
+
+// Adds a track to the end of the queue, preparing it at once if it is the next to play
+void DJAudioPlayer::appendToQueue(juce::URL audioURL) {
+    playQueue.add(audioURL);
+
+    if (playQueue.size() == 1)
+        prepareNextTrack();
+
+    startTimerHz(10);
+}
+
+// Empties the queue
+void DJAudioPlayer::clearQueue() {
+    playQueue.clear();
+    prepareNextTrack();
+}
+
+// Returns the tracks waiting to play
+const juce::Array<juce::URL>& DJAudioPlayer::getQueue() const {
+    return playQueue;
+}
+
+// Starts the next track at the top of the next block
+void DJAudioPlayer::playNext() {
+    queueCommand(DeckCommand::Type::playNext);
+}
+
+// Sets the consumers fed by the queued track's analysis
+void DJAudioPlayer::setQueueConsumers(std::vector<TrackDecodeConsumer*> consumers) {
+    queueConsumers = std::move(consumers);
+}
+
+// The loader has a single thread, so the last track prepared is always the one left waiting.
+// The analysis runs behind any pass of the playing track and saves its results to the track cache.
+void DJAudioPlayer::prepareNextTrack() {
+    const int generation = ++loadGeneration;
+    queueGeneration = generation;
+    queuedBeatGrid = {};
+    queuedLoudness = {};
+
+    const bool hasTrack = !playQueue.isEmpty();
+    const juce::URL audioURL = hasTrack ? playQueue.getFirst() : juce::URL();
+    juce::WeakReference<DJAudioPlayer> weakThis(this);
+
+    loaderPool.addJob([this, weakThis, audioURL, hasTrack, generation]
+        {
+            std::unique_ptr<GaplessTrackSource::Track> track;
+
+            if (hasTrack) {
+                track = openTrack(audioURL, generation);
+
+                // A track that won't open is dropped, and the one after it prepared instead
+                if (track == nullptr) {
+                    juce::MessageManager::callAsync([weakThis, generation]
+                        {
+                            auto* player = weakThis.get();
+
+                            if (player != nullptr && generation == player->queueGeneration.load()) {
+                                player->playQueue.remove(0);
+                                player->prepareNextTrack();
+                            }
+                        });
+                    return;
+                }
+            }
+
+            // Whichever track this replaces is freed here, off the audio thread
+            if (generation == queueGeneration.load())
+                trackSource.setNextTrack(std::move(track));
+        });
+
+    if (!hasTrack)
+        return;
+
+    analysisPool.addJob([this, weakThis, audioURL, generation, consumers = queueConsumers]
+        {
+            const DecodeResult result = runDecodePass(audioURL, [this, generation] { return generation != queueGeneration.load(); }, consumers);
+
+            juce::MessageManager::callAsync([weakThis, result, generation]
+                {
+                    auto* player = weakThis.get();
+
+                    // The audio thread gets the gain now, so the track starts at the right level
+                    if (player != nullptr && generation == player->queueGeneration.load()) {
+                        player->queuedBeatGrid = result.beatGrid;
+                        player->queuedLoudness = result.loudness;
+                        player->sendAutoTrim(generation, result.loudness);
+                    }
+                });
+        });
+}
+
+// The audio thread parks the track that played out; finding it here means the queued one has taken over
+void DJAudioPlayer::timerCallback() {
+    if (trackSource.takeFinishedTrack() == nullptr) {
+        if (playQueue.isEmpty() && !trackSource.hasNextTrack())
+            stopTimer();
+        return;
+    }
+
+    const auto playing = trackSource.getPlayingTrack();
+    const juce::URL audioURL = playQueue.isEmpty() ? juce::URL() : playQueue.getFirst();
+
+    if (playing.generation == queueGeneration.load() && !playQueue.isEmpty()) {
+        playQueue.remove(0);
+
+        // A load the user started meanwhile is about to replace this track anyway
+        if (!loading.load()) {
+            deckGeneration = playing.generation;
+            beatGrid = queuedBeatGrid;
+            loudness = queuedLoudness;
+            cuePrerollCache.setTrack(audioURL, playing.generation);
+
+            if (onQueueAdvance)
+                onQueueAdvance(audioURL);
+
+            // With the queued pass cached this only restores the deck's waveforms, without decoding
+            startDecodePass(audioURL, playing.generation, deckConsumers);
+        }
+    }
+
+    prepareNextTrack();
+}
+
+// The index only exists once a decode pass has finished, so a track's first load reads it the ordinary way
+std::unique_ptr<juce::AudioFormatReader> DJAudioPlayer::createReaderFor(const juce::URL& audioURL) {
+    if (trackCache != nullptr && audioURL.isLocalFile()) {
+        const auto file = audioURL.getLocalFile();
+        const auto cacheKey = TrackCache::makeKey(file);
+        SeekIndex index;
+
+        // The section stream reads from the entry's mapping, so the index is read while the entry is open
+        if (cacheKey.isNotEmpty())
+            if (auto entry = trackCache->open(cacheKey))
+                if (auto indexStream = entry->createSectionStream(SeekIndexBuilder::sectionName))
+                    if (!index.readFrom(*indexStream))
+                        index = {};
+
+        auto* format = formatManager.findFormatForFileExtension(file.getFileExtension());
+
+        if (!index.isEmpty() && format != nullptr)
+            if (std::unique_ptr<juce::AudioFormatReader> wholeFileReader{ formatManager.createReaderFor(file) })
+                return std::make_unique<SeekIndexedReader>(*format, file, std::move(index), std::move(wholeFileReader));
+    }
+
+    return std::unique_ptr<juce::AudioFormatReader>(formatManager.createReaderFor(audioURL.createInputStream(false)));
+}
+
+// Decodes the track once with a reader of its own, so the transport's reader is never shared.
+// The waveform and the analysers all take their data from this single pass, or from the cache
+// entry a previous pass left for the same file.
+DJAudioPlayer::DecodeResult DJAudioPlayer::runDecodePass(const juce::URL& audioURL, const std::function<bool()>& isSuperseded, const std::vector<TrackDecodeConsumer*>& extraConsumers) {
+    BeatAnalyser beatAnalyser;
+    LoudnessAnalyser loudnessAnalyser;
+
+    TrackDecoder decoder;
+    for (auto* consumer : extraConsumers)
+        decoder.addConsumer(consumer);
+    decoder.addConsumer(&beatAnalyser);
+    decoder.addConsumer(&loudnessAnalyser);
+
+    // The seek index needs the file itself, so only local tracks get one
+    std::unique_ptr<SeekIndexBuilder> seekIndexBuilder;
+    if (audioURL.isLocalFile()) {
+        seekIndexBuilder = std::make_unique<SeekIndexBuilder>(audioURL.getLocalFile(), formatManager);
+        decoder.addConsumer(seekIndexBuilder.get());
+    }
+
+    // A track seen before is restored without opening a reader at all
+    juce::String cacheKey;
+    if (trackCache != nullptr && audioURL.isLocalFile()) {
+        cacheKey = TrackCache::makeKey(audioURL.getLocalFile());
+
+        if (cacheKey.isNotEmpty())
+            if (auto entry = trackCache->open(cacheKey))
+                if (decoder.restoreFromCache(*entry))
+                    return { beatAnalyser.getResult(), loudnessAnalyser.getResult() };
+    }
+
+    std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(audioURL.createInputStream(false)));
+
+    if (reader == nullptr) {
+        juce::Logger::outputDebugString("DJAudioPlayer: decode pass could not open " + audioURL.toString(false) + "\n");
+        return {};
+    }
+
+    // Give up as soon as a newer track is loaded or the pass is stopped
+    auto* job = juce::ThreadPoolJob::getCurrentThreadPoolJob();
+    const bool completed = decoder.run(*reader, [job, &isSuperseded]
+        {
+            return (job != nullptr && job->shouldExit()) || isSuperseded();
+        });
+
+    if (!completed)
+        return {};
+
+    if (cacheKey.isNotEmpty())
+        decoder.saveToCache(*trackCache, cacheKey);
+
+    return { beatAnalyser.getResult(), loudnessAnalyser.getResult() };
+}
+
+// Cancels the decode pass and waits, so whatever it was feeding can safely be destroyed
+void DJAudioPlayer::stopDecodePass() {
+    analysisPool.removeAllJobs(true, 4000);
+}
+
+// Returns true while a track is being opened on the loader thread
+bool DJAudioPlayer::isLoading() const {
+    return loading.load();
+}
+
+// Sets the read-ahead buffer size in samples used for the next load
+void DJAudioPlayer::setReadAheadSize(int numSamples) {
+    if (numSamples < 0) {
+        juce::Logger::outputDebugString("DJAudioPlayer::setReadAheadSize should not be negative\n");
+    }
+    else {
+        readAheadSize = numSamples;
+    }
+}
+
+// Sets the gain (volume) level for the audio player
+void DJAudioPlayer::setGain(double gain) {
+    if (gain < 0 || gain > 1) {
+        juce::Logger::outputDebugString("DJAudioPlayer::setGain should be between 0 and 1\n");
+    }
+    else {
+        queueCommand(DeckCommand::Type::setGain, gain);
+    }
+}
+
+// Turns the loudness auto-trim on or off
+void DJAudioPlayer::setAutoTrim(bool shouldNormalise) {
+    queueCommand(DeckCommand::Type::setAutoTrimEnabled, shouldNormalise ? 1.0 : 0.0);
+}
+
+// Sets the playback speed of the audio
+void DJAudioPlayer::setspeed(double ratio) {
+    if (ratio <= 0 || ratio > 100) {
+        juce::Logger::outputDebugString("DJAudioPlayer::setSpeed should be between 0 and 100\n");
+    }
+    else {
+        queueCommand(DeckCommand::Type::setSpeed, ratio);
+    }
+}
+
+// Turns keylock on or off
+void DJAudioPlayer::setKeylock(bool shouldPreservePitch) {
+    queueCommand(DeckCommand::Type::setKeylock, shouldPreservePitch ? 1.0 : 0.0);
+}
+
+// Selects the resampler's kernel quality
+void DJAudioPlayer::setResamplerQuality(FusedResamplerAudioSource::Quality quality) {
+    queueCommand(DeckCommand::Type::setResamplerQuality, (double)quality);
+}
+
+// Sets the gain of one EQ band
+void DJAudioPlayer::setEqGain(DeckEQ::Band band, double gain) {
+    if (gain < 0 || gain > DeckEQ::maxGain) {
+        juce::Logger::outputDebugString("DJAudioPlayer::setEqGain should be between 0 and " + juce::String(DeckEQ::maxGain) + "\n");
+    }
+    else {
+        queueCommand(band == DeckEQ::Band::low ? DeckCommand::Type::setEqLow
+            : band == DeckEQ::Band::mid ? DeckCommand::Type::setEqMid
+            : DeckCommand::Type::setEqHigh, gain);
+    }
+}
+
+// Sets the filter knob position
+void DJAudioPlayer::setFilter(double position) {
+    if (position < -1 || position > 1) {
+        juce::Logger::outputDebugString("DJAudioPlayer::setFilter should be between -1 and 1\n");
+    }
+    else {
+        queueCommand(DeckCommand::Type::setFilter, position);
+    }
+}
+
+// Sets the trim gain
+void DJAudioPlayer::setTrim(double gain) {
+    if (gain < 0 || gain > DeckEQ::maxGain) {
+        juce::Logger::outputDebugString("DJAudioPlayer::setTrim should be between 0 and " + juce::String(DeckEQ::maxGain) + "\n");
+    }
+    else {
+        queueCommand(DeckCommand::Type::setTrim, gain);
+    }
+}
+
+// Sets the playback position in seconds
+void DJAudioPlayer::setPosition(double posInSecs) {
+    queueCommand(DeckCommand::Type::setPosition, posInSecs);
+}
+
+// Sets the playback position relative to the track length (0 to 1)
+void DJAudioPlayer::setPositionRelative(double pos) {
+    if (pos < 0 || pos > 1) {
+        juce::Logger::outputDebugString("DJAudioPlayer::setPositionRelative should be between 0 and 1\n");
+    }
+    else {
+        // Resolved against the track length on the audio thread, so it targets whichever track is loaded then
+        queueCommand(DeckCommand::Type::setPositionRelative, pos);
+    }
+}
+
+// Hands the cue points to the pre-roll cache, which decodes their audio in the background
+void DJAudioPlayer::setCuePoints(const std::vector<double>& positionsInSeconds) {
+    cuePrerollCache.setCuePoints(positionsInSeconds);
+}
+
+// Jumps to a cue point
+void DJAudioPlayer::jumpToCue(double posInSecs) {
+    if (posInSecs < 0) {
+        juce::Logger::outputDebugString("DJAudioPlayer::jumpToCue should not be negative\n");
+    }
+    else {
+        queueCommand(DeckCommand::Type::jumpToCue, posInSecs);
+    }
+}
+
+// Marks a loop's in point
+void DJAudioPlayer::setLoopIn() {
+    queueCommand(DeckCommand::Type::setLoopIn);
+}
+
+// Closes the loop
+void DJAudioPlayer::setLoopOut() {
+    queueCommand(DeckCommand::Type::setLoopOut);
+}
+
+// Starts a loop whose length comes from the beat grid
+void DJAudioPlayer::startBeatLoop(double numBeats) {
+    if (numBeats <= 0) {
+        juce::Logger::outputDebugString("DJAudioPlayer::startBeatLoop should be given a positive number of beats\n");
+    }
+    else if (!beatGrid.isValid()) {
+        juce::Logger::outputDebugString("DJAudioPlayer::startBeatLoop needs the track's beat grid, which isn't ready yet\n");
+    }
+    else {
+        queueCommand(DeckCommand::Type::startLoop, numBeats * beatGrid.getBeatLengthSeconds());
+    }
+}
+
+// Halves the current loop
+void DJAudioPlayer::halveLoop() {
+    queueCommand(DeckCommand::Type::halveLoop);
+}
+
+// Doubles the current loop
+void DJAudioPlayer::doubleLoop() {
+    queueCommand(DeckCommand::Type::doubleLoop);
+}
+
+// Leaves the loop
+void DJAudioPlayer::exitLoop() {
+    queueCommand(DeckCommand::Type::exitLoop);
+}
+
+// Starts playback
+void DJAudioPlayer::start() {
+    queueCommand(DeckCommand::Type::start);
+}
+
+// Stops playback
+void DJAudioPlayer::stop() {
+    queueCommand(DeckCommand::Type::stop);
+}
+
+// Queues a command from the MIDI thread; never blocks, so a full queue drops the command
+bool DJAudioPlayer::queueControllerCommand(const DeckCommand& command) {
+    return controllerQueue.push(command);
+}
+
+// Hands the worst latency to the caller and starts a new measurement
+float DJAudioPlayer::takeControllerLatencyMicros() noexcept {
+    const float latency = controllerLatencyMicros;
+    controllerLatencyMicros = -1.0f;
+    return latency;
+}
+
+// Returns the current playback position in seconds
+double DJAudioPlayer::getPosition() {
+    return getSnapshot().getPositionInSeconds();
+}
+
+// Returns the length of the track in seconds
+double DJAudioPlayer::getLengthInSeconds() {
+    return getSnapshot().getLengthInSeconds();
+}
+
+// Returns the deck state published by the most recent audio block
+DeckSnapshot DJAudioPlayer::getSnapshot() const {
+    return snapshotPublisher.read();
+}
+
+// Returns the beat grid of the loaded track
+BeatGrid DJAudioPlayer::getBeatGrid() const {
+    return beatGrid;
+}
+
+// Returns the loudness of the loaded track
+TrackLoudness DJAudioPlayer::getLoudness() const {
+    return loudness;
+}
+
+// Publishes position, parameters and peak levels of the block that was just rendered
+void DJAudioPlayer::publishSnapshot(const juce::AudioSourceChannelInfo& bufferToFill) {
+    DeckSnapshot snapshot;
+
+    // With no rate correction the transport reports positions in samples of the file
+    snapshot.positionSamples = loopSource.getNextReadPosition();
+    snapshot.lengthSamples = transportSource.getTotalLength();
+    snapshot.sampleRate = fileSampleRate;
+    snapshot.speed = currentSpeed;
+    snapshot.gain = currentGain;
+    snapshot.playing = transportSource.isPlaying();
+    snapshot.keylock = keylockEnabled;
+    snapshot.eqLow = currentEqGains[0];
+    snapshot.eqMid = currentEqGains[1];
+    snapshot.eqHigh = currentEqGains[2];
+    snapshot.filter = currentFilter;
+    snapshot.trim = currentTrim;
+    snapshot.autoTrim = autoTrimEnabled ? autoTrimGain : 1.0f;
+    snapshot.loopStartSamples = loopSource.getLoopStart();
+    snapshot.loopEndSamples = loopSource.getLoopEnd();
+    snapshot.looping = loopSource.isLooping();
+
+    auto* buffer = bufferToFill.buffer;
+    if (buffer->getNumChannels() > 0)
+        snapshot.peakLeft = buffer->getMagnitude(0, bufferToFill.startSample, bufferToFill.numSamples);
+    if (buffer->getNumChannels() > 1)
+        snapshot.peakRight = buffer->getMagnitude(1, bufferToFill.startSample, bufferToFill.numSamples);
+    else
+        snapshot.peakRight = snapshot.peakLeft;
+
+    snapshotPublisher.publish(snapshot);
+}
+
+// Queues a command for the audio thread
+void DJAudioPlayer::queueCommand(DeckCommand::Type type, double value) {
+    if (!commandQueue.push(type, value))
+        juce::Logger::outputDebugString("DJAudioPlayer: command queue full, dropping command\n");
+}
+
+// Applies a queued command on the audio thread, before the block is rendered
+void DJAudioPlayer::applyCommand(const DeckCommand& command) {
+    switch (command.type) {
+    case DeckCommand::Type::setGain:
+        currentGain = (float)command.value;
+        break;
+    case DeckCommand::Type::setSpeed:
+        currentSpeed = command.value;
+        updateRatios();
+        break;
+    case DeckCommand::Type::setKeylock:
+        if ((command.value > 0.5) != keylockEnabled) {
+            keylockEnabled = command.value > 0.5;
+
+            // Whichever path takes over starts from the transport's current position
+            stretchSource.reset();
+            resampler.setInputSource(keylockEnabled ? static_cast<juce::AudioSource*>(&stretchSource) : &loopSource);
+            updateRatios();
+        }
+        break;
+    case DeckCommand::Type::setResamplerQuality:
+        resampler.setQuality((FusedResamplerAudioSource::Quality)juce::roundToInt(command.value));
+        break;
+    case DeckCommand::Type::setPosition:
+        seekToSample((juce::int64)(command.value * fileSampleRate));
+        break;
+    case DeckCommand::Type::setPositionRelative:
+        seekToSample((juce::int64)(command.value * (double)transportSource.getTotalLength()));
+        break;
+    case DeckCommand::Type::jumpToCue: {
+        // Falls back to an ordinary seek while the cue point's audio is still being decoded
+        const auto cueSample = (juce::int64)(command.value * fileSampleRate);
+        loopSource.clearLoop();
+        if (cueSource.jumpToCue(trackGeneration, cueSample)) {
+            stretchSource.reset();
+            resampler.flushBuffers();
+        }
+        else {
+            seekToSample(cueSample);
+        }
+        break;
+    }
+    case DeckCommand::Type::setLoopIn:
+        loopSource.setLoopIn();
+        break;
+    case DeckCommand::Type::setLoopOut:
+        loopSource.setLoopOut();
+        break;
+    case DeckCommand::Type::startLoop:
+        loopSource.startLoop((juce::int64)(command.value * fileSampleRate));
+        break;
+    case DeckCommand::Type::halveLoop:
+        loopSource.halveLoop();
+        break;
+    case DeckCommand::Type::doubleLoop:
+        loopSource.doubleLoop();
+        break;
+    case DeckCommand::Type::exitLoop:
+        loopSource.exitLoop();
+        break;
+    case DeckCommand::Type::setEqLow:
+        currentEqGains[0] = (float)command.value;
+        eq.setBandGain(DeckEQ::Band::low, currentEqGains[0]);
+        break;
+    case DeckCommand::Type::setEqMid:
+        currentEqGains[1] = (float)command.value;
+        eq.setBandGain(DeckEQ::Band::mid, currentEqGains[1]);
+        break;
+    case DeckCommand::Type::setEqHigh:
+        currentEqGains[2] = (float)command.value;
+        eq.setBandGain(DeckEQ::Band::high, currentEqGains[2]);
+        break;
+    case DeckCommand::Type::setFilter:
+        currentFilter = (float)command.value;
+        eq.setFilter(currentFilter);
+        break;
+    case DeckCommand::Type::setTrim:
+        currentTrim = (float)command.value;
+        eq.setTrim(currentTrim);
+        break;
+    case DeckCommand::Type::start:
+        transportSource.start();
+        break;
+    case DeckCommand::Type::stop:
+        transportSource.stop();
+        break;
+    case DeckCommand::Type::togglePlayback:
+        if (transportSource.isPlaying())
+            transportSource.stop();
+        else
+            transportSource.start();
+        break;
+    case DeckCommand::Type::playNext:
+        // Does nothing until the next track is primed; the deck follows it at the top of the block
+        trackSource.skipToNextTrack();
+        break;
+    case DeckCommand::Type::setAutoTrim:
+        storeAutoTrim(command.track, (float)command.value);
+        break;
+    case DeckCommand::Type::setAutoTrimEnabled:
+        autoTrimEnabled = command.value > 0.5;
+        break;
+    }
+}
+
+// A track that ran on from the one before keeps the audio already buffered downstream, which is
+// the seam itself; only one swapped in by a load starts the stretcher and resampler afresh
+void DJAudioPlayer::followPlayingTrack() {
+    const auto playing = trackSource.getPlayingTrack();
+
+    if (playing.sampleRate != fileSampleRate) {
+        fileSampleRate = playing.sampleRate;
+        updateRatios();
+    }
+
+    // A jump into the previous track's cue audio, or a loop captured from it, must not outlive it
+    if (playing.generation != trackGeneration) {
+        trackGeneration = playing.generation;
+        cueSource.cancelJump();
+
+        if (!playing.startedGaplessly) {
+            resampler.flushBuffers();
+            stretchSource.reset();
+        }
+
+        // An unmeasured track plays untrimmed until its analysis catches up
+        autoTrimGain = 1.0f;
+        for (const auto& slot : autoTrimSlots)
+            if (slot.first == trackGeneration)
+                autoTrimGain = slot.second;
+
+        if (loopSource.getLoopStart() >= 0)
+            loopSource.setNextReadPosition(transportSource.getNextReadPosition());
+    }
+}
+
+// Output after the seam covers what was read from the new track, less what the resampler holds unplayed
+int DJAudioPlayer::findSeamInBlock(int numSamples) const {
+    // The stretcher's overlap-add smears the seam across its window, so with keylock on the block takes the new trim whole
+    if (keylockEnabled || !trackSource.getPlayingTrack().startedGaplessly)
+        return 0;
+
+    const double playedFromNewTrack = (double)trackSource.getNextReadPosition() - resampler.getBufferedInput();
+    const int afterSeam = juce::jlimit(0, numSamples, juce::roundToInt(playedFromNewTrack / resampler.getResamplingRatio()));
+    return numSamples - afterSeam;
+}
+
+// The gain goes with the track's generation, so one measured for the queue never lands on the playing track
+void DJAudioPlayer::sendAutoTrim(int generation, const TrackLoudness& trackLoudness) {
+    DeckCommand command;
+    command.type = DeckCommand::Type::setAutoTrim;
+    command.value = trackLoudness.getAutoTrimGain(autoTrimTargetLufs, autoTrimCeilingDb, autoTrimMaxBoostDb);
+    command.track = generation;
+
+    if (!commandQueue.push(command))
+        juce::Logger::outputDebugString("DJAudioPlayer: command queue full, dropping command\n");
+}
+
+// Generations only grow, so the oldest slot is always the one to give up
+void DJAudioPlayer::storeAutoTrim(int generation, float gain) {
+    auto* slot = &autoTrimSlots[nextAutoTrimSlot];
+    for (auto& existing : autoTrimSlots)
+        if (existing.first == generation)
+            slot = &existing;
+
+    if (slot == &autoTrimSlots[nextAutoTrimSlot])
+        nextAutoTrimSlot = (nextAutoTrimSlot + 1) % autoTrimSlots.size();
+
+    *slot = { generation, gain };
+
+    if (generation == trackGeneration)
+        autoTrimGain = gain;
+}
+
+// Keylock stretches at the file rate and leaves only the rate conversion to the resampler;
+// otherwise the speed is folded into the resampling ratio
+void DJAudioPlayer::updateRatios() {
+    const double rateRatio = (fileSampleRate > 0.0 && deviceSampleRate > 0.0) ? fileSampleRate / deviceSampleRate : 1.0;
+
+    stretchSource.setStretchRatio(currentSpeed);
+    resampler.setResamplingRatio(keylockEnabled ? rateRatio : rateRatio * currentSpeed);
+}
+
+// Repositions the transport and discards audio buffered from the old position
+void DJAudioPlayer::seekToSample(juce::int64 samplePosition) {
+    loopSource.setNextReadPosition(juce::jmax((juce::int64)0, samplePosition));
+    stretchSource.reset();
+    resampler.flushBuffers();
+}
@@ -1,73 +1,334 @@
-/*
-  ==============================================================================
-
-    djAudioPlayer.h
-    Created: 14 Feb 2025 3:09:14pm
-    Author:  LAPTOP WORLD
-
-  ==============================================================================
-*/
-
-#pragma once
-#include "../JuceLibraryCode/JuceHeader.h"
-
-// DJAudioPlayer class declaration inheriting from juce::AudioSource
-class DJAudioPlayer : public juce::AudioSource {
-public:
-
-    // Constructor
-    DJAudioPlayer();
-
-    // Destructor
-    ~DJAudioPlayer();
-
-    // Prepares the audio player for playback
-    void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
-
-    // Fills the buffer with the next block of audio samples
-    void getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill) override;
-
-    // Releases any resources used by the audio player
-    void releaseResources() override;
-
-    // Loads an audio file from a URL
-    void LoadURL(juce::URL audioURL);
-
-    // Sets the volume level (gain) of the audio
-    void setGain(double gain);
-
-    // Sets the playback speed of the audio
-    void setspeed(double ratio);
-
-    // Sets the playback position in seconds
-    void setPosition(double posInSecs);
-
-    // Sets the playback position relative to the track length (0 to 1)
-    void setPositionRelative(double pos);
-
-    // Starts audio playback
-    void start();
-
-    // Stops audio playback
-    void stop();
-
-    // Returns the current playback position in seconds
-    double getPosition();
-
-    // Returns the total length of the track in seconds
-    double getLengthInSeconds();
-
-private:
-    // Manages different audio formats
-    juce::AudioFormatManager formatManager;
-
-    // Manages reading audio files
-    std::unique_ptr<juce::AudioFormatReaderSource> readerSource;
-
-    // Manages playback transport (play, stop, etc.)
-    juce::AudioTransportSource transportSource;
-
-    // Manages resampling to adjust playback speed
-    juce::ResamplingAudioSource resamplingSource{ &transportSource, false, 2 };
-
-};
+/*
+  ==============================================================================
+
+    djAudioPlayer.h
+    Created: 14 Feb 2025 3:09:14pm
+    Author:  LAPTOP WORLD
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "DeckCommandQueue.h"
+#include "DeckSnapshot.h"
+#include "TimeStretchAudioSource.h"
+#include "FusedResamplerAudioSource.h"
+#include "BeatAnalyser.h"
+#include "LoudnessAnalyser.h"
+#include "DeckEQ.h"
+#include "CuePreroll.h"
+#include "LoopAudioSource.h"
+#include "SeekIndex.h"
+#include "GaplessTrackSource.h"
+
+// DJAudioPlayer class declaration inheriting from juce::AudioSource
+class DJAudioPlayer : public juce::AudioSource,
+                      private juce::Timer {
+public:
+
+    // Constructor: trackCache (optional, may be shared between decks) keeps decode results between runs
+    explicit DJAudioPlayer(TrackCache* trackCache = nullptr);
+
+    // Destructor
+    ~DJAudioPlayer();
+
+    // Prepares the audio player for playback
+    void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
+
+    // Fills the buffer with the next block of audio samples
+    void getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill) override;
+
+    // Releases any resources used by the audio player
+    void releaseResources() override;
+
+    // Loads an audio file from a URL on the background loader thread, then decodes the whole track
+    // once for analysis. Every block of that pass is also handed to extraConsumers (e.g. the waveforms),
+    // which must stay alive until the pass ends or stopDecodePass() returns.
+    void LoadURL(juce::URL audioURL, std::vector<TrackDecodeConsumer*> extraConsumers = {});
+
+    // Opens a track on the calling thread and swaps it in, then runs the decode pass there too (or
+    // restores it from the track cache), so the beat grid and auto-trim are in place before it returns.
+    // For offline rendering, where nothing else is pulling audio from the deck meanwhile.
+    bool loadURLNow(juce::URL audioURL);
+
+    // Cancels the current track's decode pass and waits for it to stop (message thread only)
+    void stopDecodePass();
+
+    // Returns true while a track is being opened on the loader thread
+    bool isLoading() const;
+
+    // Sets the read-ahead buffer size in samples used for the next load (0 reads straight from the file)
+    void setReadAheadSize(int numSamples);
+
+    // Called on the message thread when a load finishes (true if the track was opened)
+    std::function<void(bool)> onLoadComplete;
+
+    // The deck's play queue. The first track waiting is opened, primed and analysed in the background
+    // while the current one plays, then takes over from its last sample without a gap if both share a
+    // sample rate. One at another rate starts on the next block boundary, after the resampler has switched.
+
+    // Adds a track to the end of the queue (message thread only)
+    void appendToQueue(juce::URL audioURL);
+
+    // Empties the queue, including the track waiting to follow (message thread only)
+    void clearQueue();
+
+    // Returns the tracks waiting to play, the next one first (message thread only)
+    const juce::Array<juce::URL>& getQueue() const;
+
+    // Starts the next track from the top of the next block, as a mix transition would, if it is ready
+    void playNext();
+
+    // Extra consumers fed by the queued track's analysis, so that its cache entry holds everything the
+    // deck's own pass restores when the track takes over. They must stay alive like LoadURL's (message thread only)
+    void setQueueConsumers(std::vector<TrackDecodeConsumer*> consumers);
+
+    // Called on the message thread when a track from the queue has taken over, before its decode pass
+    // restarts for LoadURL's consumers
+    std::function<void(const juce::URL&)> onQueueAdvance;
+
+    // The setters below only queue a command; the audio thread applies it at the start of the next block
+
+    // Sets the volume level (gain) of the audio
+    void setGain(double gain);
+
+    // Turns the loudness auto-trim on or off. When on, every track is brought towards
+    // autoTrimTargetLufs by a gain in front of the volume, once its decode pass has measured it
+    void setAutoTrim(bool shouldNormalise);
+
+    // Sets the playback speed of the audio
+    void setspeed(double ratio);
+
+    // Turns keylock on or off (on keeps the pitch when the speed changes)
+    void setKeylock(bool shouldPreservePitch);
+
+    // Selects the resampler's kernel quality
+    void setResamplerQuality(FusedResamplerAudioSource::Quality quality);
+
+    // Sets an EQ band's gain, from 0 (killed) through 1 (unchanged) to DeckEQ::maxGain
+    void setEqGain(DeckEQ::Band band, double gain);
+
+    // Sets the filter from -1 (low-pass closed) through 0 (off) to 1 (high-pass closed)
+    void setFilter(double position);
+
+    // Sets the trim gain applied after the EQ and filter
+    void setTrim(double gain);
+
+    // Sets the playback position in seconds
+    void setPosition(double posInSecs);
+
+    // Sets the playback position relative to the track length (0 to 1)
+    void setPositionRelative(double pos);
+
+    // Sets the cue points whose audio is kept decoded in RAM for instant jumps, in seconds
+    void setCuePoints(const std::vector<double>& positionsInSeconds);
+
+    // Jumps to a cue point, playing from RAM while the reader catches up if its audio is ready
+    void jumpToCue(double posInSecs);
+
+    // Marks a loop's in point at the playhead
+    void setLoopIn();
+
+    // Closes the loop at the playhead and starts looping
+    void setLoopOut();
+
+    // Starts a loop of a number of beats at the playhead; needs the track's beat grid (message thread only)
+    void startBeatLoop(double numBeats);
+
+    // Halves or doubles the current loop
+    void halveLoop();
+    void doubleLoop();
+
+    // Leaves the loop; playback carries on past its end
+    void exitLoop();
+
+    // Starts audio playback
+    void start();
+
+    // Stops audio playback
+    void stop();
+
+    // Queues a command from a MIDI controller on the deck's controller queue, applied at the start of
+    // the next block like the UI's. Returns false if the queue is full (MIDI input thread only)
+    bool queueControllerCommand(const DeckCommand& command);
+
+    // Longest time from a controller sending a command to the start of the block that applied it, over
+    // the blocks since the last call; negative if none was applied (audio thread only, between blocks)
+    float takeControllerLatencyMicros() noexcept;
+
+    // Returns the current playback position in seconds (from the latest snapshot)
+    double getPosition();
+
+    // Returns the total length of the track in seconds (from the latest snapshot)
+    double getLengthInSeconds();
+
+    // Returns the deck state published by the most recent audio block (safe from any thread)
+    DeckSnapshot getSnapshot() const;
+
+    // Returns the beat grid of the loaded track, empty until its analysis finishes (message thread only)
+    BeatGrid getBeatGrid() const;
+
+    // Returns the loudness of the loaded track, unmeasured until its analysis finishes (message thread only)
+    TrackLoudness getLoudness() const;
+
+    // Loudness the auto-trim aims for, the true peak it won't raise a track past, and its largest boost
+    static constexpr double autoTrimTargetLufs = -14.0;
+    static constexpr double autoTrimCeilingDb = -1.0;
+    static constexpr double autoTrimMaxBoostDb = 12.0;
+
+private:
+    // What a decode pass measures of a track
+    struct DecodeResult {
+        BeatGrid beatGrid;
+        TrackLoudness loudness;
+    };
+
+    // Applies a queued command (audio thread only)
+    void applyCommand(const DeckCommand& command);
+
+    // Recomputes the resampler and stretcher ratios from the file rate, device rate, speed and keylock (audio thread only)
+    void updateRatios();
+
+    // Moves the transport to a sample position at the file rate and drops stale buffered audio (audio thread only)
+    void seekToSample(juce::int64 samplePosition);
+
+    // Publishes the state of the block that was just rendered (audio thread only)
+    void publishSnapshot(const juce::AudioSourceChannelInfo& bufferToFill);
+
+    // Queues a command for the audio thread, logging if the ring has overflowed
+    void queueCommand(DeckCommand::Type type, double value = 0.0);
+
+    // Takes on the rate, generation and auto-trim of whichever track is playing now (audio thread only)
+    void followPlayingTrack();
+
+    // Returns where in this block the queued track took over without a gap, or 0 if it can't be placed
+    int findSeamInBlock(int numSamples) const;
+
+    // Sends the audio thread the auto-trim of a track, ahead of it playing if it is the queued one
+    void sendAutoTrim(int generation, const TrackLoudness& trackLoudness);
+
+    // Keeps a track's auto-trim, and applies it at once if the track is playing (audio thread only)
+    void storeAutoTrim(int generation, float gain);
+
+    // Opens a track and primes its read-ahead (runs on the loader thread, or the caller's for loadURLNow)
+    std::unique_ptr<GaplessTrackSource::Track> openTrack(const juce::URL& audioURL, int generation);
+
+    // Opens the track and swaps it in as the playing one (runs on the loader thread, or the caller's for loadURLNow)
+    bool openOnLoaderThread(const juce::URL& audioURL, int generation);
+
+    // Starts the decode pass of the deck's track on the analysis thread, and takes its beat grid and loudness when it finishes
+    void startDecodePass(const juce::URL& audioURL, int generation, std::vector<TrackDecodeConsumer*> extraConsumers);
+
+    // Opens and analyses the first track of the queue to follow the playing one, or clears the way if there is none (message thread only)
+    void prepareNextTrack();
+
+    // Collects a track that has played out and catches up with the one that followed it (message thread only)
+    void timerCallback() override;
+
+    // Opens a reader over a track, one that seeks through the track's cached seek index if it has one
+    std::unique_ptr<juce::AudioFormatReader> createReaderFor(const juce::URL& audioURL);
+
+    // Decodes the whole track once with its own reader, feeding the beat and loudness analysis and
+    // extraConsumers, or restores them all from the track cache, and returns what the analysers found
+    // (runs on the analysis thread). isSuperseded is polled between blocks to give up early.
+    DecodeResult runDecodePass(const juce::URL& audioURL, const std::function<bool()>& isSuperseded, const std::vector<TrackDecodeConsumer*>& extraConsumers);
+
+    // Manages different audio formats
+    juce::AudioFormatManager formatManager;
+
+    // Results of earlier decode passes, owned by the caller
+    TrackCache* trackCache;
+
+    // Plays the loaded track and runs on into the queued one; the transport reads it directly
+    GaplessTrackSource trackSource;
+
+    // Manages playback transport (play, stop, etc.)
+    juce::AudioTransportSource transportSource;
+
+    // Audio after each cue point, decoded ahead of time, and the source that plays a jump from it
+    CuePrerollCache cuePrerollCache{ [this](const juce::URL& url) { return createReaderFor(url); } };
+    CuePrerollSource cueSource{ transportSource, cuePrerollCache };
+
+    // Wraps at the loop points, playing repeats from RAM
+    LoopAudioSource loopSource{ cueSource, transportSource, 2 };
+
+    // Changes speed without changing pitch when keylock is on (runs at the file's sample rate)
+    TimeStretchAudioSource stretchSource{ &loopSource, false, 2 };
+    bool keylockEnabled = false;
+
+    // Converts from the file's rate to the device's and applies the speed in a single pass.
+    // Reads the transport (through the cue pre-roll and loop) directly, or the stretcher when keylock is on.
+    FusedResamplerAudioSource resampler{ &loopSource, false, 2 };
+
+    // Kill EQ, filter and trim, applied in place to the resampler's output
+    DeckEQ eq;
+
+    // Commands from the message thread waiting for the next audio block
+    DeckCommandQueue commandQueue;
+
+    // Commands from the MIDI input thread, which needs a queue of its own as the second producer
+    DeckCommandQueue controllerQueue{ 256 };
+
+    // Latest rendered state, read by the UI
+    DeckSnapshotPublisher snapshotPublisher;
+
+    // Audio thread copies of the applied parameters, used when publishing snapshots
+    double fileSampleRate = 0.0;
+    int trackGeneration = 0;
+    double deviceSampleRate = 0.0;
+    double currentSpeed = 1.0;
+    float currentGain = 1.0f;
+
+    std::array<float, 3> currentEqGains{ 1.0f, 1.0f, 1.0f };
+    float currentFilter = 0.0f;
+    float currentTrim = 1.0f;
+
+    // Auto-trim of the playing track, whether it is applied, and the last few tracks' gains by load
+    // generation, so a queued track's is already waiting when it takes over mid-block
+    float autoTrimGain = 1.0f;
+    bool autoTrimEnabled = true;
+    std::array<std::pair<int, float>, 4> autoTrimSlots{ { { -1, 1.0f }, { -1, 1.0f }, { -1, 1.0f }, { -1, 1.0f } } };
+    size_t nextAutoTrimSlot = 0;
+
+    // Worst controller command latency since takeControllerLatencyMicros was last called, negative if none
+    float controllerLatencyMicros = -1.0f;
+
+    // Gain the last block ended on, auto-trim included; the deck's gain is applied after the EQ, so captured loops stay unscaled
+    float appliedGain = 1.0f;
+
+    // Fills the read-ahead buffer ahead of the audio callback
+    juce::TimeSliceThread readAheadThread{ "DJAudioPlayer Read-Ahead" };
+
+    // Opens readers away from the message and audio threads
+    juce::ThreadPool loaderPool{ 1 };
+
+    // Runs the decode pass, kept apart from the loader so a long analysis never delays the next load
+    juce::ThreadPool analysisPool{ 1 };
+
+    // Beat grid and loudness of the loaded track, set on the message thread when its analysis completes
+    BeatGrid beatGrid;
+    TrackLoudness loudness;
+
+    // Loading state shared between the message and loader threads. Every opened track takes the next
+    // loadGeneration; deckGeneration is the one the deck's load and decode pass are for, and
+    // queueGeneration the one being prepared to follow it.
+    std::atomic<bool> loading{ false };
+    std::atomic<int> loadGeneration{ 0 };
+    std::atomic<int> deckGeneration{ 0 };
+    std::atomic<int> queueGeneration{ 0 };
+    std::atomic<int> readAheadSize{ 32768 };
+
+    // Consumers of the deck's last LoadURL, fed again when a queued track takes over (message thread only)
+    std::vector<TrackDecodeConsumer*> deckConsumers;
+
+    // Tracks waiting to play, the first of them being prepared or ready, and its beat grid and
+    // loudness once analysed (message thread only)
+    juce::Array<juce::URL> playQueue;
+    std::vector<TrackDecodeConsumer*> queueConsumers;
+    BeatGrid queuedBeatGrid;
+    TrackLoudness queuedLoudness;
+
+    JUCE_DECLARE_WEAK_REFERENCEABLE(DJAudioPlayer)
+
+};